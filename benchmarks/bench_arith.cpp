@@ -0,0 +1,204 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include <algorithm>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Random signed integers of type operandT, as many as the benchmark argument
+template<typename operandT>
+std::vector<operandT>
+random_signed(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<operandT> vals(n);
+  std::ranges::generate(vals, [&] { return static_cast<operandT>(gen()); });
+  return vals;
+}
+
+// Replaces every element by its absolute value using subtle::ct_abs
+template<typename operandT>
+void
+ct_abs_span(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto orig = random_signed<operandT>(n);
+  auto vals = orig;
+
+  for (auto _iter : state) {
+    subtle::ct_abs(std::span(vals));
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+
+    std::ranges::copy(orig, vals.begin());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Clamps every element to [-2^( W - 4 ), 2^( W - 4 )] using subtle::ct_clamp
+template<typename operandT>
+void
+ct_clamp_span(benchmark::State& state)
+{
+  constexpr auto bound = static_cast<operandT>(std::numeric_limits<operandT>::max() >> 3);
+
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto orig = random_signed<operandT>(n);
+  auto vals = orig;
+
+  for (auto _iter : state) {
+    subtle::ct_clamp(std::span(vals), static_cast<operandT>(-bound), bound);
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+
+    std::ranges::copy(orig, vals.begin());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Clamps every element one at a time, with the scalar subtle::ct_clamp
+template<typename operandT>
+void
+scalar_clamp_span(benchmark::State& state)
+{
+  constexpr auto bound = static_cast<operandT>(std::numeric_limits<operandT>::max() >> 3);
+
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto orig = random_signed<operandT>(n);
+  auto vals = orig;
+
+  for (auto _iter : state) {
+    for (auto& val : vals) {
+      val = subtle::ct_clamp(val, static_cast<operandT>(-bound), bound);
+    }
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+
+    std::ranges::copy(orig, vals.begin());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Finds the minimum of a span and its index using subtle::ct_min and subtle::ct_argmin
+template<typename operandT>
+void
+ct_argmin_span(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto vals = random_signed<operandT>(n);
+
+  for (auto _iter : state) {
+    const auto min = subtle::ct_min(std::span<const operandT>(vals));
+    const auto argmin = subtle::ct_argmin(std::span<const operandT>(vals));
+
+    benchmark::DoNotOptimize(min);
+    benchmark::DoNotOptimize(argmin);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Finds the minimum of a span by a serial fold of the scalar subtle::ct_min
+template<typename operandT>
+void
+serial_min_span(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto vals = random_signed<operandT>(n);
+
+  for (auto _iter : state) {
+    operandT min = vals[0];
+    for (const auto val : vals) {
+      min = subtle::ct_min(min, val);
+    }
+
+    benchmark::DoNotOptimize(min);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Computes the lane-wise minimum of two spans into a third, with subtle::ct_lt_each
+// followed by subtle::ct_select_each
+template<typename operandT>
+void
+ct_lt_select_each(benchmark::State& state)
+{
+  using maskT = std::make_unsigned_t<operandT>;
+
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = random_signed<operandT>(n);
+  const auto y = random_signed<operandT>(n);
+
+  std::vector<maskT> masks(n);
+  std::vector<operandT> dst(n);
+
+  for (auto _iter : state) {
+    subtle::ct_lt_each(std::span(masks), std::span<const operandT>(x), std::span<const operandT>(y));
+    subtle::ct_select_each(std::span(dst), std::span<const maskT>(masks), std::span<const operandT>(x), std::span<const operandT>(y));
+
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Computes the lane-wise minimum of two spans into a third, one scalar subtle::ct_lt and
+// subtle::ct_select at a time
+template<typename operandT>
+void
+scalar_lt_select(benchmark::State& state)
+{
+  using maskT = std::make_unsigned_t<operandT>;
+
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = random_signed<operandT>(n);
+  const auto y = random_signed<operandT>(n);
+
+  std::vector<operandT> dst(n);
+
+  for (auto _iter : state) {
+    for (size_t i = 0; i < n; i++) {
+      dst[i] = subtle::ct_select(subtle::ct_lt<operandT, maskT>(x[i], y[i]), x[i], y[i]);
+    }
+
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_abs_span<int16_t>)->Name("ct_abs/i16")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_abs_span<int32_t>)->Name("ct_abs/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_abs_span<int64_t>)->Name("ct_abs/i64")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_clamp_span<int16_t>)->Name("ct_clamp/i16")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_clamp_span<int32_t>)->Name("ct_clamp/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_clamp_span<int64_t>)->Name("ct_clamp/i64")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(scalar_clamp_span<int32_t>)->Name("scalar_clamp/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_argmin_span<int16_t>)->Name("ct_argmin/i16")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_argmin_span<int32_t>)->Name("ct_argmin/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_argmin_span<int64_t>)->Name("ct_argmin/i64")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(serial_min_span<int32_t>)->Name("serial_min/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_lt_select_each<int16_t>)->Name("ct_lt_select_each/i16")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_lt_select_each<int32_t>)->Name("ct_lt_select_each/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_lt_select_each<int64_t>)->Name("ct_lt_select_each/i64")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(scalar_lt_select<int32_t>)->Name("scalar_lt_select/i32")->Arg(256)->Arg(4096)->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
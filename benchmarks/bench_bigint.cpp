@@ -0,0 +1,345 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_bigint.hpp"
+#include <bit>
+#include <random>
+#include <span>
+
+namespace {
+
+// Adds two random LIMBS-limb integers using subtle::ct_add_carry, accumulating into the first one
+template<size_t LIMBS>
+void
+ct_add_carry(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint64_t, LIMBS> a{};
+  std::array<uint64_t, LIMBS> b{};
+  std::ranges::generate(a, [&] { return gen(); });
+  std::ranges::generate(b, [&] { return gen(); });
+
+  for (auto _iter : state) {
+    const auto carry = subtle::ct_add_carry<uint64_t, uint64_t, LIMBS>(a, a, b);
+
+    benchmark::DoNotOptimize(carry);
+    benchmark::DoNotOptimize(a.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Reduces hi:x below a random LIMBS-limb modulus m using subtle::ct_cond_sub
+template<size_t LIMBS>
+void
+ct_cond_sub(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint64_t, LIMBS> x{};
+  std::array<uint64_t, LIMBS> m{};
+  std::ranges::generate(x, [&] { return gen(); });
+  std::ranges::generate(m, [&] { return gen(); });
+  uint64_t hi = gen() & 1U;
+
+  for (auto _iter : state) {
+    benchmark::DoNotOptimize(hi);
+    const auto subtracted = subtle::ct_cond_sub<uint64_t, uint64_t, LIMBS>(x, m, hi);
+
+    benchmark::DoNotOptimize(subtracted);
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Reduces hi:x below a random LIMBS-limb modulus m the hand-rolled way -- borrows computed with
+// ct_lt / ct_eq into a temporary, then copied back limb by limb with ct_select -- for reference
+template<size_t LIMBS>
+void
+select_cond_sub(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint64_t, LIMBS> x{};
+  std::array<uint64_t, LIMBS> m{};
+  std::ranges::generate(x, [&] { return gen(); });
+  std::ranges::generate(m, [&] { return gen(); });
+  uint64_t hi = gen() & 1U;
+
+  for (auto _iter : state) {
+    benchmark::DoNotOptimize(hi);
+
+    std::array<uint64_t, LIMBS> t{};
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < LIMBS; i++) {
+      const uint64_t lt = subtle::ct_lt<uint64_t, uint64_t>(x[i], m[i]);
+      const uint64_t eq = subtle::ct_eq<uint64_t, uint64_t>(x[i], m[i]);
+      t[i] = x[i] - m[i] - borrow;
+      borrow = (lt | (eq & borrow)) & 1U;
+    }
+
+    const uint64_t keep = subtle::ct_lt<uint64_t, uint64_t>(hi, borrow);
+    for (size_t i = 0; i < LIMBS; i++) {
+      x[i] = subtle::ct_select(keep, x[i], t[i]);
+    }
+
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// A random odd LIMBS-limb modulus with its top bit set, and a random operand below it
+template<size_t LIMBS>
+std::pair<std::array<uint64_t, LIMBS>, std::array<uint64_t, LIMBS>>
+random_modulus_and_operand(std::mt19937_64& gen)
+{
+  std::array<uint64_t, LIMBS> n{};
+  std::array<uint64_t, LIMBS> a{};
+  std::ranges::generate(n, [&] { return gen(); });
+  std::ranges::generate(a, [&] { return gen(); });
+
+  n[0] |= 1U;
+  n[LIMBS - 1] |= 1ULL << 63;
+  a[LIMBS - 1] >>= 1;
+
+  return { n, a };
+}
+
+// Repeatedly multiplies an operand in Montgomery form by another one, using ct_montgomery::mul
+template<size_t LIMBS>
+void
+ct_montgomery_mul(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto [n, a] = random_modulus_and_operand<LIMBS>(gen);
+  const subtle::ct_montgomery<LIMBS> mont(n);
+
+  std::array<uint64_t, LIMBS> x{};
+  std::array<uint64_t, LIMBS> y{};
+  mont.to_montgomery(x, a);
+  y = x;
+
+  for (auto _iter : state) {
+    mont.mul(x, x, y);
+
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Repeatedly squares an operand in Montgomery form, using ct_montgomery::sqr
+template<size_t LIMBS>
+void
+ct_montgomery_sqr(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto [n, a] = random_modulus_and_operand<LIMBS>(gen);
+  const subtle::ct_montgomery<LIMBS> mont(n);
+
+  std::array<uint64_t, LIMBS> x{};
+  mont.to_montgomery(x, a);
+
+  for (auto _iter : state) {
+    mont.sqr(x, x);
+
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Repeatedly multiplies an operand in Montgomery form by another one the naive way, for reference:
+// the full schoolbook product into 2 * LIMBS limbs, then a separate word-by-word reduction pass,
+// ending in the hand-rolled ct_lt / ct_select conditional subtraction.
+template<size_t LIMBS>
+void
+schoolbook_montgomery_mul(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto [n, a] = random_modulus_and_operand<LIMBS>(gen);
+  const subtle::ct_montgomery<LIMBS> mont(n);
+
+  uint64_t n0inv = n[0];
+  for (size_t i = 0; i < 5; i++) {
+    n0inv *= 2U - n[0] * n0inv;
+  }
+  n0inv = uint64_t{ 0 } - n0inv;
+
+  std::array<uint64_t, LIMBS> x{};
+  std::array<uint64_t, LIMBS> y{};
+  mont.to_montgomery(x, a);
+  y = x;
+
+  for (auto _iter : state) {
+    std::array<uint64_t, 2 * LIMBS + 1> t{};
+
+    for (size_t i = 0; i < LIMBS; i++) {
+      uint64_t carry = 0;
+      for (size_t j = 0; j < LIMBS; j++) {
+        t[i + j] = subtle::ct_mac(x[j], y[i], t[i + j], carry);
+      }
+      t[i + LIMBS] = carry;
+    }
+
+    for (size_t i = 0; i < LIMBS; i++) {
+      const uint64_t m = t[i] * n0inv;
+
+      uint64_t carry = 0;
+      for (size_t j = 0; j < LIMBS; j++) {
+        t[i + j] = subtle::ct_mac(m, n[j], t[i + j], carry);
+      }
+      for (size_t j = i + LIMBS; j <= 2 * LIMBS; j++) {
+        uint64_t k = 0;
+        t[j] = subtle::ct_addc(t[j], carry, k);
+        carry = k;
+      }
+    }
+
+    std::array<uint64_t, LIMBS> d{};
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < LIMBS; i++) {
+      const uint64_t lt = subtle::ct_lt<uint64_t, uint64_t>(t[LIMBS + i], n[i]);
+      const uint64_t eq = subtle::ct_eq<uint64_t, uint64_t>(t[LIMBS + i], n[i]);
+      d[i] = t[LIMBS + i] - n[i] - borrow;
+      borrow = (lt | (eq & borrow)) & 1U;
+    }
+
+    const uint64_t keep = subtle::ct_lt<uint64_t, uint64_t>(t[2 * LIMBS], borrow);
+    for (size_t i = 0; i < LIMBS; i++) {
+      x[i] = subtle::ct_select(keep, t[LIMBS + i], d[i]);
+    }
+
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Prime moduli for the inversion benchmarks: the NIST P-256 prime and the Mersenne prime 2^521 - 1
+constexpr std::array<uint64_t, 4> P256 = { 0xffffffffffffffffULL, 0x00000000ffffffffULL, 0, 0xffffffff00000001ULL };
+constexpr std::array<uint64_t, 9> P521 = { ~0ULL, ~0ULL, ~0ULL, ~0ULL, ~0ULL, ~0ULL, ~0ULL, ~0ULL, 0x1ffULL };
+
+template<size_t LIMBS>
+constexpr std::array<uint64_t, LIMBS>
+inversion_prime()
+{
+  if constexpr (LIMBS == 4) {
+    return P256;
+  } else {
+    return P521;
+  }
+}
+
+// Inverts a random element modulo a prime using subtle::ct_modinv ( safegcd )
+template<size_t LIMBS>
+void
+ct_modinv(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  constexpr auto p = inversion_prime<LIMBS>();
+  const subtle::ct_modinv<LIMBS> modinv(p);
+
+  std::array<uint64_t, LIMBS> x{};
+  std::ranges::generate(x, [&] { return gen(); });
+  x[LIMBS - 1] %= p[LIMBS - 1];
+
+  for (auto _iter : state) {
+    modinv.invert(x, x);
+
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Inverts a random element modulo a prime by Fermat's little theorem, as x^( p - 2 ) with
+// ct_montgomery sqr / mul, scanning the public exponent bit by bit -- for reference
+template<size_t LIMBS>
+void
+fermat_modinv(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  constexpr auto p = inversion_prime<LIMBS>();
+  const subtle::ct_montgomery<LIMBS> mont(p);
+
+  auto exp = p;
+  exp[0] -= 2;
+
+  std::array<uint64_t, LIMBS> x{};
+  std::ranges::generate(x, [&] { return gen(); });
+  x[LIMBS - 1] %= p[LIMBS - 1];
+
+  for (auto _iter : state) {
+    std::array<uint64_t, LIMBS> base{};
+    std::array<uint64_t, LIMBS> acc{};
+    mont.to_montgomery(base, x);
+    acc = base;
+
+    for (size_t bit = 64 * LIMBS - static_cast<size_t>(std::countl_zero(exp[LIMBS - 1])) - 1; bit-- > 0;) {
+      mont.sqr(acc, acc);
+      if (((exp[bit / 64] >> (bit % 64)) & 1U) != 0) {
+        mont.mul(acc, acc, base);
+      }
+    }
+
+    mont.from_montgomery(x, acc);
+
+    benchmark::DoNotOptimize(x.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_add_carry<4>)->Name("ct_add_carry/4")->Apply(apply_stats);
+BENCHMARK(ct_add_carry<8>)->Name("ct_add_carry/8")->Apply(apply_stats);
+BENCHMARK(ct_add_carry<32>)->Name("ct_add_carry/32")->Apply(apply_stats);
+BENCHMARK(ct_cond_sub<4>)->Name("ct_cond_sub/4")->Apply(apply_stats);
+BENCHMARK(ct_cond_sub<8>)->Name("ct_cond_sub/8")->Apply(apply_stats);
+BENCHMARK(ct_cond_sub<32>)->Name("ct_cond_sub/32")->Apply(apply_stats);
+BENCHMARK(select_cond_sub<4>)->Name("select_cond_sub/4")->Apply(apply_stats);
+BENCHMARK(select_cond_sub<8>)->Name("select_cond_sub/8")->Apply(apply_stats);
+BENCHMARK(select_cond_sub<32>)->Name("select_cond_sub/32")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_mul<4>)->Name("ct_montgomery_mul/4")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_mul<8>)->Name("ct_montgomery_mul/8")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_mul<32>)->Name("ct_montgomery_mul/32")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_mul<64>)->Name("ct_montgomery_mul/64")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_sqr<4>)->Name("ct_montgomery_sqr/4")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_sqr<8>)->Name("ct_montgomery_sqr/8")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_sqr<32>)->Name("ct_montgomery_sqr/32")->Apply(apply_stats);
+BENCHMARK(ct_montgomery_sqr<64>)->Name("ct_montgomery_sqr/64")->Apply(apply_stats);
+BENCHMARK(schoolbook_montgomery_mul<4>)->Name("schoolbook_montgomery_mul/4")->Apply(apply_stats);
+BENCHMARK(schoolbook_montgomery_mul<8>)->Name("schoolbook_montgomery_mul/8")->Apply(apply_stats);
+BENCHMARK(schoolbook_montgomery_mul<32>)->Name("schoolbook_montgomery_mul/32")->Apply(apply_stats);
+BENCHMARK(schoolbook_montgomery_mul<64>)->Name("schoolbook_montgomery_mul/64")->Apply(apply_stats);
+BENCHMARK(ct_modinv<4>)->Name("ct_modinv/4")->Apply(apply_stats);
+BENCHMARK(ct_modinv<9>)->Name("ct_modinv/9")->Apply(apply_stats);
+BENCHMARK(fermat_modinv<4>)->Name("fermat_modinv/4")->Apply(apply_stats);
+BENCHMARK(fermat_modinv<9>)->Name("fermat_modinv/9")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
@@ -0,0 +1,192 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_bitvec.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Random integers of type operandT, as many as the benchmark argument
+template<typename operandT>
+std::vector<operandT>
+random_words(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<operandT> vals(n);
+  std::ranges::generate(vals, [&] { return static_cast<operandT>(gen()); });
+  return vals;
+}
+
+// Counts the bits set across a span using subtle::ct_hamming_weight
+template<typename operandT>
+void
+ct_hamming_weight(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto vals = random_words<operandT>(n);
+
+  for (auto _iter : state) {
+    const auto weight = subtle::ct_hamming_weight(std::span<const operandT>(vals));
+
+    benchmark::DoNotOptimize(weight);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(operandT)));
+}
+
+// Counts the bit positions in which two spans differ using subtle::ct_hamming_distance
+template<typename operandT>
+void
+ct_hamming_distance(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto lhs = random_words<operandT>(n);
+  const auto rhs = random_words<operandT>(n);
+
+  for (auto _iter : state) {
+    const auto distance = subtle::ct_hamming_distance(std::span<const operandT>(lhs), std::span<const operandT>(rhs));
+
+    benchmark::DoNotOptimize(distance);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(operandT)));
+}
+
+// Counts the bits set across a span by testing every bit of every element in turn
+template<typename operandT>
+void
+naive_hamming_weight(benchmark::State& state)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto vals = random_words<operandT>(n);
+
+  for (auto _iter : state) {
+    size_t weight = 0;
+    for (const auto val : vals) {
+      for (size_t bit = 0; bit < std::numeric_limits<Uop>::digits; bit++) {
+        weight += static_cast<size_t>((static_cast<Uop>(val) >> bit) & 1U);
+      }
+    }
+
+    benchmark::DoNotOptimize(weight);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(operandT)));
+}
+
+// A random bit vector of BITS bits
+template<size_t BITS>
+subtle::ct_bitvec<BITS>
+random_bitvec()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint64_t, subtle::ct_bitvec<BITS>::word_count> words{};
+  std::ranges::generate(words, [&] { return gen(); });
+  return subtle::ct_bitvec<BITS>(words);
+}
+
+// Rotates a bit vector by a secret amount using subtle::ct_rotate
+template<size_t BITS>
+void
+ct_rotate(benchmark::State& state)
+{
+  auto vec = random_bitvec<BITS>();
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (auto _iter : state) {
+    subtle::ct_rotate(vec, gen() % BITS);
+
+    benchmark::DoNotOptimize(vec.words().data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Rotates a bit vector by a secret amount by computing every one of the BITS rotations
+// and keeping the right one with subtle::ct_conditional_memcpy -- the quadratic scan
+// subtle::ct_rotate avoids
+template<size_t BITS>
+void
+select_scan_rotate(benchmark::State& state)
+{
+  constexpr size_t n = subtle::ct_bitvec<BITS>::word_count;
+
+  auto vec = random_bitvec<BITS>();
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint64_t, 3 * n> padded{};
+  std::array<uint64_t, 3 * n> rotated{};
+  std::array<uint64_t, n> out{};
+
+  for (auto _iter : state) {
+    const uint64_t amount = gen() % BITS;
+    std::ranges::copy(vec.words(), padded.begin() + n);
+    std::ranges::copy(vec.words(), out.begin());
+
+    for (size_t r = 1; r < BITS; r++) {
+      subtle::ct_rotate_stage<BITS>(rotated, padded, r, ~uint64_t{ 0 });
+
+      const auto br = subtle::ct_eq<uint64_t, uint64_t>(r, amount);
+      subtle::ct_conditional_memcpy(br, std::span(out), std::span<const uint64_t, n>(rotated.data() + n, n));
+    }
+
+    std::ranges::copy(out, vec.words().begin());
+
+    benchmark::DoNotOptimize(vec.words().data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// XORs two bit vectors in place, with ct_bitvec's word-parallel operator^=
+template<size_t BITS>
+void
+ct_bitvec_xor(benchmark::State& state)
+{
+  auto a = random_bitvec<BITS>();
+  const auto b = random_bitvec<BITS>();
+
+  for (auto _iter : state) {
+    a ^= b;
+
+    benchmark::DoNotOptimize(a.words().data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * subtle::ct_bitvec<BITS>::word_count * sizeof(uint64_t)));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_hamming_weight<uint8_t>)->Name("ct_hamming_weight/u8")->Arg(4096)->Arg(65536)->Apply(apply_stats);
+BENCHMARK(ct_hamming_weight<uint64_t>)->Name("ct_hamming_weight/u64")->Arg(512)->Arg(8192)->Apply(apply_stats);
+BENCHMARK(ct_hamming_distance<uint64_t>)->Name("ct_hamming_distance/u64")->Arg(512)->Arg(8192)->Apply(apply_stats);
+BENCHMARK(naive_hamming_weight<uint8_t>)->Name("naive_hamming_weight/u8")->Arg(4096)->Arg(65536)->Apply(apply_stats);
+BENCHMARK(naive_hamming_weight<uint64_t>)->Name("naive_hamming_weight/u64")->Arg(512)->Arg(8192)->Apply(apply_stats);
+BENCHMARK(ct_rotate<1024>)->Name("ct_rotate/1024")->Apply(apply_stats);
+BENCHMARK(ct_rotate<12323>)->Name("ct_rotate/12323")->Apply(apply_stats);
+BENCHMARK(select_scan_rotate<1024>)->Name("select_scan_rotate/1024")->Apply(apply_stats);
+BENCHMARK(select_scan_rotate<12323>)->Name("select_scan_rotate/12323")->Apply(apply_stats);
+BENCHMARK(ct_bitvec_xor<12323>)->Name("ct_bitvec_xor/12323")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
@@ -0,0 +1,230 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_codec.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+constexpr std::string_view BASE64_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Random bytes, as many as the benchmark argument
+std::vector<uint8_t>
+random_key(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint8_t> key(n);
+  std::ranges::generate(key, [&] { return static_cast<uint8_t>(gen()); });
+  return key;
+}
+
+// Inverse of an alphabet, 0xff marking characters out of it
+template<size_t M>
+constexpr std::array<uint8_t, 256>
+inverse_table(const std::string_view alphabet, const std::array<char, M>& extra)
+{
+  std::array<uint8_t, 256> table{};
+  table.fill(0xff);
+  for (size_t i = 0; i < alphabet.size(); i++) {
+    table[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+  }
+  for (size_t i = 0; i < M; i++) {
+    table[static_cast<uint8_t>(extra[i])] = static_cast<uint8_t>(10 + i);
+  }
+  return table;
+}
+
+constexpr auto HEX_VALUES = inverse_table(HEX_DIGITS, std::array{ 'A', 'B', 'C', 'D', 'E', 'F' });
+constexpr auto BASE64_VALUES = inverse_table(BASE64_ALPHABET, std::array<char, 0>{});
+
+// Hex encodes a key using subtle::ct_hex_encode
+void
+ct_hex_encode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(2 * n);
+
+  for (auto _iter : state) {
+    subtle::ct_hex_encode(std::span(text), std::span<const uint8_t>(key));
+
+    benchmark::DoNotOptimize(text.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Hex decodes a key using subtle::ct_hex_decode
+void
+ct_hex_decode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(2 * n);
+  subtle::ct_hex_encode(std::span(text), std::span<const uint8_t>(key));
+  std::vector<uint8_t> out(n);
+
+  for (auto _iter : state) {
+    const auto valid = subtle::ct_hex_decode<uint32_t>(std::span(out), std::span<const char>(text));
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Hex decodes a key the way it is usually written: a table lookup per character, indexed
+// by the secret, and a branch on its validity
+void
+table_hex_decode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(2 * n);
+  subtle::ct_hex_encode(std::span(text), std::span<const uint8_t>(key));
+  std::vector<uint8_t> out(n);
+
+  for (auto _iter : state) {
+    bool valid = true;
+    for (size_t i = 0; i < n; i++) {
+      const uint8_t hi = HEX_VALUES[static_cast<uint8_t>(text[2 * i])];
+      const uint8_t lo = HEX_VALUES[static_cast<uint8_t>(text[2 * i + 1])];
+      if ((hi | lo) == 0xff) {
+        valid = false;
+        break;
+      }
+      out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Base64 encodes a key using subtle::ct_base64_encode
+void
+ct_base64_encode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(subtle::ct_base64_encoded_size(n));
+
+  for (auto _iter : state) {
+    subtle::ct_base64_encode(std::span(text), std::span<const uint8_t>(key));
+
+    benchmark::DoNotOptimize(text.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Base64 encodes a key the way it is usually written: a table lookup per character,
+// indexed by the secret
+void
+table_base64_encode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(subtle::ct_base64_encoded_size(n));
+
+  for (auto _iter : state) {
+    size_t o = 0;
+    for (size_t i = 0; i + 3 <= n; i += 3, o += 4) {
+      const uint32_t w = (static_cast<uint32_t>(key[i]) << 16) | (static_cast<uint32_t>(key[i + 1]) << 8) | key[i + 2];
+      text[o] = BASE64_ALPHABET[w >> 18];
+      text[o + 1] = BASE64_ALPHABET[(w >> 12) & 63U];
+      text[o + 2] = BASE64_ALPHABET[(w >> 6) & 63U];
+      text[o + 3] = BASE64_ALPHABET[w & 63U];
+    }
+
+    benchmark::DoNotOptimize(text.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Base64 decodes a key using subtle::ct_base64_decode
+void
+ct_base64_decode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(subtle::ct_base64_encoded_size(n));
+  subtle::ct_base64_encode(std::span(text), std::span<const uint8_t>(key));
+  std::vector<uint8_t> out(n);
+
+  for (auto _iter : state) {
+    const auto valid = subtle::ct_base64_decode<uint32_t>(std::span(out), std::span<const char>(text));
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Base64 decodes a key the way it is usually written: a table lookup per character,
+// indexed by the secret, and a branch on its validity
+void
+table_base64_decode(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto key = random_key(n);
+  std::vector<char> text(subtle::ct_base64_encoded_size(n));
+  subtle::ct_base64_encode(std::span(text), std::span<const uint8_t>(key));
+  std::vector<uint8_t> out(n);
+
+  for (auto _iter : state) {
+    bool valid = true;
+    size_t o = 0;
+    for (size_t i = 0; o + 3 <= n; i += 4, o += 3) {
+      const uint8_t a = BASE64_VALUES[static_cast<uint8_t>(text[i])];
+      const uint8_t b = BASE64_VALUES[static_cast<uint8_t>(text[i + 1])];
+      const uint8_t c = BASE64_VALUES[static_cast<uint8_t>(text[i + 2])];
+      const uint8_t d = BASE64_VALUES[static_cast<uint8_t>(text[i + 3])];
+      if ((a | b | c | d) == 0xff) {
+        valid = false;
+        break;
+      }
+
+      const uint32_t w = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) | (static_cast<uint32_t>(c) << 6) | d;
+      out[o] = static_cast<uint8_t>(w >> 16);
+      out[o + 1] = static_cast<uint8_t>(w >> 8);
+      out[o + 2] = static_cast<uint8_t>(w);
+    }
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_hex_encode)->Name("ct_hex_encode")->Arg(32)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_hex_decode)->Name("ct_hex_decode")->Arg(32)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(table_hex_decode)->Name("table_hex_decode")->Arg(32)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_base64_encode)->Name("ct_base64_encode")->Arg(48)->Arg(4095)->Apply(apply_stats);
+BENCHMARK(table_base64_encode)->Name("table_base64_encode")->Arg(48)->Arg(4095)->Apply(apply_stats);
+BENCHMARK(ct_base64_decode)->Name("ct_base64_decode")->Arg(48)->Arg(4095)->Apply(apply_stats);
+BENCHMARK(table_base64_decode)->Name("table_base64_decode")->Arg(48)->Arg(4095)->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
@@ -75,7 +75,63 @@ native_conditional_copy(benchmark::State& state)
   state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
 }
 
+// Copies a prefix of secret length, drawn afresh every iteration, using
+// subtle::ct_memcpy_prefix
+void
+ct_memcpy_prefix(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint8_t> dis;
+
+  std::vector<uint8_t> src(len);
+  std::vector<uint8_t> dst(len);
+  std::ranges::generate(src, [&] { return dis(gen); });
+
+  for (auto _iter : state) {
+    const size_t prefix = gen() % (len + 1);
+    subtle::ct_memcpy_prefix(std::span(dst), std::span<const uint8_t>(src), prefix);
+
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
+// Copies a prefix of secret length one byte at a time, each under its own
+// subtle::ct_lt comparison of the index against the length
+void
+lt_select_prefix(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint8_t> dis;
+
+  std::vector<uint8_t> src(len);
+  std::vector<uint8_t> dst(len);
+  std::ranges::generate(src, [&] { return dis(gen); });
+
+  for (auto _iter : state) {
+    const size_t prefix = gen() % (len + 1);
+    for (size_t i = 0; i < len; i++) {
+      dst[i] = subtle::ct_select(subtle::ct_lt<size_t, uint32_t>(i, prefix), src[i], dst[i]);
+    }
+
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
 }
 
 BENCHMARK(ct_conditional_copy)->Name("ct_conditional_copy")->Apply(apply_sizes);         // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_memcpy_prefix)->Name("ct_memcpy_prefix")->Apply(apply_sizes);               // NOLINT(cert-err58-cpp)
+BENCHMARK(lt_select_prefix)->Name("lt_select_prefix")->Apply(apply_sizes);               // NOLINT(cert-err58-cpp)
 BENCHMARK(native_conditional_copy)->Name("native_conditional_copy")->Apply(apply_sizes); // NOLINT(cert-err58-cpp)
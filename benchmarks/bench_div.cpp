@@ -0,0 +1,205 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t COEFFS = 256;
+
+// Kyber modulus, and the Dilithium modulus
+constexpr uint64_t KYBER_Q = 3329;
+constexpr uint64_t DILITHIUM_Q = 8380417;
+
+// Random operands of type operandT, bounded so that x + D / 2 does not overflow
+template<typename operandT, uint64_t D>
+std::vector<operandT>
+random_operands()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint64_t> dis(0, std::numeric_limits<operandT>::max() - D / 2);
+
+  std::vector<operandT> vals(COEFFS);
+  std::ranges::generate(vals, [&] { return static_cast<operandT>(dis(gen)); });
+  return vals;
+}
+
+// Divides a whole coefficient array by D using subtle::ct_div
+template<typename operandT, uint64_t D>
+void
+ct_div_span(benchmark::State& state)
+{
+  auto vals = random_operands<operandT, D>();
+  const auto orig = vals;
+
+  for (auto _iter : state) {
+    subtle::ct_div<D>(std::span(vals));
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+
+    std::ranges::copy(orig, vals.begin());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COEFFS));
+}
+
+// Reduces a whole coefficient array modulo D using subtle::ct_mod
+template<typename operandT, uint64_t D>
+void
+ct_mod_span(benchmark::State& state)
+{
+  auto vals = random_operands<operandT, D>();
+  const auto orig = vals;
+
+  for (auto _iter : state) {
+    subtle::ct_mod<D>(std::span(vals));
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+
+    std::ranges::copy(orig, vals.begin());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COEFFS));
+}
+
+// Divides a whole coefficient array by D through a hardware division instruction -- the
+// divisor is laundered through an opaque value, so the compiler cannot strength-reduce
+template<typename operandT, uint64_t D>
+void
+hw_div_span(benchmark::State& state)
+{
+  auto vals = random_operands<operandT, D>();
+  const auto orig = vals;
+
+  auto d = static_cast<operandT>(D);
+  benchmark::DoNotOptimize(d);
+
+  for (auto _iter : state) {
+    for (auto& val : vals) {
+      val = static_cast<operandT>(val / d);
+    }
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+
+    std::ranges::copy(orig, vals.begin());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COEFFS));
+}
+
+// Kyber compression of a polynomial to d = 10 bits, round( 2^d * x / q ) mod 2^d,
+// using subtle::ct_div_round
+void
+ct_kyber_compress(benchmark::State& state)
+{
+  constexpr uint32_t d = 10;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis(0, KYBER_Q - 1);
+
+  std::vector<uint32_t> coeffs(COEFFS);
+  std::ranges::generate(coeffs, [&] { return dis(gen); });
+  std::vector<uint32_t> compressed(COEFFS);
+
+  for (auto _iter : state) {
+    for (size_t i = 0; i < COEFFS; i++) {
+      compressed[i] = subtle::ct_div_round<KYBER_Q>(coeffs[i] << d) & ((1U << d) - 1);
+    }
+
+    benchmark::DoNotOptimize(compressed.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COEFFS));
+}
+
+// Random dividends and ( non-zero ) divisors of type operandT, the divisors of random bit length
+template<typename operandT>
+std::pair<std::vector<operandT>, std::vector<operandT>>
+random_dividends_and_divisors()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<operandT> xs(COEFFS);
+  std::vector<operandT> ds(COEFFS);
+  std::ranges::generate(xs, [&] { return static_cast<operandT>(gen()); });
+  std::ranges::generate(ds, [&] { return static_cast<operandT>((static_cast<operandT>(gen()) >> (gen() % std::numeric_limits<operandT>::digits)) | 1); });
+
+  return { xs, ds };
+}
+
+// Divides random dividends by random secret divisors using subtle::ct_divmod
+template<typename operandT>
+void
+ct_divmod(benchmark::State& state)
+{
+  const auto [xs, ds] = random_dividends_and_divisors<operandT>();
+  std::vector<operandT> quots(COEFFS);
+  std::vector<operandT> rems(COEFFS);
+
+  for (auto _iter : state) {
+    for (size_t i = 0; i < COEFFS; i++) {
+      const auto is_zero = subtle::ct_divmod<operandT, uint32_t>(xs[i], ds[i], quots[i], rems[i]);
+      benchmark::DoNotOptimize(is_zero);
+    }
+
+    benchmark::DoNotOptimize(quots.data());
+    benchmark::DoNotOptimize(rems.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COEFFS));
+}
+
+// Divides random dividends by random divisors through the hardware division instruction
+template<typename operandT>
+void
+hw_divmod(benchmark::State& state)
+{
+  const auto [xs, ds] = random_dividends_and_divisors<operandT>();
+  std::vector<operandT> quots(COEFFS);
+  std::vector<operandT> rems(COEFFS);
+
+  for (auto _iter : state) {
+    for (size_t i = 0; i < COEFFS; i++) {
+      quots[i] = static_cast<operandT>(xs[i] / ds[i]);
+      rems[i] = static_cast<operandT>(xs[i] % ds[i]);
+    }
+
+    benchmark::DoNotOptimize(quots.data());
+    benchmark::DoNotOptimize(rems.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * COEFFS));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_div_span<uint16_t, KYBER_Q>)->Name("ct_div/u16/3329")->Apply(apply_stats);
+BENCHMARK(ct_div_span<uint32_t, KYBER_Q>)->Name("ct_div/u32/3329")->Apply(apply_stats);
+BENCHMARK(ct_div_span<uint32_t, DILITHIUM_Q>)->Name("ct_div/u32/8380417")->Apply(apply_stats);
+BENCHMARK(ct_div_span<uint64_t, DILITHIUM_Q>)->Name("ct_div/u64/8380417")->Apply(apply_stats);
+BENCHMARK(ct_mod_span<uint32_t, KYBER_Q>)->Name("ct_mod/u32/3329")->Apply(apply_stats);
+BENCHMARK(ct_mod_span<uint64_t, DILITHIUM_Q>)->Name("ct_mod/u64/8380417")->Apply(apply_stats);
+BENCHMARK(hw_div_span<uint16_t, KYBER_Q>)->Name("hw_div/u16/3329")->Apply(apply_stats);
+BENCHMARK(hw_div_span<uint32_t, KYBER_Q>)->Name("hw_div/u32/3329")->Apply(apply_stats);
+BENCHMARK(hw_div_span<uint32_t, DILITHIUM_Q>)->Name("hw_div/u32/8380417")->Apply(apply_stats);
+BENCHMARK(hw_div_span<uint64_t, DILITHIUM_Q>)->Name("hw_div/u64/8380417")->Apply(apply_stats);
+BENCHMARK(ct_kyber_compress)->Name("ct_kyber_compress/10")->Apply(apply_stats);
+BENCHMARK(ct_divmod<uint32_t>)->Name("ct_divmod/u32")->Apply(apply_stats);
+BENCHMARK(ct_divmod<uint64_t>)->Name("ct_divmod/u64")->Apply(apply_stats);
+BENCHMARK(ct_divmod<int64_t>)->Name("ct_divmod/i64")->Apply(apply_stats);
+BENCHMARK(hw_divmod<uint32_t>)->Name("hw_divmod/u32")->Apply(apply_stats);
+BENCHMARK(hw_divmod<uint64_t>)->Name("hw_divmod/u64")->Apply(apply_stats);
+BENCHMARK(hw_divmod<int64_t>)->Name("hw_divmod/i64")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
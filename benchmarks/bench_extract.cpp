@@ -0,0 +1,103 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Length of the window extracted from a record: a SHA-256 HMAC tag
+constexpr size_t MAC_LEN = 32;
+
+// Random bytes, as many as the benchmark argument
+std::vector<uint8_t>
+random_record(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint8_t> record(n);
+  std::ranges::generate(record, [&] { return static_cast<uint8_t>(gen()); });
+  return record;
+}
+
+// Copies the MAC out of a record at a secret offset using subtle::ct_extract
+void
+ct_extract(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto record = random_record(n);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint8_t, MAC_LEN> mac{};
+  std::array<uint8_t, MAC_LEN> scratch{};
+
+  for (auto _iter : state) {
+    const size_t offset = gen() % (n - MAC_LEN + 1);
+    subtle::ct_extract(std::span(mac), std::span<const uint8_t>(record), offset, std::span(scratch));
+
+    benchmark::DoNotOptimize(mac.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Copies the MAC out of a record at a secret offset one byte at a time, each with a
+// subtle::ct_lookup scan over the whole record
+void
+lookup_extract(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto record = random_record(n);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint8_t, MAC_LEN> mac{};
+
+  for (auto _iter : state) {
+    const size_t offset = gen() % (n - MAC_LEN + 1);
+    for (size_t i = 0; i < MAC_LEN; i++) {
+      mac[i] = subtle::ct_lookup<size_t, uint8_t>(offset + i, std::span<const uint8_t>(record));
+    }
+
+    benchmark::DoNotOptimize(mac.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Rotates a buffer by a secret amount using subtle::ct_rotate_bytes
+void
+ct_rotate_bytes(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  auto buf = random_record(n);
+  std::vector<uint8_t> scratch(n);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (auto _iter : state) {
+    subtle::ct_rotate_bytes(std::span(buf), gen() % n, std::span(scratch));
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_extract)->Name("ct_extract/32")->Arg(256)->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(lookup_extract)->Name("lookup_extract/32")->Arg(256)->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_rotate_bytes)->Name("ct_rotate_bytes")->Arg(256)->Arg(1024)->Arg(16384)->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
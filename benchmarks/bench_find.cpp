@@ -0,0 +1,93 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include <algorithm>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+// The data block of an OAEP-decoded message of n bytes: zero padding, then the 0x01
+// separator at a random position, then the message
+std::vector<uint8_t>
+oaep_block(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint8_t> block(n);
+  const size_t sep = gen() % n;
+  std::ranges::generate(std::span(block).subspan(sep), [&] { return static_cast<uint8_t>(gen()); });
+  block[sep] = 0x01;
+  return block;
+}
+
+// Locates the first 0x01 byte using subtle::ct_find_first
+void
+ct_find_first(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto block = oaep_block(n);
+
+  for (auto _iter : state) {
+    size_t idx = 0;
+    const auto found = subtle::ct_find_first<uint8_t, uint32_t>(std::span<const uint8_t>(block), 0x01, idx);
+
+    benchmark::DoNotOptimize(found);
+    benchmark::DoNotOptimize(idx);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Locates the last 0x01 byte using subtle::ct_find_last
+void
+ct_find_last(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto block = oaep_block(n);
+
+  for (auto _iter : state) {
+    size_t idx = 0;
+    const auto found = subtle::ct_find_last<uint8_t, uint32_t>(std::span<const uint8_t>(block), 0x01, idx);
+
+    benchmark::DoNotOptimize(found);
+    benchmark::DoNotOptimize(idx);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Locates the first 0x01 byte with a subtle::ct_eq and a subtle::ct_select per byte
+void
+select_scan_find_first(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto block = oaep_block(n);
+
+  for (auto _iter : state) {
+    uint32_t found = 0;
+    size_t idx = n;
+    for (size_t i = 0; i < n; i++) {
+      const uint32_t hit = ~found & subtle::ct_eq<uint8_t, uint32_t>(block[i], 0x01);
+      idx = subtle::ct_select(hit, i, idx);
+      found |= hit;
+    }
+
+    benchmark::DoNotOptimize(found);
+    benchmark::DoNotOptimize(idx);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_find_first)->Name("ct_find_first/u8")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(ct_find_last)->Name("ct_find_last/u8")->Arg(256)->Arg(4096)->Apply(apply_stats);
+BENCHMARK(select_scan_find_first)->Name("select_scan_find_first/u8")->Arg(256)->Arg(4096)->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
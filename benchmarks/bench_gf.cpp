@@ -0,0 +1,163 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_gf.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Random elements of GF(2^m), as many as the benchmark argument
+template<typename operandT>
+std::vector<operandT>
+random_elems(const size_t n, const size_t m)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<operandT> elems(n);
+  std::ranges::generate(elems, [&] { return static_cast<operandT>(gen() & ((uint64_t{ 1 } << m) - 1U)); });
+  return elems;
+}
+
+// Log / antilog tables of GF(2^8) under the AES polynomial, with generator 0x03
+struct gf256_tables
+{
+  std::array<uint8_t, 256> log{};
+  std::array<uint8_t, 512> exp{};
+
+  gf256_tables()
+  {
+    uint8_t x = 1;
+    for (size_t i = 0; i < 255; i++) {
+      exp[i] = exp[i + 255] = x;
+      log[x] = static_cast<uint8_t>(i);
+      x = static_cast<uint8_t>(x ^ subtle::ct_gf256_mul(x, 0x02));
+    }
+  }
+};
+
+const gf256_tables TABLES; // NOLINT(cert-err58-cpp)
+
+// Multiply-accumulates a span of GF(2^m) elements, with elements of type operandT, by a
+// secret scalar using subtle::ct_gf_muladd_span
+template<size_t m, uint32_t poly, typename operandT>
+void
+ct_gf_muladd_span(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto src = random_elems<operandT>(n, m);
+  auto acc = random_elems<operandT>(n, m);
+  const auto c = random_elems<operandT>(1, m)[0];
+
+  for (auto _iter : state) {
+    subtle::ct_gf_muladd_span<m, poly>(std::span(acc), std::span<const operandT>(src), c);
+
+    benchmark::DoNotOptimize(acc.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(operandT)));
+}
+
+// Multiply-accumulates a span of GF(2^8) elements by a secret scalar the way it is
+// usually written: log / antilog table lookups indexed by the secrets, and a branch on
+// zero
+void
+table_gf256_muladd(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto src = random_elems<uint8_t>(n, 8);
+  auto acc = random_elems<uint8_t>(n, 8);
+  const auto c = static_cast<uint8_t>(random_elems<uint8_t>(1, 8)[0] | 1U);
+
+  for (auto _iter : state) {
+    const size_t log_c = TABLES.log[c];
+    for (size_t i = 0; i < n; i++) {
+      if (src[i] != 0) {
+        acc[i] ^= TABLES.exp[log_c + TABLES.log[src[i]]];
+      }
+    }
+
+    benchmark::DoNotOptimize(acc.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Multiplies two spans of GF(2^m) elements, elementwise, using subtle::ct_gf_mul_span
+template<size_t m, uint32_t poly, typename operandT>
+void
+ct_gf_mul_span(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto a = random_elems<operandT>(n, m);
+  const auto b = random_elems<operandT>(n, m);
+  std::vector<operandT> dst(n);
+
+  for (auto _iter : state) {
+    subtle::ct_gf_mul_span<m, poly>(std::span(dst), std::span<const operandT>(a), std::span<const operandT>(b));
+
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * sizeof(operandT)));
+}
+
+// Splits a secret into shares f( 1 ) .. f( n ) of a random polynomial f of degree 15
+// using subtle::ct_gf_poly_eval
+void
+ct_gf_poly_eval(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto coeffs = random_elems<uint8_t>(16, 8);
+
+  std::vector<uint8_t> xs(n);
+  std::ranges::generate(xs, [x = 0]() mutable { return static_cast<uint8_t>(++x); });
+  std::vector<uint8_t> ys(n);
+
+  for (auto _iter : state) {
+    subtle::ct_gf_poly_eval<8, 0x11b>(std::span(ys), std::span<const uint8_t>(xs), std::span<const uint8_t>(coeffs));
+
+    benchmark::DoNotOptimize(ys.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Inverts GF(2^m) elements one at a time using subtle::ct_gf_inv
+template<size_t m, uint32_t poly, typename operandT>
+void
+ct_gf_inv(benchmark::State& state)
+{
+  const auto elems = random_elems<operandT>(256, m);
+
+  for (auto _iter : state) {
+    for (const operandT a : elems) {
+      auto inv = subtle::ct_gf_inv<m, poly>(a);
+      benchmark::DoNotOptimize(inv);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * elems.size()));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_gf_muladd_span<8, 0x11b, uint8_t>)->Name("ct_gf_muladd_span/gf256_aes")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_gf_muladd_span<8, 0x11d, uint8_t>)->Name("ct_gf_muladd_span/gf256_rs")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_gf_muladd_span<13, 0x201b, uint16_t>)->Name("ct_gf_muladd_span/gf8192")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(table_gf256_muladd)->Name("table_gf256_muladd")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_gf_mul_span<8, 0x11b, uint8_t>)->Name("ct_gf_mul_span/gf256_aes")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_gf_mul_span<8, 0x11d, uint8_t>)->Name("ct_gf_mul_span/gf256_rs")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_gf_mul_span<13, 0x201b, uint16_t>)->Name("ct_gf_mul_span/gf8192")->Arg(1024)->Arg(16384)->Apply(apply_stats);
+BENCHMARK(ct_gf_poly_eval)->Name("ct_gf_poly_eval/gf256_aes/16")->Arg(255)->Apply(apply_stats);
+BENCHMARK(ct_gf_inv<8, 0x11d, uint8_t>)->Name("ct_gf_inv/gf256_rs")->Apply(apply_stats);
+BENCHMARK(ct_gf_inv<13, 0x201b, uint16_t>)->Name("ct_gf_inv/gf8192")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
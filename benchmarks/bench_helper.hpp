@@ -29,3 +29,10 @@ apply_sizes(::benchmark::Benchmark* bench)
 
   bench->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 }
+
+// Statistics-only configuration, for benchmarks whose sizes are fixed at compile time
+inline void
+apply_stats(::benchmark::Benchmark* bench)
+{
+  bench->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+}
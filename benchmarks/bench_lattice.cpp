@@ -0,0 +1,112 @@
+#include "bench_helper.hpp"
+#include "subtle/ct_lattice.hpp"
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr size_t DEGREE = 256;
+
+// Kyber modulus, and the Dilithium modulus
+constexpr int16_t KYBER_Q = 3329;
+constexpr int32_t DILITHIUM_Q = 8380417;
+
+// A random polynomial with coefficients in [-q, 2q)
+template<typename coeffT>
+std::array<coeffT, DEGREE>
+random_poly(const coeffT q)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis(-q, 2 * q - 1);
+
+  std::array<coeffT, DEGREE> poly{};
+  std::ranges::generate(poly, [&] { return static_cast<coeffT>(dis(gen)); });
+  return poly;
+}
+
+// Freezes a whole polynomial to [0, q) using subtle::ct_freeze_mod -- on the fixed
+// extent of 256 coefficients, or through a dynamic-extent span
+template<typename coeffT, bool fixed>
+void
+ct_freeze_mod(benchmark::State& state)
+{
+  const coeffT q = sizeof(coeffT) == 2 ? KYBER_Q : static_cast<coeffT>(DILITHIUM_Q);
+  const auto orig = random_poly<coeffT>(q);
+  auto poly = orig;
+
+  for (auto _iter : state) {
+    if constexpr (fixed) {
+      subtle::ct_freeze_mod(std::span(poly), q);
+    } else {
+      subtle::ct_freeze_mod(std::span<coeffT>(poly), q);
+    }
+
+    benchmark::DoNotOptimize(poly.data());
+    benchmark::ClobberMemory();
+
+    poly = orig;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * DEGREE));
+}
+
+// Centers a whole frozen polynomial using subtle::ct_center
+template<typename coeffT>
+void
+ct_center(benchmark::State& state)
+{
+  const coeffT q = sizeof(coeffT) == 2 ? KYBER_Q : static_cast<coeffT>(DILITHIUM_Q);
+  auto orig = random_poly<coeffT>(q);
+  subtle::ct_freeze_mod(std::span(orig), q);
+  auto poly = orig;
+
+  for (auto _iter : state) {
+    subtle::ct_center(std::span(poly), q);
+
+    benchmark::DoNotOptimize(poly.data());
+    benchmark::ClobberMemory();
+
+    poly = orig;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * DEGREE));
+}
+
+// Freezes a whole polynomial to [0, q) coefficient by coefficient, with the scalar
+// subtle::ct_freeze_mod
+template<typename coeffT>
+void
+scalar_freeze_mod(benchmark::State& state)
+{
+  const coeffT q = sizeof(coeffT) == 2 ? KYBER_Q : static_cast<coeffT>(DILITHIUM_Q);
+  const auto orig = random_poly<coeffT>(q);
+  auto poly = orig;
+
+  for (auto _iter : state) {
+    for (auto& coeff : poly) {
+      coeff = subtle::ct_freeze_mod(coeff, q);
+    }
+
+    benchmark::DoNotOptimize(poly.data());
+    benchmark::ClobberMemory();
+
+    poly = orig;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * DEGREE));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_freeze_mod<int16_t, true>)->Name("ct_freeze_mod/i16/256")->Apply(apply_stats);
+BENCHMARK(ct_freeze_mod<int16_t, false>)->Name("ct_freeze_mod/i16/dynamic")->Apply(apply_stats);
+BENCHMARK(ct_freeze_mod<int32_t, true>)->Name("ct_freeze_mod/i32/256")->Apply(apply_stats);
+BENCHMARK(ct_freeze_mod<int32_t, false>)->Name("ct_freeze_mod/i32/dynamic")->Apply(apply_stats);
+BENCHMARK(ct_center<int16_t>)->Name("ct_center/i16/256")->Apply(apply_stats);
+BENCHMARK(ct_center<int32_t>)->Name("ct_center/i32/256")->Apply(apply_stats);
+BENCHMARK(scalar_freeze_mod<int16_t>)->Name("scalar_freeze_mod/i16/256")->Apply(apply_stats);
+BENCHMARK(scalar_freeze_mod<int32_t>)->Name("scalar_freeze_mod/i32/256")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
@@ -30,6 +30,32 @@ ct_memcmp(benchmark::State& state)
   state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
 }
 
+// Constant-time equality of the first secret-length bytes of two arrays using
+// subtle::ct_memcmp_prefix, the length being drawn afresh every iteration
+void
+ct_memcmp_prefix(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint8_t> dis;
+
+  std::vector<uint8_t> a(len);
+  std::ranges::generate(a, [&] { return dis(gen); });
+  auto b = a;
+
+  for (auto _iter : state) {
+    const size_t prefix = gen() % (len + 1);
+    auto result = subtle::ct_memcmp_prefix<uint8_t, uint32_t>(std::span<const uint8_t>(a), std::span<const uint8_t>(b), prefix);
+
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
 // Native byte-array equality comparison using std::memcmp
 void
 native_memcmp(benchmark::State& state)
@@ -56,5 +82,6 @@ native_memcmp(benchmark::State& state)
 
 }
 
-BENCHMARK(ct_memcmp)->Name("ct_memcmp")->Apply(apply_sizes);         // NOLINT(cert-err58-cpp)
-BENCHMARK(native_memcmp)->Name("native_memcmp")->Apply(apply_sizes); // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_memcmp)->Name("ct_memcmp")->Apply(apply_sizes);               // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_memcmp_prefix)->Name("ct_memcmp_prefix")->Apply(apply_sizes); // NOLINT(cert-err58-cpp)
+BENCHMARK(native_memcmp)->Name("native_memcmp")->Apply(apply_sizes);       // NOLINT(cert-err58-cpp)
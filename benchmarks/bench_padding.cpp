@@ -0,0 +1,107 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_padding.hpp"
+#include <algorithm>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+// A PKCS#1 v1.5 encryption block of n bytes carrying a 32-byte message -- an RSA
+// encrypted AES-256 key
+std::vector<uint8_t>
+pkcs1_block(const size_t n)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint8_t> em(n);
+  std::ranges::generate(em, [&] { return static_cast<uint8_t>(1 + gen() % 255); });
+  em[0] = 0x00;
+  em[1] = 0x02;
+  em[n - 33] = 0x00;
+  return em;
+}
+
+// Checks and strips PKCS#1 v1.5 padding using subtle::ct_pkcs1_v15_unpad
+void
+ct_pkcs1_v15_unpad(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto em = pkcs1_block(n);
+
+  for (auto _iter : state) {
+    size_t len = 0;
+    const auto valid = subtle::ct_pkcs1_v15_unpad<uint32_t>(std::span<const uint8_t>(em), len);
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(len);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Checks and strips PKCS#1 v1.5 padding the way it is usually written by hand: a
+// subtle::ct_eq and a subtle::ct_select per byte to locate the separator
+void
+select_scan_pkcs1_v15_unpad(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto em = pkcs1_block(n);
+
+  for (auto _iter : state) {
+    uint32_t found = 0;
+    size_t sep = 0;
+    for (size_t i = 2; i < n; i++) {
+      const uint32_t first = ~found & subtle::ct_eq<uint8_t, uint32_t>(em[i], 0x00);
+      sep = subtle::ct_select(first, i, sep);
+      found |= first;
+    }
+
+    const uint32_t valid = subtle::ct_is_zero<uint8_t, uint32_t>(em[0]) & subtle::ct_eq<uint8_t, uint32_t>(em[1], 0x02) & found &
+                           subtle::ct_ge<size_t, uint32_t>(sep, 10);
+    const size_t len = subtle::ct_select(valid, n - sep - 1, size_t{ 0 });
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(len);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+// Checks and strips the PKCS#7 padding of a block using subtle::ct_pkcs7_unpad
+void
+ct_pkcs7_unpad(benchmark::State& state)
+{
+  const auto n = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint8_t> block(n);
+  std::ranges::generate(block, [&] { return static_cast<uint8_t>(gen()); });
+  const size_t p = 1 + gen() % std::min<size_t>(n, 255);
+  std::ranges::fill(std::span(block).last(p), static_cast<uint8_t>(p));
+
+  for (auto _iter : state) {
+    size_t len = 0;
+    const auto valid = subtle::ct_pkcs7_unpad<uint32_t>(std::span<const uint8_t>(block), len);
+
+    benchmark::DoNotOptimize(valid);
+    benchmark::DoNotOptimize(len);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_pkcs1_v15_unpad)->Name("ct_pkcs1_v15_unpad")->Arg(256)->Arg(512)->Apply(apply_stats);
+BENCHMARK(select_scan_pkcs1_v15_unpad)->Name("select_scan_pkcs1_v15_unpad")->Arg(256)->Arg(512)->Apply(apply_stats);
+BENCHMARK(ct_pkcs7_unpad)->Name("ct_pkcs7_unpad")->Arg(16)->Arg(256)->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
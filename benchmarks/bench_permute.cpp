@@ -0,0 +1,116 @@
+#include "bench_helper.hpp"
+#include "subtle/ct_permute.hpp"
+#include <numeric>
+#include <random>
+#include <span>
+
+namespace {
+
+// Computes the Beneš network control bits of a random permutation of N elements
+template<size_t N>
+void
+ct_benes_control_bits(benchmark::State& state)
+{
+  constexpr size_t CONTROL_BYTES = subtle::ct_benes_control_bytes(N);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint16_t> pi(N);
+  std::iota(pi.begin(), pi.end(), uint16_t{ 0 });
+  std::ranges::shuffle(pi, gen);
+
+  std::vector<uint8_t> control(CONTROL_BYTES);
+  std::vector<uint32_t> scratch(2 * N);
+
+  for (auto _iter : state) {
+    subtle::ct_benes_control_bits<uint16_t, N>(std::span<const uint16_t, N>(pi.data(), N),
+                                               std::span<uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES),
+                                               std::span<uint32_t, 2 * N>(scratch.data(), 2 * N));
+
+    benchmark::DoNotOptimize(control.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N));
+}
+
+// Applies the Beneš network of a random permutation to N elements of type T using subtle::ct_permute
+template<typename T, size_t N>
+void
+ct_permute(benchmark::State& state)
+{
+  constexpr size_t CONTROL_BYTES = subtle::ct_benes_control_bytes(N);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint16_t> pi(N);
+  std::iota(pi.begin(), pi.end(), uint16_t{ 0 });
+  std::ranges::shuffle(pi, gen);
+
+  std::vector<uint8_t> control(CONTROL_BYTES);
+  std::vector<uint32_t> scratch(2 * N);
+  subtle::ct_benes_control_bits<uint16_t, N>(std::span<const uint16_t, N>(pi.data(), N),
+                                             std::span<uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES),
+                                             std::span<uint32_t, 2 * N>(scratch.data(), 2 * N));
+
+  std::vector<T> vals(N);
+  std::ranges::generate(vals, [&] { return static_cast<T>(gen()); });
+
+  for (auto _iter : state) {
+    subtle::ct_permute(std::span<T, N>(vals.data(), N), std::span<const uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES));
+
+    benchmark::DoNotOptimize(vals.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * sizeof(T)));
+}
+
+// Applies the Beneš network of a random permutation to a packed bit vector of N bits using subtle::ct_permute_bits
+template<size_t N>
+void
+ct_permute_bits(benchmark::State& state)
+{
+  constexpr size_t WORDS = N / 64;
+  constexpr size_t CONTROL_BYTES = subtle::ct_benes_control_bytes(N);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::vector<uint16_t> pi(N);
+  std::iota(pi.begin(), pi.end(), uint16_t{ 0 });
+  std::ranges::shuffle(pi, gen);
+
+  std::vector<uint8_t> control(CONTROL_BYTES);
+  std::vector<uint32_t> scratch(2 * N);
+  subtle::ct_benes_control_bits<uint16_t, N>(std::span<const uint16_t, N>(pi.data(), N),
+                                             std::span<uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES),
+                                             std::span<uint32_t, 2 * N>(scratch.data(), 2 * N));
+
+  std::vector<uint64_t> bits(WORDS);
+  std::ranges::generate(bits, [&] { return gen(); });
+
+  for (auto _iter : state) {
+    subtle::ct_permute_bits(std::span<uint64_t, WORDS>(bits.data(), WORDS), std::span<const uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES));
+
+    benchmark::DoNotOptimize(bits.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N / 8));
+}
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_benes_control_bits<1024>)->Name("ct_benes_control_bits/1024")->Apply(apply_stats);
+BENCHMARK(ct_benes_control_bits<8192>)->Name("ct_benes_control_bits/8192")->Apply(apply_stats);
+BENCHMARK_TEMPLATE(ct_permute, uint16_t, 1024)->Name("ct_permute_u16/1024")->Apply(apply_stats);
+BENCHMARK_TEMPLATE(ct_permute, uint16_t, 8192)->Name("ct_permute_u16/8192")->Apply(apply_stats);
+BENCHMARK_TEMPLATE(ct_permute, uint32_t, 1024)->Name("ct_permute_u32/1024")->Apply(apply_stats);
+BENCHMARK_TEMPLATE(ct_permute, uint32_t, 8192)->Name("ct_permute_u32/8192")->Apply(apply_stats);
+BENCHMARK(ct_permute_bits<1024>)->Name("ct_permute_bits/1024")->Apply(apply_stats);
+BENCHMARK(ct_permute_bits<8192>)->Name("ct_permute_bits/8192")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
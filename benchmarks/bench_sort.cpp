@@ -0,0 +1,233 @@
+#include "bench_helper.hpp"
+#include "subtle/ct_sort.hpp"
+#include <algorithm>
+#include <random>
+#include <span>
+
+namespace {
+
+// Sorts a random buffer of int32_t with the constant-time sorting network subtle::ct_sort.
+// The buffer is refilled from the same random input before every run -- that copy is
+// part of the measured time, for both this and the std::sort baseline.
+void
+ct_sort_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+
+  std::vector<int32_t> input(len);
+  std::ranges::generate(input, [&] { return dis(gen); });
+  std::vector<int32_t> buf(len);
+
+  for (auto _iter : state) {
+    std::ranges::copy(input, buf.begin());
+    subtle::ct_sort(std::span(buf));
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+// Sorts a random buffer of int32_t with std::sort -- data-dependent, for reference
+void
+std_sort_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+
+  std::vector<int32_t> input(len);
+  std::ranges::generate(input, [&] { return dis(gen); });
+  std::vector<int32_t> buf(len);
+
+  for (auto _iter : state) {
+    std::ranges::copy(input, buf.begin());
+    std::sort(buf.begin(), buf.end());
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+// Shuffles a buffer of int32_t with subtle::ct_shuffle, consuming one random word per element.
+// Drawing the random words is part of the measured time.
+void
+ct_shuffle_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+
+  std::vector<int32_t> buf(len);
+  std::ranges::generate(buf, [&] { return dis(gen); });
+  std::vector<uint64_t> random_words(len);
+
+  for (auto _iter : state) {
+    std::ranges::generate(random_words, [&] { return gen(); });
+    const auto distinct = subtle::ct_shuffle<int32_t, uint32_t>(std::span(buf), std::span(random_words));
+
+    benchmark::DoNotOptimize(distinct);
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+// Shuffles a buffer of int32_t with std::shuffle -- a Fisher-Yates shuffle, indexing memory with
+// the random values, for reference
+void
+std_shuffle_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+
+  std::vector<int32_t> buf(len);
+  std::ranges::generate(buf, [&] { return dis(gen); });
+
+  for (auto _iter : state) {
+    std::ranges::shuffle(buf, gen);
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+// Compacts a buffer of int32_t, keeping about half of the elements, with subtle::ct_compact.
+// The buffer is refilled from the same random input before every run, for all three
+// compaction benchmarks.
+void
+ct_compact_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+  std::bernoulli_distribution keep_dis(0.5);
+
+  std::vector<int32_t> input(len);
+  std::ranges::generate(input, [&] { return dis(gen); });
+  std::vector<uint32_t> keep_masks(len);
+  std::ranges::generate(keep_masks, [&] { return keep_dis(gen) ? 0xffffffffU : 0U; });
+
+  std::vector<int32_t> buf(len);
+  std::vector<uint32_t> scratch(len);
+
+  for (auto _iter : state) {
+    std::ranges::copy(input, buf.begin());
+    const size_t count = subtle::ct_compact(std::span(buf), std::span<const uint32_t>(keep_masks), std::span(scratch));
+
+    benchmark::DoNotOptimize(count);
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+// Compacts a buffer of int32_t by sorting: each element is tagged with its keep bit ( inverted,
+// on top ) and index, the 64-bit words are sorted with subtle::ct_sort and the values are taken
+// from the low halves -- the sorting-based oblivious compaction, for comparison.
+void
+ct_sort_compact_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+  std::bernoulli_distribution keep_dis(0.5);
+
+  std::vector<int32_t> input(len);
+  std::ranges::generate(input, [&] { return dis(gen); });
+  std::vector<uint32_t> keep_masks(len);
+  std::ranges::generate(keep_masks, [&] { return keep_dis(gen) ? 0xffffffffU : 0U; });
+
+  std::vector<int32_t> buf(len);
+  std::vector<uint64_t> tagged(len);
+
+  for (auto _iter : state) {
+    std::ranges::copy(input, buf.begin());
+
+    for (size_t i = 0; i < len; i++) {
+      const uint64_t drop = static_cast<uint64_t>(~keep_masks[i] & 1U) << 63;
+      tagged[i] = drop | (static_cast<uint64_t>(i) << 32) | static_cast<uint32_t>(buf[i]);
+    }
+
+    subtle::ct_sort(std::span(tagged));
+
+    for (size_t i = 0; i < len; i++) {
+      const uint64_t kept = (tagged[i] >> 63) - 1U;
+      buf[i] = static_cast<int32_t>(static_cast<uint32_t>(tagged[i] & kept));
+    }
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+// Compacts a buffer of int32_t with std::ranges::stable_partition -- data-dependent, for reference
+void
+std_partition_i32(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis;
+  std::bernoulli_distribution keep_dis(0.5);
+
+  std::vector<std::pair<int32_t, bool>> input(len);
+  std::ranges::generate(input, [&] { return std::make_pair(dis(gen), keep_dis(gen)); });
+  std::vector<std::pair<int32_t, bool>> buf(len);
+
+  for (auto _iter : state) {
+    std::ranges::copy(input, buf.begin());
+    auto dropped = std::ranges::stable_partition(buf, [](const auto& elem) { return elem.second; });
+
+    benchmark::DoNotOptimize(dropped);
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len * sizeof(int32_t)));
+}
+
+void
+apply_sort_sizes(::benchmark::Benchmark* bench)
+{
+  for (int64_t size : { 1L << 6, 1L << 10, 1L << 14, 1L << 20 }) {
+    bench->Arg(size);
+  }
+
+  bench->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+}
+
+}
+
+BENCHMARK(ct_sort_i32)->Name("ct_sort_i32")->Apply(apply_sort_sizes);                 // NOLINT(cert-err58-cpp)
+BENCHMARK(std_sort_i32)->Name("std_sort_i32")->Apply(apply_sort_sizes);               // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_shuffle_i32)->Name("ct_shuffle_i32")->Apply(apply_sort_sizes);           // NOLINT(cert-err58-cpp)
+BENCHMARK(std_shuffle_i32)->Name("std_shuffle_i32")->Apply(apply_sort_sizes);         // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_compact_i32)->Name("ct_compact_i32")->Apply(apply_sort_sizes);           // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_sort_compact_i32)->Name("ct_sort_compact_i32")->Apply(apply_sort_sizes); // NOLINT(cert-err58-cpp)
+BENCHMARK(std_partition_i32)->Name("std_partition_i32")->Apply(apply_sort_sizes);     // NOLINT(cert-err58-cpp)
@@ -0,0 +1,109 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_table.hpp"
+#include <memory>
+#include <random>
+#include <span>
+
+namespace {
+
+// Constant-time secret-index lookup into a plain table, using subtle::ct_lookup
+template<size_t N>
+void
+ct_lookup_span(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis;
+
+  std::vector<uint32_t> table(N);
+  std::ranges::generate(table, [&] { return dis(gen); });
+
+  uint32_t idx = dis(gen) % N;
+  for (auto _iter : state) {
+    const uint32_t result = subtle::ct_lookup<uint32_t, uint32_t>(idx, std::span<const uint32_t>(table));
+    idx = (idx + result) % N;
+
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * sizeof(uint32_t)));
+}
+
+// Constant-time secret-index lookup into a cache-line-blocked subtle::ct_table
+template<size_t N>
+void
+ct_table_lookup(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis;
+
+  std::vector<uint32_t> entries(N);
+  std::ranges::generate(entries, [&] { return dis(gen); });
+
+  const auto table = std::make_unique<subtle::ct_table<uint32_t, N>>(std::span<const uint32_t, N>(entries.data(), N));
+
+  uint32_t idx = dis(gen) % N;
+  for (auto _iter : state) {
+    const uint32_t result = table->template lookup<uint32_t>(idx);
+    idx = (idx + result) % N;
+
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * sizeof(uint32_t)));
+}
+
+// Constant-time secret-index store into a cache-line-blocked subtle::ct_table
+template<size_t N>
+void
+ct_table_store(benchmark::State& state)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis;
+
+  std::vector<uint32_t> entries(N);
+  std::ranges::generate(entries, [&] { return dis(gen); });
+
+  const auto table = std::make_unique<subtle::ct_table<uint32_t, N>>(std::span<const uint32_t, N>(entries.data(), N));
+
+  uint32_t idx = dis(gen) % N;
+  for (auto _iter : state) {
+    table->template store<uint32_t>(idx, idx);
+    idx = (idx * 5 + 1) % N;
+
+    benchmark::DoNotOptimize(table.get());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * sizeof(uint32_t)));
+}
+
+// Table sizes, in uint32_t entries: 1 KiB, 4 KiB, 16 KiB and 64 KiB.
+constexpr size_t TABLE_1K = 256;
+constexpr size_t TABLE_4K = 1024;
+constexpr size_t TABLE_16K = 4096;
+constexpr size_t TABLE_64K = 16384;
+
+}
+
+// NOLINTBEGIN(cert-err58-cpp)
+BENCHMARK(ct_lookup_span<TABLE_1K>)->Name("ct_lookup_span/1KiB")->Apply(apply_stats);
+BENCHMARK(ct_lookup_span<TABLE_4K>)->Name("ct_lookup_span/4KiB")->Apply(apply_stats);
+BENCHMARK(ct_lookup_span<TABLE_16K>)->Name("ct_lookup_span/16KiB")->Apply(apply_stats);
+BENCHMARK(ct_lookup_span<TABLE_64K>)->Name("ct_lookup_span/64KiB")->Apply(apply_stats);
+
+BENCHMARK(ct_table_lookup<TABLE_1K>)->Name("ct_table_lookup/1KiB")->Apply(apply_stats);
+BENCHMARK(ct_table_lookup<TABLE_4K>)->Name("ct_table_lookup/4KiB")->Apply(apply_stats);
+BENCHMARK(ct_table_lookup<TABLE_16K>)->Name("ct_table_lookup/16KiB")->Apply(apply_stats);
+BENCHMARK(ct_table_lookup<TABLE_64K>)->Name("ct_table_lookup/64KiB")->Apply(apply_stats);
+
+BENCHMARK(ct_table_store<TABLE_1K>)->Name("ct_table_store/1KiB")->Apply(apply_stats);
+BENCHMARK(ct_table_store<TABLE_4K>)->Name("ct_table_store/4KiB")->Apply(apply_stats);
+BENCHMARK(ct_table_store<TABLE_16K>)->Name("ct_table_store/16KiB")->Apply(apply_stats);
+BENCHMARK(ct_table_store<TABLE_64K>)->Name("ct_table_store/64KiB")->Apply(apply_stats);
+// NOLINTEND(cert-err58-cpp)
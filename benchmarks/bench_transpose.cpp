@@ -0,0 +1,130 @@
+#include "bench_helper.hpp"
+#include "subtle.hpp"
+#include "subtle/ct_bitslice.hpp"
+#include <random>
+#include <span>
+
+namespace {
+
+// Transposes every 8x8 bit-matrix ( 8 bytes ) of a buffer using subtle::ct_transpose8x8
+void
+ct_transpose8x8(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint64_t> dis;
+
+  std::vector<uint64_t> buf(len / sizeof(uint64_t));
+  std::ranges::generate(buf, [&] { return dis(gen); });
+
+  for (auto _iter : state) {
+    for (auto& word : buf) {
+      word = subtle::ct_transpose8x8(word);
+    }
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
+// Transposes every 32x32 bit-matrix ( 128 bytes ) of a buffer using subtle::ct_transpose32x32
+void
+ct_transpose32x32(benchmark::State& state)
+{
+  constexpr size_t ROWS = 32;
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis;
+
+  std::vector<uint32_t> buf(len / sizeof(uint32_t));
+  std::ranges::generate(buf, [&] { return dis(gen); });
+
+  for (auto _iter : state) {
+    for (size_t off = 0; off + ROWS <= buf.size(); off += ROWS) {
+      subtle::ct_transpose32x32(std::span<uint32_t, ROWS>(buf.data() + off, ROWS));
+    }
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
+// Transposes every 64x64 bit-matrix ( 512 bytes ) of a buffer using subtle::ct_transpose64x64
+void
+ct_transpose64x64(benchmark::State& state)
+{
+  constexpr size_t ROWS = 64;
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint64_t> dis;
+
+  std::vector<uint64_t> buf(len / sizeof(uint64_t));
+  std::ranges::generate(buf, [&] { return dis(gen); });
+
+  for (auto _iter : state) {
+    for (size_t off = 0; off + ROWS <= buf.size(); off += ROWS) {
+      subtle::ct_transpose64x64(std::span<uint64_t, ROWS>(buf.data() + off, ROWS));
+    }
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
+// Transposes every 64-byte batch of a buffer into 8 bit-planes using subtle::ct_bitslice_bytes
+void
+ct_bitslice_bytes(benchmark::State& state)
+{
+  const auto len = static_cast<size_t>(state.range(0));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint8_t> dis;
+
+  std::vector<uint8_t> buf(len);
+  std::ranges::generate(buf, [&] { return dis(gen); });
+
+  std::array<uint64_t, subtle::CT_BITSLICE_PLANES> planes{};
+  uint64_t acc = 0;
+
+  for (auto _iter : state) {
+    for (size_t off = 0; off + subtle::CT_BITSLICE_LANES <= len; off += subtle::CT_BITSLICE_LANES) {
+      subtle::ct_bitslice_bytes(std::span<const uint8_t, subtle::CT_BITSLICE_LANES>(buf.data() + off, subtle::CT_BITSLICE_LANES), planes);
+      acc ^= planes[0] ^ planes[7];
+    }
+
+    benchmark::DoNotOptimize(acc);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(len));
+}
+
+void
+apply_transpose_sizes(::benchmark::Benchmark* bench)
+{
+  for (int64_t size : { 1L << 10, 1L << 15, 1L << 20 }) {
+    bench->Arg(size);
+  }
+
+  bench->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+}
+
+}
+
+BENCHMARK(ct_transpose8x8)->Name("ct_transpose8x8")->Apply(apply_transpose_sizes);     // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_transpose32x32)->Name("ct_transpose32x32")->Apply(apply_transpose_sizes); // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_transpose64x64)->Name("ct_transpose64x64")->Apply(apply_transpose_sizes); // NOLINT(cert-err58-cpp)
+BENCHMARK(ct_bitslice_bytes)->Name("ct_bitslice_bytes")->Apply(apply_transpose_sizes); // NOLINT(cert-err58-cpp)
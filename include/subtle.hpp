@@ -1,11 +1,14 @@
 #pragma once
 #include "forceinline.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <span>
 #include <type_traits>
+#include <utility>
 
 // MSan detection: the "+r" asm constraint reads the value, which triggers
 // false positives on poisoned (secret) inputs. MSan operates at LLVM IR
@@ -16,6 +19,15 @@
 #endif
 #endif
 
+// AVX2 detection: span routines built on top of the scalar primitives may carry
+// an AVX2 kernel, used at runtime ( never during constant evaluation ) when the
+// translation unit itself is compiled for AVX2, e.g. with -mavx2 or -march=native.
+// There is no runtime CPU dispatch -- without AVX2 the portable code path is used.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SUBTLE_AVX2_ACTIVE_
+#endif
+
 // Constant-time operations on integer values.
 namespace subtle {
 
@@ -306,6 +318,610 @@ ct_max(const operandT x, const operandT y)
   return ct_select(ct_le<operandT, uint32_t>(x, y), y, x);
 }
 
+// Given two integers x, y of type operandT, this routine compare-exchanges them:
+// afterwards x holds ct_min(x, y) and y holds ct_max(x, y). It is the building block
+// of sorting networks, computing one ordering mask and swapping on it via ct_swap.
+template<typename operandT>
+forceinline constexpr void
+ct_minmax(operandT& x, operandT& y)
+  requires(ct_operand<operandT>)
+{
+  ct_swap(ct_gt<operandT, uint32_t>(x, y), x, y);
+}
+
+// Given a signed integer x of type operandT, this routine returns its absolute value,
+// negating x through a mask built from its sign bit. The minimum value has no positive
+// counterpart and maps to itself -- read as the unsigned type, it is still the right
+// magnitude.
+template<typename operandT>
+forceinline constexpr operandT
+ct_abs(const operandT x)
+  requires(ct_operand<operandT> && std::is_signed_v<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  Uop mask = static_cast<Uop>(0U - static_cast<Uop>(static_cast<Uop>(x) >> (std::numeric_limits<Uop>::digits - 1)));
+  ct_barrier(mask);
+
+  return static_cast<operandT>(static_cast<Uop>(static_cast<Uop>(x) ^ mask) - mask);
+}
+
+// Given an integer x of type operandT, this routine returns its sign: -1 if x is
+// negative, 0 if x is zero, 1 if x is positive ( so 0 or 1 for unsigned operandT ).
+template<typename operandT>
+forceinline constexpr operandT
+ct_sign(const operandT x)
+  requires(ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr size_t W = std::numeric_limits<Uop>::digits;
+
+  const auto xu = static_cast<Uop>(x);
+  const auto nonzero = static_cast<Uop>(static_cast<Uop>(xu | static_cast<Uop>(0U - xu)) >> (W - 1));
+
+  if constexpr (std::is_signed_v<operandT>) {
+    const auto negative = static_cast<Uop>(0U - static_cast<Uop>(xu >> (W - 1)));
+    return static_cast<operandT>(negative | nonzero);
+  } else {
+    return static_cast<operandT>(nonzero);
+  }
+}
+
+// Given a branch value br ( of type branchT ) holding either truth or false value and
+// an integer x of type operandT, this routine returns -x if br is truth value, else x.
+// Like ct_select, it only looks at the most significant bit of br. Negation wraps
+// around: the minimum of a signed type maps to itself, unsigned x maps to 2^W - x.
+template<typename branchT, typename operandT>
+forceinline constexpr operandT
+ct_cneg(const branchT br, const operandT x)
+  requires(std::is_unsigned_v<branchT> && ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  Uop mask = static_cast<Uop>(0U - static_cast<Uop>(br >> (std::numeric_limits<branchT>::digits - 1)));
+  ct_barrier(mask);
+
+  return static_cast<operandT>(static_cast<Uop>(static_cast<Uop>(x) ^ mask) - mask);
+}
+
+// Given an integer x of type operandT and public bounds lo <= hi, this routine
+// returns x clamped to [lo, hi] -- equivalent to std::clamp(x, lo, hi).
+template<typename operandT>
+forceinline constexpr operandT
+ct_clamp(const operandT x, const operandT lo, const operandT hi)
+  requires(ct_operand<operandT>)
+{
+  return ct_min(ct_max(x, lo), hi);
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Broadcasts the integer v of type operandT to every lane of an AVX2 register.
+template<typename operandT>
+forceinline __m256i
+ct_broadcast_avx2(const operandT v)
+  requires(ct_operand<operandT>)
+{
+  if constexpr (sizeof(operandT) == 1) {
+    return _mm256_set1_epi8(static_cast<char>(v));
+  } else if constexpr (sizeof(operandT) == 2) {
+    return _mm256_set1_epi16(static_cast<int16_t>(v));
+  } else if constexpr (sizeof(operandT) == 4) {
+    return _mm256_set1_epi32(static_cast<int32_t>(v));
+  } else {
+    return _mm256_set1_epi64x(static_cast<int64_t>(v));
+  }
+}
+
+// Lane-wise wrapping subtraction a - b of two AVX2 registers holding integers of type operandT.
+template<typename operandT>
+forceinline __m256i
+ct_sub_avx2(const __m256i a, const __m256i b)
+  requires(ct_operand<operandT>)
+{
+  if constexpr (sizeof(operandT) == 1) {
+    return _mm256_sub_epi8(a, b);
+  } else if constexpr (sizeof(operandT) == 2) {
+    return _mm256_sub_epi16(a, b);
+  } else if constexpr (sizeof(operandT) == 4) {
+    return _mm256_sub_epi32(a, b);
+  } else {
+    return _mm256_sub_epi64(a, b);
+  }
+}
+
+// Lane-wise equality of two AVX2 registers holding integers of type operandT: all bits
+// of a lane set where a == b, all bits zero elsewhere.
+template<typename operandT>
+forceinline __m256i
+ct_eq_avx2(const __m256i a, const __m256i b)
+  requires(ct_operand<operandT>)
+{
+  if constexpr (sizeof(operandT) == 1) {
+    return _mm256_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(operandT) == 2) {
+    return _mm256_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(operandT) == 4) {
+    return _mm256_cmpeq_epi32(a, b);
+  } else {
+    return _mm256_cmpeq_epi64(a, b);
+  }
+}
+
+// Lane-wise signed greater-than of two AVX2 registers: all bits of a lane set where
+// a > b, all bits zero elsewhere. Unsigned lanes have their sign bit flipped first, so
+// that the signed comparison orders them as unsigned integers.
+template<typename operandT>
+forceinline __m256i
+ct_gt_avx2(const __m256i a, const __m256i b)
+  requires(ct_operand<operandT>)
+{
+  using Sop = std::make_signed_t<operandT>;
+
+  __m256i x = a;
+  __m256i y = b;
+  if constexpr (std::is_unsigned_v<operandT>) {
+    const __m256i flip = ct_broadcast_avx2<Sop>(std::numeric_limits<Sop>::min());
+    x = _mm256_xor_si256(x, flip);
+    y = _mm256_xor_si256(y, flip);
+  }
+
+  if constexpr (sizeof(operandT) == 1) {
+    return _mm256_cmpgt_epi8(x, y);
+  } else if constexpr (sizeof(operandT) == 2) {
+    return _mm256_cmpgt_epi16(x, y);
+  } else if constexpr (sizeof(operandT) == 4) {
+    return _mm256_cmpgt_epi32(x, y);
+  } else {
+    return _mm256_cmpgt_epi64(x, y);
+  }
+}
+
+// Lane-wise compare-exchange of two AVX2 registers holding integers of any width:
+// afterwards a holds the minima and b the maxima. For 8, 16 and 32-bit lanes these are
+// vpmin / vpmax; AVX2 has no 64-bit min / max, so 64-bit lanes compare with vpcmpgtq
+// ( unsigned lanes having their sign bit flipped first ) and select with vpblendvb.
+// All of them are fixed-latency instructions, free of any data-dependent behaviour.
+template<typename operandT>
+forceinline void
+ct_minmax_avx2(__m256i& a, __m256i& b)
+  requires(ct_operand<operandT>)
+{
+  const __m256i x = a;
+  const __m256i y = b;
+
+  if constexpr (sizeof(operandT) == 1) {
+    a = std::is_signed_v<operandT> ? _mm256_min_epi8(x, y) : _mm256_min_epu8(x, y);
+    b = std::is_signed_v<operandT> ? _mm256_max_epi8(x, y) : _mm256_max_epu8(x, y);
+  } else if constexpr (sizeof(operandT) == 2) {
+    a = std::is_signed_v<operandT> ? _mm256_min_epi16(x, y) : _mm256_min_epu16(x, y);
+    b = std::is_signed_v<operandT> ? _mm256_max_epi16(x, y) : _mm256_max_epu16(x, y);
+  } else if constexpr (sizeof(operandT) == 4) {
+    a = std::is_signed_v<operandT> ? _mm256_min_epi32(x, y) : _mm256_min_epu32(x, y);
+    b = std::is_signed_v<operandT> ? _mm256_max_epi32(x, y) : _mm256_max_epu32(x, y);
+  } else {
+    const __m256i flip = _mm256_set1_epi64x(std::is_signed_v<operandT> ? 0 : std::numeric_limits<int64_t>::min());
+    const __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(x, flip), _mm256_xor_si256(y, flip));
+
+    a = _mm256_blendv_epi8(x, y, gt);
+    b = _mm256_blendv_epi8(y, x, gt);
+  }
+}
+
+// Folds the lanes of an AVX2 register holding integers of type operandT with the
+// lane-wise operation op, in log2( lanes ) steps: op with the register's 128-bit halves
+// swapped, then with its 128-bit lanes rotated by 8, 4, 2 and 1 bytes, down to the
+// operand width. Returns the value every lane ends up holding.
+template<typename operandT, typename avx2Op>
+forceinline operandT
+ct_hreduce_avx2(__m256i v, avx2Op op)
+  requires(ct_operand<operandT>)
+{
+  v = op(v, _mm256_permute4x64_epi64(v, 0x4e));
+  v = op(v, _mm256_alignr_epi8(v, v, 8));
+  if constexpr (sizeof(operandT) <= 4) {
+    v = op(v, _mm256_alignr_epi8(v, v, 4));
+  }
+  if constexpr (sizeof(operandT) <= 2) {
+    v = op(v, _mm256_alignr_epi8(v, v, 2));
+  }
+  if constexpr (sizeof(operandT) == 1) {
+    v = op(v, _mm256_alignr_epi8(v, v, 1));
+  }
+
+  return static_cast<operandT>(_mm_cvtsi128_si64(_mm256_castsi256_si128(v)));
+}
+
+// Given a signed count rem, this routine returns a register whose first k lanes of
+// operandT width are all ones and the rest zero, k being rem clamped to [0, lanes] --
+// a byte-wise compare of k against an iota vector, whose byte b holds the index of its
+// lane. The clamp is done with sign masks, so that a running count can be passed as is.
+template<typename operandT>
+forceinline __m256i
+ct_prefix_mask_avx2(const int64_t rem)
+  requires(ct_operand<operandT>)
+{
+  constexpr auto lanes = static_cast<int64_t>(sizeof(__m256i) / sizeof(operandT));
+
+  static constexpr auto iota = []() {
+    std::array<int8_t, sizeof(__m256i)> lane_of{};
+    for (size_t b = 0; b < lane_of.size(); b++) {
+      lane_of[b] = static_cast<int8_t>(b / sizeof(operandT));
+    }
+    return lane_of;
+  }();
+
+  int64_t k = rem & ~(rem >> 63);
+  k = lanes + ((k - lanes) & ((k - lanes) >> 63));
+
+  const __m256i lane_idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iota.data())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(k)), lane_idx);
+}
+
+#endif
+
+// Given a span vals of integers, this routine replaces every element x by scalar_op( x )
+// -- with AVX2, a register's worth of elements at a time, by avx2_op, which must compute
+// the same function lane-wise. For a fixed extent of at most 32 registers, such as a
+// 256-coefficient polynomial, the kernel is unrolled completely, with no scalar tail.
+template<typename operandT, size_t N, typename scalarOp, typename avx2Op>
+forceinline constexpr void
+ct_map_span(std::span<operandT, N> vals, scalarOp scalar_op, [[maybe_unused]] avx2Op avx2_op)
+  requires(ct_operand<operandT>)
+{
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+  if (!std::is_constant_evaluated()) {
+    const auto step = [&](const size_t off) {
+      auto* ptr = reinterpret_cast<__m256i*>(vals.data() + off); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm256_storeu_si256(ptr, avx2_op(_mm256_loadu_si256(ptr)));
+    };
+
+    if constexpr (N != std::dynamic_extent && N % lanes == 0 && N / lanes <= 32) {
+      [&]<size_t... I>(std::index_sequence<I...>) { (step(I * lanes), ...); }(std::make_index_sequence<N / lanes>{});
+      return;
+    } else {
+      for (; i + lanes <= vals.size(); i += lanes) {
+        step(i);
+      }
+    }
+  }
+#endif
+
+  for (auto& val : vals.subspan(i)) {
+    val = scalar_op(val);
+  }
+}
+
+// Given a span vals of signed integers, this routine replaces every element by its
+// absolute value, using ct_abs -- with AVX2, by vpabsb / vpabsw / vpabsd ( 64-bit lanes
+// negate through a vpcmpgtq sign mask instead ).
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_abs(std::span<operandT, N> vals)
+  requires(ct_operand<operandT> && std::is_signed_v<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](const __m256i x) {
+    if constexpr (sizeof(operandT) == 1) {
+      return _mm256_abs_epi8(x);
+    } else if constexpr (sizeof(operandT) == 2) {
+      return _mm256_abs_epi16(x);
+    } else if constexpr (sizeof(operandT) == 4) {
+      return _mm256_abs_epi32(x);
+    } else {
+      const __m256i mask = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+      return _mm256_sub_epi64(_mm256_xor_si256(x, mask), mask);
+    }
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [](const operandT x) { return ct_abs(x); }, avx2_op);
+}
+
+// Given a span vals of integers, this routine replaces every element by its sign, using
+// ct_sign -- with AVX2, signed lanes of 8, 16 and 32 bits apply vpsignb / vpsignw /
+// vpsignd to a register of ones.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_sign(std::span<operandT, N> vals)
+  requires(ct_operand<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](const __m256i x) {
+    const __m256i one = ct_broadcast_avx2<operandT>(operandT{ 1 });
+
+    if constexpr (std::is_signed_v<operandT> && sizeof(operandT) == 1) {
+      return _mm256_sign_epi8(one, x);
+    } else if constexpr (std::is_signed_v<operandT> && sizeof(operandT) == 2) {
+      return _mm256_sign_epi16(one, x);
+    } else if constexpr (std::is_signed_v<operandT> && sizeof(operandT) == 4) {
+      return _mm256_sign_epi32(one, x);
+    } else {
+      const __m256i nonzero = _mm256_andnot_si256(ct_eq_avx2<operandT>(x, _mm256_setzero_si256()), one);
+      if constexpr (std::is_signed_v<operandT>) {
+        return _mm256_or_si256(nonzero, _mm256_cmpgt_epi64(_mm256_setzero_si256(), x));
+      } else {
+        return nonzero;
+      }
+    }
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [](const operandT x) { return ct_sign(x); }, avx2_op);
+}
+
+// Given a branch value br ( of type branchT ) holding either truth or false value and
+// a span vals of integers, this routine negates every element if br is truth value,
+// otherwise leaves them as they are, using ct_cneg.
+template<typename branchT, typename operandT, size_t N>
+forceinline constexpr void
+ct_cneg(const branchT br, std::span<operandT, N> vals)
+  requires(std::is_unsigned_v<branchT> && ct_operand<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  using Uop = std::make_unsigned_t<operandT>;
+
+  Uop mask = static_cast<Uop>(0U - static_cast<Uop>(br >> (std::numeric_limits<branchT>::digits - 1)));
+  ct_barrier(mask);
+
+  const auto avx2_op = [mask](const __m256i x) {
+    const __m256i maskv = ct_broadcast_avx2(mask);
+    return ct_sub_avx2<operandT>(_mm256_xor_si256(x, maskv), maskv);
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [br](const operandT x) { return ct_cneg(br, x); }, avx2_op);
+}
+
+// Given a span vals of integers and public bounds lo <= hi, this routine clamps every
+// element to [lo, hi], using ct_clamp -- with AVX2, by lane-wise max with lo and min
+// with hi, as in ct_minmax_avx2.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_clamp(std::span<operandT, N> vals, const operandT lo, const operandT hi)
+  requires(ct_operand<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [lo, hi](const __m256i x) {
+    __m256i lower = ct_broadcast_avx2(lo);
+    __m256i upper = ct_broadcast_avx2(hi);
+    __m256i y = x;
+
+    ct_minmax_avx2<operandT>(lower, y); // y = max( x, lo )
+    ct_minmax_avx2<operandT>(y, upper); // y = min( y, hi )
+    return y;
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [lo, hi](const operandT x) { return ct_clamp(x, lo, hi); }, avx2_op);
+}
+
+// Given a non-empty span vals of integers, this routine folds all of them together with
+// the associative, commutative and idempotent ( op( x, x ) = x ) operation computed by
+// scalar_op -- and lane-wise by avx2_op, with AVX2. The fold is tree-shaped rather than
+// serial: elements are spread over independent accumulators, a register's worth of
+// lanes each ( with AVX2 ) or 8 of them, which are combined pairwise at the end. Idempotence
+// lets every accumulator start from the first element.
+template<typename operandT, size_t N, typename scalarOp, typename avx2Op>
+forceinline constexpr operandT
+ct_reduce_span(std::span<const operandT, N> vals, scalarOp scalar_op, [[maybe_unused]] avx2Op avx2_op)
+  requires(ct_operand<operandT>)
+{
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+  if (!std::is_constant_evaluated() && vals.size() >= lanes) {
+    __m256i acc[4]; // NOLINT(*-avoid-c-arrays)
+    std::ranges::fill(acc, ct_broadcast_avx2(vals[0]));
+
+    for (; i + lanes <= vals.size(); i += lanes) {
+      const auto* ptr = reinterpret_cast<const __m256i*>(vals.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      acc[(i / lanes) % 4] = avx2_op(acc[(i / lanes) % 4], _mm256_loadu_si256(ptr));
+    }
+
+    acc[0] = avx2_op(avx2_op(acc[0], acc[1]), avx2_op(acc[2], acc[3]));
+    operandT res = ct_hreduce_avx2<operandT>(acc[0], avx2_op);
+
+    for (; i < vals.size(); i++) {
+      res = scalar_op(res, vals[i]);
+    }
+    return res;
+  }
+#endif
+
+  constexpr size_t ACCS = 8;
+
+  std::array<operandT, ACCS> acc{};
+  acc.fill(vals[0]);
+
+  for (; i < vals.size(); i++) {
+    acc[i % ACCS] = scalar_op(acc[i % ACCS], vals[i]);
+  }
+
+  for (size_t width = ACCS / 2; width > 0; width /= 2) {
+    for (size_t j = 0; j < width; j++) {
+      acc[j] = scalar_op(acc[j], acc[j + width]);
+    }
+  }
+
+  return acc[0];
+}
+
+// Given a non-empty span vals of integers, this routine returns the smallest of them --
+// equivalent to std::ranges::min(vals) -- by a tree-shaped reduction over ct_min (
+// vpmin with AVX2 ).
+template<typename operandT, size_t N>
+forceinline constexpr operandT
+ct_min(std::span<const operandT, N> vals)
+  requires(ct_operand<operandT> && (N == std::dynamic_extent || N > 0))
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](__m256i a, __m256i b) {
+    ct_minmax_avx2<operandT>(a, b);
+    return a;
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  return ct_reduce_span(vals, [](const operandT x, const operandT y) { return ct_min(x, y); }, avx2_op);
+}
+
+// Given a non-empty span vals of integers, this routine returns the largest of them --
+// equivalent to std::ranges::max(vals) -- by a tree-shaped reduction over ct_max (
+// vpmax with AVX2 ).
+template<typename operandT, size_t N>
+forceinline constexpr operandT
+ct_max(std::span<const operandT, N> vals)
+  requires(ct_operand<operandT> && (N == std::dynamic_extent || N > 0))
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](__m256i a, __m256i b) {
+    ct_minmax_avx2<operandT>(a, b);
+    return b;
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  return ct_reduce_span(vals, [](const operandT x, const operandT y) { return ct_max(x, y); }, avx2_op);
+}
+
+// Given a span vals of integers and a value target occurring in it, this routine returns
+// the index of its first occurrence, as a secret -- every element is compared, and the
+// smallest matching index kept through masks. With AVX2, 32 and 64-bit integers are
+// matched a register at a time, against a register of their indices, a non-matching lane
+// contributing the largest index representable instead; the minimum over those is the
+// answer. Spans of 2^32 or more 32-bit integers take the portable path.
+template<typename operandT, size_t N>
+forceinline constexpr size_t
+ct_index_of(std::span<const operandT, N> vals, const operandT target)
+  requires(ct_operand<operandT>)
+{
+  size_t i = 0;
+  size_t idx = std::numeric_limits<size_t>::max();
+  size_t found = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if constexpr (sizeof(operandT) >= 4) {
+    using idxT = std::conditional_t<sizeof(operandT) == 4, uint32_t, uint64_t>;
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    if (!std::is_constant_evaluated() && vals.size() >= lanes && vals.size() <= std::numeric_limits<idxT>::max()) {
+      const __m256i targetv = ct_broadcast_avx2(target);
+      const __m256i stepv = ct_broadcast_avx2(static_cast<idxT>(lanes));
+      const __m256i nonev = ct_broadcast_avx2(std::numeric_limits<idxT>::max());
+
+      __m256i idxv = sizeof(operandT) == 4 ? _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) : _mm256_setr_epi64x(0, 1, 2, 3);
+      __m256i best = nonev;
+
+      const auto min_op = [](__m256i a, __m256i b) {
+        ct_minmax_avx2<idxT>(a, b);
+        return a;
+      };
+
+      for (; i + lanes <= vals.size(); i += lanes) {
+        const auto* ptr = reinterpret_cast<const __m256i*>(vals.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const __m256i eq = ct_eq_avx2<operandT>(_mm256_loadu_si256(ptr), targetv);
+
+        best = min_op(best, _mm256_blendv_epi8(nonev, idxv, eq));
+        idxv = sizeof(operandT) == 4 ? _mm256_add_epi32(idxv, stepv) : _mm256_add_epi64(idxv, stepv);
+      }
+
+      const idxT first = ct_hreduce_avx2<idxT>(best, min_op);
+      found = ct_ne<idxT, size_t>(first, std::numeric_limits<idxT>::max());
+      idx = ct_select(found, static_cast<size_t>(first), idx);
+    }
+  }
+#endif
+
+  for (; i < vals.size(); i++) {
+    const size_t eq = ct_eq<operandT, size_t>(vals[i], target);
+    idx = ct_select(eq & ~found, i, idx);
+    found |= eq;
+  }
+
+  return idx;
+}
+
+// Given a non-empty span vals of integers, this routine returns the index of their
+// minimum, as a secret -- the first one if several elements are equal to it, just as
+// std::ranges::min_element -- via ct_min and ct_index_of.
+template<typename operandT, size_t N>
+forceinline constexpr size_t
+ct_argmin(std::span<const operandT, N> vals)
+  requires(ct_operand<operandT> && (N == std::dynamic_extent || N > 0))
+{
+  return ct_index_of(vals, ct_min(vals));
+}
+
+// Given a non-empty span vals of integers, this routine returns the index of their
+// maximum, as a secret -- the first one if several elements are equal to it, just as
+// std::ranges::max_element -- via ct_max and ct_index_of.
+template<typename operandT, size_t N>
+forceinline constexpr size_t
+ct_argmax(std::span<const operandT, N> vals)
+  requires(ct_operand<operandT> && (N == std::dynamic_extent || N > 0))
+{
+  return ct_index_of(vals, ct_max(vals));
+}
+
+// Given a span masks of truth / false values of type maskT, this routine returns truth
+// value if every one of them is truth value ( in particular, if masks is empty ),
+// otherwise false value -- a tree-shaped AND reduction.
+template<typename maskT, size_t N>
+forceinline constexpr maskT
+ct_all(std::span<const maskT, N> masks)
+  requires(std::is_unsigned_v<maskT>)
+{
+  if (masks.empty()) {
+    return std::numeric_limits<maskT>::max();
+  }
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](const __m256i a, const __m256i b) { return _mm256_and_si256(a, b); };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  return ct_reduce_span(masks, [](const maskT x, const maskT y) { return static_cast<maskT>(x & y); }, avx2_op);
+}
+
+// Given a span masks of truth / false values of type maskT, this routine returns truth
+// value if any one of them is truth value, otherwise ( in particular, if masks is empty )
+// false value -- a tree-shaped OR reduction.
+template<typename maskT, size_t N>
+forceinline constexpr maskT
+ct_any(std::span<const maskT, N> masks)
+  requires(std::is_unsigned_v<maskT>)
+{
+  if (masks.empty()) {
+    return maskT{ 0 };
+  }
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](const __m256i a, const __m256i b) { return _mm256_or_si256(a, b); };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  return ct_reduce_span(masks, [](const maskT x, const maskT y) { return static_cast<maskT>(x | y); }, avx2_op);
+}
+
 // Securely zeroizes a std::span, preventing the compiler from optimizing away the operation.
 // At compile-time: a plain fill suffices -- there is no real memory to protect.
 // At runtime: the fill is followed by a compiler barrier (empty asm with "memory" clobber)
@@ -351,7 +967,9 @@ ct_memcmp(std::span<const operandT, N> lhs, std::span<const operandT, N> rhs)
 // Memory-level analogue of ct_select: composes from ct_select element-wise, so
 // every element of dst is touched regardless of br -- neither the code path nor
 // the accessed memory addresses depend on br. Each ct_select call contains an
-// optimization barrier, keeping the branch value opaque to the compiler.
+// optimization barrier, keeping the branch value opaque to the compiler. With AVX2,
+// br is turned into a mask once, behind a single barrier, and a register's worth of
+// elements is blended at a time.
 //
 // If br takes any value other than these two, this is an undefined behaviour !
 template<typename branchT, typename operandT, size_t N>
@@ -359,8 +977,31 @@ forceinline constexpr void
 ct_conditional_memcpy(const branchT br, std::span<operandT, N> dst, std::span<const operandT, N> src)
   requires(std::is_unsigned_v<branchT> && ct_operand<operandT>)
 {
-  for (size_t i = 0; i < dst.size(); i++) {
-    dst[i] = ct_select<branchT, operandT>(br, src[i], dst[i]);
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    auto mask = static_cast<uint64_t>(0U - static_cast<uint64_t>(br >> (std::numeric_limits<branchT>::digits - 1)));
+    ct_barrier(mask);
+    const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+
+    for (; i + lanes <= dst.size(); i += lanes) {
+      const auto* ps = reinterpret_cast<const __m256i*>(src.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto* pd = reinterpret_cast<__m256i*>(dst.data() + i);             // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      const __m256i sel = _mm256_or_si256(_mm256_and_si256(vmask, _mm256_loadu_si256(ps)), _mm256_andnot_si256(vmask, _mm256_loadu_si256(pd)));
+      _mm256_storeu_si256(pd, sel);
+    }
+  }
+#endif
+
+  const auto dst_tail = dst.subspan(i);
+  const auto src_tail = src.subspan(i);
+
+  for (size_t j = 0; j < dst_tail.size(); j++) {
+    dst_tail[j] = ct_select<branchT, operandT>(br, src_tail[j], dst_tail[j]);
   }
 }
 
@@ -382,26 +1023,983 @@ ct_conditional_memset(const branchT br, std::span<operandT, N> dst, const operan
   }
 }
 
-// Given a secret index idx ( of type indexT ) and a table of integers,
-// this routine returns table[idx] without ever using idx to address
-// memory -- defeating cache-timing side channels that a plain table[idx] would expose.
+// Given two equal-length spans dst, src of integers and a secret length len ( of
+// unsigned type lenT ), this routine copies the first min( len, size ) elements of src
+// into dst, leaving the rest of dst untouched -- e.g. moving a record of secret length
+// out of a fixed-capacity buffer.
 //
-// idx is expected to be in range [0, table.size()); an out-of-range idx matches
-// no slot and yields a zero result.
-template<typename indexT, typename operandT, size_t N>
-forceinline constexpr operandT
-ct_lookup(const indexT idx, std::span<const operandT, N> table)
-  requires(std::is_unsigned_v<indexT> && ct_operand<operandT>)
+// The whole public capacity is scanned whatever len is: element i is blended under the
+// mask i < len, taken branch-free from the sign of i - len. With AVX2, a register's
+// worth of elements at a time, the mask being a compare of the count of lanes still to
+// copy -- len less the block offset -- against an iota vector.
+template<typename lenT, typename operandT, size_t N>
+forceinline constexpr void
+ct_memcpy_prefix(std::span<operandT, N> dst, std::span<const operandT, N> src, const lenT len)
+  requires(std::is_unsigned_v<lenT> && ct_operand<operandT>)
 {
-  using Umask = std::make_unsigned_t<operandT>;
+  const uint64_t n = ct_min<uint64_t>(static_cast<uint64_t>(len), dst.size());
+  size_t i = 0;
 
-  operandT result = operandT{ 0 };
-  for (size_t j = 0; j < table.size(); j++) {
-    const Umask mask = ct_eq<indexT, Umask>(static_cast<indexT>(j), idx);
-    result = ct_select<Umask, operandT>(mask, table[j], result);
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    for (; i + lanes <= dst.size(); i += lanes) {
+      const __m256i vmask = ct_prefix_mask_avx2<operandT>(static_cast<int64_t>(n) - static_cast<int64_t>(i));
+
+      const auto* ps = reinterpret_cast<const __m256i*>(src.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto* pd = reinterpret_cast<__m256i*>(dst.data() + i);             // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      const __m256i sel = _mm256_or_si256(_mm256_and_si256(vmask, _mm256_loadu_si256(ps)), _mm256_andnot_si256(vmask, _mm256_loadu_si256(pd)));
+      _mm256_storeu_si256(pd, sel);
+    }
   }
+#endif
 
-  return result;
+  const auto dst_tail = dst.subspan(i);
+  const auto src_tail = src.subspan(i);
+
+  for (size_t j = 0; j < dst_tail.size(); j++) {
+    auto mask = static_cast<uint64_t>(0U - ((static_cast<uint64_t>(i + j) - n) >> 63));
+    ct_barrier(mask);
+
+    dst_tail[j] = ct_select<uint64_t, operandT>(mask, src_tail[j], dst_tail[j]);
+  }
+}
+
+// Given two equal-length spans lhs, rhs of integers and a secret length len ( of
+// unsigned type lenT ), this routine returns truth value ( all bits of returnT set ) if
+// their first min( len, size ) elements are equal, or false value ( all bits zero )
+// otherwise -- elements past len are ignored, but still read.
+//
+// Like ct_memcpy_prefix, the full public capacity is scanned under a running prefix
+// mask: the XOR of every element pair is ANDed with it and OR-accumulated, and the
+// accumulator tested for zero once, at the end.
+template<typename operandT, typename returnT, size_t N, typename lenT>
+forceinline constexpr returnT
+ct_memcmp_prefix(std::span<const operandT, N> lhs, std::span<const operandT, N> rhs, const lenT len)
+  requires(ct_operand<operandT> && std::is_unsigned_v<returnT> && std::is_unsigned_v<lenT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  const uint64_t n = ct_min<uint64_t>(static_cast<uint64_t>(len), lhs.size());
+  uint64_t diff = 0;
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + lanes <= lhs.size(); i += lanes) {
+      const __m256i vmask = ct_prefix_mask_avx2<operandT>(static_cast<int64_t>(n) - static_cast<int64_t>(i));
+
+      const auto* pl = reinterpret_cast<const __m256i*>(lhs.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const auto* pr = reinterpret_cast<const __m256i*>(rhs.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      const __m256i x = _mm256_xor_si256(_mm256_loadu_si256(pl), _mm256_loadu_si256(pr));
+      acc = _mm256_or_si256(acc, _mm256_and_si256(vmask, x));
+    }
+
+    diff = ct_hreduce_avx2<uint64_t>(acc, [](const __m256i a, const __m256i b) { return _mm256_or_si256(a, b); });
+  }
+#endif
+
+  const auto lhs_tail = lhs.subspan(i);
+  const auto rhs_tail = rhs.subspan(i);
+
+  for (size_t j = 0; j < lhs_tail.size(); j++) {
+    auto mask = static_cast<uint64_t>(0U - ((static_cast<uint64_t>(i + j) - n) >> 63));
+    ct_barrier(mask);
+
+    diff |= mask & static_cast<Uop>(static_cast<Uop>(lhs_tail[j]) ^ static_cast<Uop>(rhs_tail[j]));
+  }
+
+  return ct_is_zero<uint64_t, returnT>(diff);
+}
+
+// Given an output span out and two input spans lhs, rhs, all of equal length, this routine
+// computes out[i] = scalar_op( lhs[i], rhs[i] ) for every i -- with AVX2, a register's
+// worth of elements at a time, by avx2_op computing the same function lane-wise, when
+// outT and inT are of equal width. out may alias lhs or rhs.
+template<typename outT, typename inT, size_t N, typename scalarOp, typename avx2Op>
+forceinline constexpr void
+ct_zip_span(std::span<outT, N> out, std::span<const inT, N> lhs, std::span<const inT, N> rhs, scalarOp scalar_op, [[maybe_unused]] avx2Op avx2_op)
+  requires(ct_operand<outT> && ct_operand<inT>)
+{
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if constexpr (sizeof(outT) == sizeof(inT)) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(inT);
+
+    if (!std::is_constant_evaluated()) {
+      for (; i + lanes <= out.size(); i += lanes) {
+        const auto* pl = reinterpret_cast<const __m256i*>(lhs.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* pr = reinterpret_cast<const __m256i*>(rhs.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* po = reinterpret_cast<__m256i*>(out.data() + i);             // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        _mm256_storeu_si256(po, avx2_op(_mm256_loadu_si256(pl), _mm256_loadu_si256(pr)));
+      }
+    }
+  }
+#endif
+
+  const auto out_tail = out.subspan(i);
+  const auto lhs_tail = lhs.subspan(i);
+  const auto rhs_tail = rhs.subspan(i);
+
+  for (size_t j = 0; j < out_tail.size(); j++) {
+    out_tail[j] = scalar_op(lhs_tail[j], rhs_tail[j]);
+  }
+}
+
+// Given two equal-length spans lhs, rhs of integers, this routine writes to the span
+// masks, of the same length, truth value where lhs[i] == rhs[i] and false value
+// elsewhere -- one mask per element, as ct_eq computes it. With AVX2, when maskT is as
+// wide as operandT, a vpcmpeq per register.
+template<typename operandT, typename maskT, size_t N>
+forceinline constexpr void
+ct_eq_each(std::span<maskT, N> masks, std::span<const operandT, N> lhs, std::span<const operandT, N> rhs)
+  requires(ct_operand<operandT> && std::is_unsigned_v<maskT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](const __m256i a, const __m256i b) { return ct_eq_avx2<operandT>(a, b); };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_zip_span(masks, lhs, rhs, [](const operandT x, const operandT y) { return ct_eq<operandT, maskT>(x, y); }, avx2_op);
+}
+
+// Given two equal-length spans lhs, rhs of integers, this routine writes to the span
+// masks, of the same length, truth value where lhs[i] < rhs[i] and false value
+// elsewhere -- one mask per element, as ct_lt computes it. With AVX2, when maskT is as
+// wide as operandT, a vpcmpgt per register ( unsigned lanes with their sign bit flipped ).
+template<typename operandT, typename maskT, size_t N>
+forceinline constexpr void
+ct_lt_each(std::span<maskT, N> masks, std::span<const operandT, N> lhs, std::span<const operandT, N> rhs)
+  requires(ct_operand<operandT> && std::is_unsigned_v<maskT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [](const __m256i a, const __m256i b) { return ct_gt_avx2<operandT>(b, a); };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_zip_span(masks, lhs, rhs, [](const operandT x, const operandT y) { return ct_lt<operandT, maskT>(x, y); }, avx2_op);
+}
+
+// Given a span masks of truth / false values and three more spans dst, x, y of integers,
+// all of equal length, this routine writes x[i] to dst[i] where masks[i] is truth value
+// and y[i] where it is false value -- one ct_select per element, without an extra copy
+// as dst may alias x or y. With AVX2, when maskT is as wide as operandT, masks blend a
+// register at a time.
+//
+// If any mask takes a value other than all bits set or all bits zero, this is an
+// undefined behaviour !
+template<typename maskT, typename operandT, size_t N>
+forceinline constexpr void
+ct_select_each(std::span<operandT, N> dst, std::span<const maskT, N> masks, std::span<const operandT, N> x, std::span<const operandT, N> y)
+  requires(std::is_unsigned_v<maskT> && ct_operand<operandT>)
+{
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if constexpr (sizeof(maskT) == sizeof(operandT)) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    if (!std::is_constant_evaluated()) {
+      for (; i + lanes <= dst.size(); i += lanes) {
+        const auto* pm = reinterpret_cast<const __m256i*>(masks.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* px = reinterpret_cast<const __m256i*>(x.data() + i);     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* py = reinterpret_cast<const __m256i*>(y.data() + i);     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* pd = reinterpret_cast<__m256i*>(dst.data() + i);               // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        const __m256i m = _mm256_loadu_si256(pm);
+        const __m256i sel = _mm256_or_si256(_mm256_and_si256(m, _mm256_loadu_si256(px)), _mm256_andnot_si256(m, _mm256_loadu_si256(py)));
+        _mm256_storeu_si256(pd, sel);
+      }
+    }
+  }
+#endif
+
+  for (; i < dst.size(); i++) {
+    dst[i] = ct_select<maskT, operandT>(masks[i], x[i], y[i]);
+  }
+}
+
+// Given an integer x, this routine returns the number of bits set in its two's complement
+// representation -- std::popcount of x reinterpreted as unsigned. Compiled for the popcnt
+// instruction ( e.g. -mpopcnt or -march=native ) that is what std::popcount lowers to;
+// otherwise the count is reduced branch-free over bit pairs, nibbles and bytes, rather
+// than through the 256-entry table some runtime libraries fall back to.
+template<typename operandT>
+forceinline constexpr size_t
+ct_popcount(const operandT x)
+  requires(ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+#if defined(__POPCNT__)
+  return static_cast<size_t>(std::popcount(static_cast<Uop>(x)));
+#else
+  auto v = static_cast<uint64_t>(static_cast<Uop>(x));
+
+  v = v - ((v >> 1) & 0x5555555555555555ULL);
+  v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+  v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+
+  // summing all eight byte counts into the most significant byte
+  return static_cast<size_t>((v * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Lane-wise popcount of the 32 bytes of v: each nibble's count is looked up by vpshufb in
+// a 16-entry table held in a register, so no secret ever addresses memory.
+forceinline __m256i
+ct_popcount_bytes_avx2(const __m256i v)
+{
+  const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+
+  const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+  const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+  return _mm256_add_epi8(lo, hi);
+}
+
+#endif
+
+// Given the length n of a sequence of integers, a function load( i ) returning its i-th
+// element and, with AVX2, a function load_avx2( i ) returning a register's worth of
+// elements starting at the i-th, this routine returns the total number of bits set.
+//
+// With AVX2 the per-byte counts of up to 31 registers are summed bytewise ( 31 * 8 < 256,
+// so no byte overflows ) before vpsadbw widens them into 64-bit lanes, following Muła,
+// Kurz and Lemire's "Faster Population Counts Using AVX2 Instructions". Without it, narrow
+// elements are packed eight, four or two to a 64-bit word first.
+template<typename operandT, typename scalarLoad, typename avx2Load>
+forceinline constexpr size_t
+ct_popcount_span(const size_t n, scalarLoad load, [[maybe_unused]] avx2Load load_avx2)
+  requires(ct_operand<operandT>)
+{
+  size_t i = 0;
+  size_t count = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+  constexpr size_t block = 31;
+
+  if (!std::is_constant_evaluated()) {
+    __m256i total = _mm256_setzero_si256();
+
+    while (i + lanes <= n) {
+      __m256i acc = _mm256_setzero_si256();
+      for (size_t j = 0; j < block && i + lanes <= n; j++, i += lanes) {
+        acc = _mm256_add_epi8(acc, ct_popcount_bytes_avx2(load_avx2(i)));
+      }
+
+      total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, _mm256_setzero_si256()));
+    }
+
+    total = _mm256_add_epi64(total, _mm256_permute4x64_epi64(total, 0x4e));
+    total = _mm256_add_epi64(total, _mm256_unpackhi_epi64(total, total));
+    count = static_cast<size_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(total)));
+  }
+#endif
+
+  // Elements narrower than 64 bits are packed into a word, counted at once
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr size_t per_word = sizeof(uint64_t) / sizeof(operandT);
+
+  const size_t words = (n - i) / per_word;
+  for (size_t w = 0; w < words; w++, i += per_word) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < per_word; j++) {
+      word |= static_cast<uint64_t>(static_cast<Uop>(load(i + j))) << (j * std::numeric_limits<Uop>::digits);
+    }
+
+    count += ct_popcount(word);
+  }
+
+  const size_t rest = n - i;
+  for (size_t j = 0; j < rest; j++) {
+    count += ct_popcount(load(i + j));
+  }
+
+  return count;
+}
+
+// Given a span vals of integers, this routine returns the number of bits set across all
+// of them, its Hamming weight -- without AVX2, one ct_popcount per element.
+template<typename operandT, size_t N>
+forceinline constexpr size_t
+ct_hamming_weight(std::span<const operandT, N> vals)
+  requires(ct_operand<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto load_avx2 = [vals](const size_t i) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  };
+#else
+  const auto load_avx2 = nullptr;
+#endif
+
+  return ct_popcount_span<operandT>(vals.size(), [vals](const size_t i) { return vals[i]; }, load_avx2);
+}
+
+// Given two equal-length spans lhs, rhs of integers, this routine returns the number of
+// bit positions in which they differ, their Hamming distance -- the Hamming weight of
+// lhs XOR rhs, computed without materializing it.
+template<typename operandT, size_t N>
+forceinline constexpr size_t
+ct_hamming_distance(std::span<const operandT, N> lhs, std::span<const operandT, N> rhs)
+  requires(ct_operand<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto load_avx2 = [lhs, rhs](const size_t i) {
+    const auto* pl = reinterpret_cast<const __m256i*>(lhs.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* pr = reinterpret_cast<const __m256i*>(rhs.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm256_xor_si256(_mm256_loadu_si256(pl), _mm256_loadu_si256(pr));
+  };
+#else
+  const auto load_avx2 = nullptr;
+#endif
+
+  return ct_popcount_span<operandT>(lhs.size(), [lhs, rhs](const size_t i) { return static_cast<operandT>(lhs[i] ^ rhs[i]); }, load_avx2);
+}
+
+// Given an integer x, this routine returns its bit length -- the position of its most
+// significant set bit plus one, or 0 for x = 0 -- as std::bit_width of x reinterpreted
+// as unsigned. Compiled for lzcnt ( e.g. -mlzcnt or -march=native ), a fixed latency
+// instruction defined at zero, that is W minus its result. Otherwise every bit below the
+// most significant one is set, by the same shift-and-OR propagation ct_le uses, and the
+// bits are counted with ct_popcount -- never bsr or __builtin_clz, which are undefined at
+// zero and lower to branches or data dependent latencies on some targets.
+template<typename operandT>
+forceinline constexpr size_t
+ct_bit_length(const operandT x)
+  requires(ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr size_t digits = std::numeric_limits<Uop>::digits;
+
+#if defined(__LZCNT__)
+  return digits - static_cast<size_t>(std::countl_zero(static_cast<Uop>(x)));
+#else
+  auto bits = static_cast<Uop>(x);
+
+  for (size_t pow = 1; pow < digits;) {
+    bits = static_cast<Uop>(bits | static_cast<Uop>(bits >> pow));
+    pow += pow;
+  }
+
+  return ct_popcount(bits);
+#endif
+}
+
+// Given an integer x, this routine returns the number of leading zero bits in its two's
+// complement representation -- W for x = 0 -- as std::countl_zero, see ct_bit_length.
+template<typename operandT>
+forceinline constexpr size_t
+ct_clz(const operandT x)
+  requires(ct_operand<operandT>)
+{
+  return static_cast<size_t>(std::numeric_limits<std::make_unsigned_t<operandT>>::digits) - ct_bit_length(x);
+}
+
+// Given an integer x, this routine returns the number of trailing zero bits in its two's
+// complement representation -- W for x = 0 -- as std::countr_zero. Compiled for tzcnt (
+// e.g. -mbmi or -march=native ) it is that instruction, of fixed latency and defined at
+// zero, otherwise ct_popcount of the mask ~x & ( x - 1 ) of those bits, which is all ones
+// for x = 0.
+template<typename operandT>
+forceinline constexpr size_t
+ct_ctz(const operandT x)
+  requires(ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  const auto u = static_cast<Uop>(x);
+
+#if defined(__BMI__)
+  return static_cast<size_t>(std::countr_zero(u));
+#else
+  return ct_popcount(static_cast<Uop>(static_cast<Uop>(~u) & static_cast<Uop>(u - 1U)));
+#endif
+}
+
+// Given a span buf of 8-bit integers, a public offset i < buf.size() and a value c, this
+// routine returns a bit mask whose bit j is set if buf[i + j] == c, for the up to 32
+// elements from i -- one vpcmpeqb / vpmovmskb pair with AVX2, eight elements to a 64-bit
+// word otherwise. ct_bit_length / ct_ctz of the mask then locate the last / first match
+// without a select per element.
+template<typename operandT, size_t N>
+forceinline constexpr uint32_t
+ct_eq_bitmask(std::span<const operandT, N> buf, const size_t i, const operandT c)
+  requires(ct_operand<operandT> && sizeof(operandT) == 1)
+{
+  const size_t m = std::min<size_t>(32, buf.size() - i);
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated() && m == 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(c)))));
+  }
+#endif
+
+  constexpr uint64_t lo7 = 0x7f7f7f7f7f7f7f7fULL;
+
+  uint32_t bits = 0;
+  size_t j = 0;
+
+  // A byte of x = word ^ c is zero exactly when the top bit of the matching byte of
+  // ~( ( ( x & lo7 ) + lo7 ) | x | lo7 ) is set -- no carry crosses a byte -- and the
+  // multiply gathers those eight bits into the top byte.
+  for (; j + 8 <= m; j += 8) {
+    const auto bytes = buf.subspan(i + j).template first<8>();
+    const auto byte = [&](const size_t b) { return static_cast<uint64_t>(static_cast<uint8_t>(bytes[b])); };
+    const uint64_t word = byte(0) | (byte(1) << 8) | (byte(2) << 16) | (byte(3) << 24) | (byte(4) << 32) | (byte(5) << 40) | (byte(6) << 48) | (byte(7) << 56);
+
+    const uint64_t x = word ^ (0x0101010101010101ULL * static_cast<uint8_t>(c));
+    const uint64_t t = ~(((x & lo7) + lo7) | x | lo7);
+    bits |= static_cast<uint32_t>(((t >> 7) * 0x0102040810204080ULL) >> 56) << j;
+  }
+
+  for (; j < m; j++) {
+    bits |= (ct_eq<operandT, uint32_t>(buf[i + j], c) & 1U) << j;
+  }
+
+  return bits;
+}
+
+// Given a span vals of integers and a value, this routine returns truth value ( all bits
+// of returnT set ) if value occurs in vals, or false value ( all bits zero ) otherwise,
+// and sets idx to the index of its first occurrence, or to vals.size() if there is none
+// -- both secret, as in finding the 0x01 separator of an OAEP-decoded block. Every
+// element is compared whatever the answer; unlike ct_index_of, value need not occur.
+//
+// A block of elements is compared at a time and the comparison reduced to a bit mask,
+// sizeof( operandT ) bits per element, whose ct_ctz locates the first match in the block;
+// a running found mask keeps only the first block matching. Bytes go 32 at a time through
+// ct_eq_bitmask, on every target; wider integers a register at a time with AVX2, one at a
+// time otherwise.
+template<typename operandT, typename returnT, size_t N>
+forceinline constexpr returnT
+ct_find_first(std::span<const operandT, N> vals, const operandT value, size_t& idx)
+  requires(ct_operand<operandT> && std::is_unsigned_v<returnT>)
+{
+  size_t i = 0;
+  size_t found = 0;
+  idx = vals.size();
+
+  // Folds in the match mask of the block starting at index from, sizeof( operandT ) bits
+  // to an element
+  const auto fold = [&](const size_t from, const uint32_t bits) {
+    const size_t hit = ~found & ~ct_is_zero<uint32_t, size_t>(bits);
+    idx = ct_select(hit, from + ct_ctz(bits) / sizeof(operandT), idx);
+    found |= hit;
+  };
+
+  if constexpr (sizeof(operandT) == 1) {
+    for (; i < vals.size(); i += 32) {
+      fold(i, ct_eq_bitmask(vals, i, value));
+    }
+  } else {
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    if (!std::is_constant_evaluated()) {
+      constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+      const __m256i valuev = ct_broadcast_avx2(value);
+
+      for (; i + lanes <= vals.size(); i += lanes) {
+        const auto* ptr = reinterpret_cast<const __m256i*>(vals.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        fold(i, static_cast<uint32_t>(_mm256_movemask_epi8(ct_eq_avx2<operandT>(_mm256_loadu_si256(ptr), valuev))));
+      }
+    }
+#endif
+
+    for (; i < vals.size(); i++) {
+      const size_t hit = ~found & ct_eq<operandT, size_t>(vals[i], value);
+      idx = ct_select(hit, i, idx);
+      found |= hit;
+    }
+  }
+
+  return static_cast<returnT>(found);
+}
+
+// Given a span vals of integers and a value, this routine returns truth value ( all bits
+// of returnT set ) if value occurs in vals, or false value ( all bits zero ) otherwise,
+// and sets idx to the index of its last occurrence, or to vals.size() if there is none --
+// both secret. As ct_find_first, with the highest set bit of each register's match mask,
+// from ct_bit_length, and later matches overriding earlier ones.
+template<typename operandT, typename returnT, size_t N>
+forceinline constexpr returnT
+ct_find_last(std::span<const operandT, N> vals, const operandT value, size_t& idx)
+  requires(ct_operand<operandT> && std::is_unsigned_v<returnT>)
+{
+  size_t i = 0;
+  size_t found = 0;
+  idx = vals.size();
+
+  const auto fold = [&](const size_t from, const uint32_t bits) {
+    const size_t hit = ~ct_is_zero<uint32_t, size_t>(bits);
+    idx = ct_select(hit, from + (ct_bit_length(bits) - 1) / sizeof(operandT), idx);
+    found |= hit;
+  };
+
+  if constexpr (sizeof(operandT) == 1) {
+    for (; i < vals.size(); i += 32) {
+      fold(i, ct_eq_bitmask(vals, i, value));
+    }
+  } else {
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    if (!std::is_constant_evaluated()) {
+      constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+      const __m256i valuev = ct_broadcast_avx2(value);
+
+      for (; i + lanes <= vals.size(); i += lanes) {
+        const auto* ptr = reinterpret_cast<const __m256i*>(vals.data() + i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        fold(i, static_cast<uint32_t>(_mm256_movemask_epi8(ct_eq_avx2<operandT>(_mm256_loadu_si256(ptr), valuev))));
+      }
+    }
+#endif
+
+    for (; i < vals.size(); i++) {
+      const size_t hit = ct_eq<operandT, size_t>(vals[i], value);
+      idx = ct_select(hit, i, idx);
+      found |= hit;
+    }
+  }
+
+  return static_cast<returnT>(found);
+}
+
+// Given a secret index idx ( of type indexT ) and a table of integers,
+// this routine returns table[idx] without ever using idx to address
+// memory -- defeating cache-timing side channels that a plain table[idx] would expose.
+//
+// idx is expected to be in range [0, table.size()); an out-of-range idx matches
+// no slot and yields a zero result.
+template<typename indexT, typename operandT, size_t N>
+forceinline constexpr operandT
+ct_lookup(const indexT idx, std::span<const operandT, N> table)
+  requires(std::is_unsigned_v<indexT> && ct_operand<operandT>)
+{
+  using Umask = std::make_unsigned_t<operandT>;
+
+  operandT result = operandT{ 0 };
+  for (size_t j = 0; j < table.size(); j++) {
+    const Umask mask = ct_eq<indexT, Umask>(static_cast<indexT>(j), idx);
+    result = ct_select<Umask, operandT>(mask, table[j], result);
+  }
+
+  return result;
+}
+
+// Given an 8x8 bit-matrix packed into x -- row j is byte j, column i is bit i of
+// that byte -- this routine returns its transpose, i.e. bit 8 * j + i of x moves to
+// bit 8 * i + j.
+//
+// Three rounds of delta swaps, each exchanging the two off-diagonal blocks of every
+// 2x2 grid of sub-blocks. It is pure data movement: nothing depends on the value of x.
+// Taken from "Hacker's Delight" ( 2nd edition ), section 7-3.
+forceinline constexpr uint64_t
+ct_transpose8x8(uint64_t x)
+{
+  uint64_t t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+  x = x ^ t ^ (t << 28);
+
+  return x;
+}
+
+// Given an 8x8 bit-matrix as 8 rows of 8 bits -- bit i of rows[j] is the entry at
+// row j, column i -- this routine transposes it in place.
+forceinline constexpr void
+ct_transpose8x8(std::span<uint8_t, 8> rows)
+{
+  uint64_t x = 0;
+  for (size_t j = 0; j < rows.size(); j++) {
+    x |= static_cast<uint64_t>(rows[j]) << (8 * j);
+  }
+
+  x = ct_transpose8x8(x);
+
+  for (size_t j = 0; j < rows.size(); j++) {
+    rows[j] = static_cast<uint8_t>(x >> (8 * j));
+  }
+}
+
+// Given a square bit-matrix of n = digits( rowT ) rows, each row being an unsigned
+// integer of n bits -- bit i of rows[j] is the entry at row j, column i -- this routine
+// transposes it in place.
+//
+// log2(n) rounds: round j swaps the upper-right and lower-left j x j blocks of every
+// 2j x 2j diagonal block, for j = n/2, ..., 1, i.e. rows k and k + j trade j-bit fields
+// through one masked delta swap. Rows k of a round are independent of each other and
+// visited in contiguous runs, which the compiler vectorizes. As for ct_transpose8x8,
+// neither control flow nor memory accesses depend on the matrix contents.
+template<typename rowT, size_t N>
+forceinline constexpr void
+ct_transpose_square(std::span<rowT, N> rows)
+  requires(std::is_unsigned_v<rowT> && (N == std::numeric_limits<rowT>::digits))
+{
+  rowT mask = static_cast<rowT>(static_cast<rowT>(~rowT{ 0 }) >> (N / 2)); // low half of the bits set
+
+  for (size_t j = N / 2; j != 0;) {
+    for (size_t base = 0; base < N; base += 2 * j) {
+      for (size_t k = base; k < base + j; k++) {
+        const rowT t = static_cast<rowT>(static_cast<rowT>(static_cast<rowT>(rows[k] >> j) ^ rows[k + j]) & mask);
+        rows[k] = static_cast<rowT>(rows[k] ^ static_cast<rowT>(t << j));
+        rows[k + j] = static_cast<rowT>(rows[k + j] ^ t);
+      }
+    }
+
+    j >>= 1;
+    mask = static_cast<rowT>(mask ^ static_cast<rowT>(mask << j));
+  }
+}
+
+// Transposes a 32x32 bit-matrix, given as 32 rows of 32 bits, in place.
+forceinline constexpr void
+ct_transpose32x32(std::span<uint32_t, 32> rows)
+{
+  ct_transpose_square<uint32_t, 32>(rows);
+}
+
+// Transposes a 64x64 bit-matrix, given as 64 rows of 64 bits, in place.
+forceinline constexpr void
+ct_transpose64x64(std::span<uint64_t, 64> rows)
+{
+  ct_transpose_square<uint64_t, 64>(rows);
+}
+
+// Given two unsigned integers a, b of type T, this routine returns the high half of
+// their full ( double-width ) product -- a single widening multiplication, or for
+// 64-bit operands without a 128-bit integer type, four 32x32-bit partial products.
+template<typename T>
+forceinline constexpr T
+ct_mulhi(const T a, const T b)
+  requires(std::is_unsigned_v<T>)
+{
+  constexpr size_t W = std::numeric_limits<T>::digits;
+
+  if constexpr (W <= 32) {
+    return static_cast<T>((static_cast<uint64_t>(a) * static_cast<uint64_t>(b)) >> W);
+  } else {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using wide_t = unsigned __int128;
+    return static_cast<T>((static_cast<wide_t>(a) * b) >> 64);
+#else
+    constexpr uint64_t half = 0xffffffffULL;
+
+    const uint64_t p0 = (a & half) * (b & half);
+    const uint64_t p1 = (a & half) * (b >> 32);
+    const uint64_t p2 = (a >> 32) * (b & half);
+    const uint64_t p3 = (a >> 32) * (b >> 32);
+
+    const uint64_t mid = (p0 >> 32) + (p1 & half) + (p2 & half);
+    return static_cast<T>(p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32));
+#endif
+  }
+}
+
+// Magic numbers for dividing any unsigned W-bit operand by the constant D, after
+// Granlund and Montgomery, "Division by Invariant Integers using Multiplication"
+// ( PLDI 1994 ), figure 4.1. With l = ceil( log2( D ) ), the multiplier
+//
+//   m = floor( 2^W * ( 2^l - D ) / D ) + 1
+//
+// fits in W bits, and for t = mulhi( m, x ), x / D = ( t + ( ( x - t ) >> sh1 ) ) >> sh2,
+// with sh1 = min( l, 1 ) and sh2 = max( l - 1, 0 ). m is found by long division, at
+// compile time.
+template<typename operandT, uint64_t D>
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+struct ct_div_magic
+{
+  static constexpr size_t l = static_cast<size_t>(std::bit_width(D - 1));
+  static constexpr size_t sh1 = std::min<size_t>(l, 1);
+  static constexpr size_t sh2 = l == 0 ? 0 : l - 1;
+
+  static constexpr operandT m = []() consteval {
+    // 2^l - D < D, so every quotient bit comes out of one conditional subtraction.
+    uint64_t rem = (l == 64 ? 0 : (uint64_t{ 1 } << l)) - D;
+    uint64_t quot = 0;
+
+    for (size_t i = 0; i < std::numeric_limits<operandT>::digits; i++) {
+      const bool carry = (rem >> 63) != 0;
+      rem <<= 1;
+      quot <<= 1;
+
+      if (carry || rem >= D) {
+        rem -= D;
+        quot |= 1;
+      }
+    }
+
+    return static_cast<operandT>(quot + 1);
+  }();
+};
+
+// Given an unsigned integer x of type operandT, this routine returns x / D, for a
+// divisor D fixed at compile time -- without ever emitting a division instruction,
+// whose latency depends on the operands on many cores ( see KyberSlash ). It is one
+// widening multiplication by the magic number of ct_div_magic, a subtraction, an
+// addition and two shifts, whatever the value of x.
+template<uint64_t D, typename operandT>
+forceinline constexpr operandT
+ct_div(const operandT x)
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+{
+  using magic = ct_div_magic<operandT, D>;
+
+  const operandT t = ct_mulhi<operandT>(magic::m, x);
+  const auto sum = static_cast<operandT>(t + static_cast<operandT>(static_cast<operandT>(x - t) >> magic::sh1));
+  return static_cast<operandT>(sum >> magic::sh2);
+}
+
+// Given an unsigned integer x of type operandT, this routine returns x % D, for a
+// divisor D fixed at compile time, as x - ( x / D ) * D on top of ct_div.
+template<uint64_t D, typename operandT>
+forceinline constexpr operandT
+ct_mod(const operandT x)
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+{
+  return static_cast<operandT>(x - static_cast<operandT>(ct_div<D, operandT>(x) * static_cast<operandT>(D)));
+}
+
+// Given an unsigned integer x of type operandT, this routine returns x / D rounded to
+// the nearest integer ( halves rounded up ), i.e. ( x + floor( D / 2 ) ) / D on top of
+// ct_div. x + floor( D / 2 ) must not overflow operandT.
+//
+// This is the rounding of Kyber's compression: compress_d( x ) = round( 2^d * x / q )
+// mod 2^d is ct_div_round<q>( x << d ) & ( 2^d - 1 ). Decompression divides by 2^d
+// only, which is a shift already.
+template<uint64_t D, typename operandT>
+forceinline constexpr operandT
+ct_div_round(const operandT x)
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+{
+  return ct_div<D, operandT>(static_cast<operandT>(x + static_cast<operandT>(D / 2)));
+}
+
+// Given a span vals of unsigned integers, this routine replaces every element by its
+// quotient by D, using ct_div.
+template<uint64_t D, typename operandT, size_t N>
+forceinline constexpr void
+ct_div(std::span<operandT, N> vals)
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+{
+  for (auto& val : vals) {
+    val = ct_div<D, operandT>(val);
+  }
+}
+
+// Given a span vals of unsigned integers, this routine replaces every element by its
+// remainder modulo D, using ct_mod.
+template<uint64_t D, typename operandT, size_t N>
+forceinline constexpr void
+ct_mod(std::span<operandT, N> vals)
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+{
+  for (auto& val : vals) {
+    val = ct_mod<D, operandT>(val);
+  }
+}
+
+// Given a span vals of unsigned integers, this routine replaces every element by its
+// quotient by D rounded to the nearest integer, using ct_div_round.
+template<uint64_t D, typename operandT, size_t N>
+forceinline constexpr void
+ct_div_round(std::span<operandT, N> vals)
+  requires(std::is_unsigned_v<operandT> && (D >= 1) && (D <= std::numeric_limits<operandT>::max()))
+{
+  for (auto& val : vals) {
+    val = ct_div_round<D, operandT>(val);
+  }
+}
+
+// Given two integers x, d of type operandT ( 32- or 64-bit ), this routine computes
+// the quotient x / d and the remainder x % d, for a secret divisor d, by restoring
+// long division: one bit of quotient per iteration, always W iterations, with the
+// conditional subtraction of every step applied through a mask. Hardware division
+// latency depends on its operands on many cores, so it can't be used on secrets.
+//
+// Signed operands are divided by magnitude, and the signs put back with masks, so
+// quot and rem truncate towards zero just like the / and % operators do ( except
+// that min / -1 wraps around to min, rather than being undefined ).
+//
+// Returns truth value if d == 0, in which case quot has all bits set and rem is x (
+// the way restoring division by zero naturally comes out, as with RISC-V's div / rem ),
+// otherwise returns false value. As usual, truth value is represented using all bits
+// of returnT set to one, while for false value all bits of returnT are set to zero.
+template<typename operandT, typename returnT>
+forceinline constexpr returnT
+ct_divmod(const operandT x, const operandT d, operandT& quot, operandT& rem)
+  requires(ct_operand<operandT> && (sizeof(operandT) == 4 || sizeof(operandT) == 8) && std::is_unsigned_v<returnT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr size_t W = std::numeric_limits<Uop>::digits;
+
+  Uop xu = static_cast<Uop>(x);
+  Uop du = static_cast<Uop>(d);
+
+  // Sign masks, and absolute values, of signed operands
+  Uop xsign = 0;
+  Uop dsign = 0;
+  if constexpr (std::is_signed_v<operandT>) {
+    xsign = static_cast<Uop>(0U - (xu >> (W - 1)));
+    dsign = static_cast<Uop>(0U - (du >> (W - 1)));
+    ct_barrier(xsign);
+    ct_barrier(dsign);
+
+    xu = static_cast<Uop>((xu ^ xsign) - xsign);
+    du = static_cast<Uop>((du ^ dsign) - dsign);
+  }
+
+  Uop q = 0;
+  Uop r = 0;
+
+#if defined(__SIZEOF_INT128__)
+  constexpr bool has_wide = true;
+  __extension__ using wide128_t = unsigned __int128;
+#else
+  constexpr bool has_wide = W == 32;
+  using wide128_t = uint64_t;
+#endif
+
+  if constexpr (has_wide) {
+    // r < d on entry, so ( r << 1 ) | bit < 2d fits in a double-width remainder,
+    // and the borrow out of subtracting d is its top bit
+    using wide_t = std::conditional_t<W == 32, uint64_t, wide128_t>;
+    constexpr size_t WW = 2 * W;
+
+    wide_t rw = 0;
+    for (size_t i = W; i > 0; i--) {
+      rw = static_cast<wide_t>((rw << 1) | ((xu >> (i - 1)) & 1U));
+
+      const auto diff = static_cast<wide_t>(rw - du);
+      Uop mask = static_cast<Uop>(static_cast<Uop>(diff >> (WW - 1)) - 1U);
+      ct_barrier(mask);
+
+      rw = static_cast<wide_t>(rw ^ ((rw ^ diff) & mask));
+      q = static_cast<Uop>(q | static_cast<Uop>((mask & 1U) << (i - 1)));
+    }
+
+    r = static_cast<Uop>(rw);
+  } else {
+    for (size_t i = W; i > 0; i--) {
+      // r < d on entry, so ( r << 1 ) | bit < 2d overflows by at most the bit hi
+      const Uop hi = static_cast<Uop>(r >> (W - 1));
+      r = static_cast<Uop>((r << 1) | ((xu >> (i - 1)) & 1U));
+
+      // Borrow out of r - d, as in ct_lt
+      const Uop diff = static_cast<Uop>(r - du);
+      const Uop borrow = static_cast<Uop>(((~r & du) | (~(r ^ du) & diff)) >> (W - 1));
+
+      const Uop take = static_cast<Uop>(hi | (borrow ^ 1U));
+      Uop mask = static_cast<Uop>(0U - take);
+      ct_barrier(mask);
+
+      r = static_cast<Uop>(r ^ ((r ^ diff) & mask));
+      q = static_cast<Uop>(q | (take << (i - 1)));
+    }
+  }
+
+  if constexpr (std::is_signed_v<operandT>) {
+    const Uop qsign = static_cast<Uop>(xsign ^ dsign);
+    q = static_cast<Uop>((q ^ qsign) - qsign);
+    r = static_cast<Uop>((r ^ xsign) - xsign);
+  }
+
+  // Dividing by zero leaves q all ones and r = x, but for the sign fix up above
+  const Uop zero = ct_is_zero<Uop, Uop>(du);
+  q = static_cast<Uop>(q | zero);
+
+  quot = static_cast<operandT>(q);
+  rem = static_cast<operandT>(r);
+
+  return static_cast<returnT>(0U - static_cast<returnT>(zero & 1U));
+}
+
+
+// Given a byte span buf of length n, a secret shift ( of unsigned type shiftT ) and a
+// scratch span of the same length, this routine rotates buf by shift positions towards
+// the lower indices: buf[i] becomes buf[( i + shift ) mod n].
+//
+// The rotation is a log2( n )-stage network: shift is reduced modulo n with ct_divmod,
+// then for every bit k of it, buf is rotated by 2^k into scratch -- two copies at public
+// offsets -- and copied back with ct_conditional_memcpy under that bit. Every stage reads
+// and writes all of buf whatever the shift is. No memory is allocated: the caller passes
+// scratch in, its contents are overwritten.
+template<typename shiftT, size_t N>
+forceinline constexpr void
+ct_rotate_bytes(std::span<uint8_t, N> buf, const shiftT shift, std::span<uint8_t, N> scratch)
+  requires(std::is_unsigned_v<shiftT>)
+{
+  const size_t n = buf.size();
+  if (n < 2) {
+    return;
+  }
+
+  uint64_t quot = 0;
+  uint64_t rem = 0;
+  static_cast<void>(ct_divmod<uint64_t, uint64_t>(static_cast<uint64_t>(shift), static_cast<uint64_t>(n), quot, rem));
+
+  for (size_t k = 0; (size_t{ 1 } << k) < n; k++) {
+    const size_t c = size_t{ 1 } << k;
+
+    std::ranges::copy(buf.subspan(c), scratch.begin());
+    std::ranges::copy(buf.first(c), scratch.subspan(n - c).begin());
+
+    const auto br = static_cast<uint8_t>(0U - static_cast<uint8_t>((rem >> k) & 1U));
+    ct_conditional_memcpy(br, buf, std::span<const uint8_t, N>(scratch));
+  }
+}
+
+// Given a span dst of m bytes, a span src of n >= m bytes, a secret offset ( of unsigned
+// type offsetT ) in [0, n - m] and a scratch span of m bytes, this routine copies the m
+// bytes of src starting at offset to dst -- e.g. the MAC at a secret position in a
+// decrypted TLS record, after removing the padding.
+//
+// src is read once, from start to end: every byte is ORed into dst[i mod m], masked by
+// whether it lies inside the window, so that dst ends up holding the window rotated by
+// offset mod m, which ct_rotate_bytes then undoes. That is O( n + m log m ) work, where
+// picking each byte of the window with ct_lookup would be O( n m ). Neither the accessed
+// addresses nor the control flow depend on offset; scratch is overwritten.
+template<typename offsetT, size_t M, size_t N>
+forceinline constexpr void
+ct_extract(std::span<uint8_t, M> dst, std::span<const uint8_t, N> src, const offsetT offset, std::span<uint8_t, M> scratch)
+  requires(std::is_unsigned_v<offsetT>)
+{
+  const size_t m = dst.size();
+  if (m == 0) {
+    return;
+  }
+
+  std::ranges::fill(dst, uint8_t{ 0 });
+
+  const auto off = static_cast<uint64_t>(offset);
+  for (size_t base = 0; base < src.size(); base += m) {
+    const auto chunk = src.subspan(base, std::min(m, src.size() - base));
+
+    for (size_t j = 0; j < chunk.size(); j++) {
+      // All ones iff 0 <= i - offset < m, from the sign bits of ( i - offset ) - m and
+      // i - offset, both below 2^63
+      const uint64_t d = static_cast<uint64_t>(base + j) - off;
+      auto in_window = static_cast<uint8_t>(0U - static_cast<uint8_t>(((d - m) & ~d) >> 63));
+      ct_barrier(in_window);
+
+      dst[j] = static_cast<uint8_t>(dst[j] | static_cast<uint8_t>(chunk[j] & in_window));
+    }
+  }
+
+  ct_rotate_bytes(dst, off, scratch);
 }
 
 }
@@ -0,0 +1,695 @@
+#pragma once
+#include "subtle.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// Carry-chain detection: on x86-64, _addcarry_u* / _subborrow_u* compile to adc / sbb
+// ( they are baseline instructions, no target flag needed ). Elsewhere, clang's
+// __builtin_addc* / __builtin_subc* family is used when present, and a portable
+// majority-function carry otherwise -- all of them free of secret-dependent branches.
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define SUBTLE_ADDCARRY_X86_ACTIVE_
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+#define SUBTLE_ADDCARRY_BUILTIN_ACTIVE_
+#endif
+#endif
+
+// Multi-precision arithmetic over little-endian limb spans of secret integers.
+namespace subtle {
+
+// A limb of a multi-precision integer: an unsigned 32- or 64-bit word. Limb spans are
+// little-endian, i.e. limb 0 is the least significant one.
+template<typename limbT>
+concept ct_limb = std::is_same_v<limbT, uint32_t> || std::is_same_v<limbT, uint64_t>;
+
+// Given two limbs a, b and a carry ( 0 or 1 ), this routine returns the low limb of
+// a + b + carry, setting carry to the carry out of that sum ( again 0 or 1 ).
+template<typename limbT>
+forceinline constexpr limbT
+ct_addc(const limbT a, const limbT b, limbT& carry)
+  requires(ct_limb<limbT>)
+{
+  if (!std::is_constant_evaluated()) {
+#if defined(SUBTLE_ADDCARRY_X86_ACTIVE_)
+    if constexpr (sizeof(limbT) == 8) {
+      unsigned long long sum = 0;
+      carry = _addcarry_u64(static_cast<unsigned char>(carry), a, b, &sum);
+      return static_cast<limbT>(sum);
+    } else {
+      unsigned int sum = 0;
+      carry = _addcarry_u32(static_cast<unsigned char>(carry), a, b, &sum);
+      return static_cast<limbT>(sum);
+    }
+#elif defined(SUBTLE_ADDCARRY_BUILTIN_ACTIVE_)
+    if constexpr (sizeof(limbT) == 8) {
+      unsigned long long carry_out = 0;
+      const auto sum = __builtin_addcll(a, b, carry, &carry_out);
+      carry = static_cast<limbT>(carry_out);
+      return static_cast<limbT>(sum);
+    } else {
+      unsigned int carry_out = 0;
+      const auto sum = __builtin_addc(a, b, carry, &carry_out);
+      carry = static_cast<limbT>(carry_out);
+      return static_cast<limbT>(sum);
+    }
+#endif
+  }
+
+  // Carry out is the majority of the top bits of a, b and the complemented sum.
+  constexpr size_t top = std::numeric_limits<limbT>::digits - 1;
+
+  const auto sum = static_cast<limbT>(a + b + carry);
+  carry = static_cast<limbT>(((a & b) | ((a | b) & ~sum)) >> top);
+  return sum;
+}
+
+// Given two limbs a, b and a borrow ( 0 or 1 ), this routine returns the low limb of
+// a - b - borrow, setting borrow to the borrow out of that difference ( 0 or 1 ).
+template<typename limbT>
+forceinline constexpr limbT
+ct_subb(const limbT a, const limbT b, limbT& borrow)
+  requires(ct_limb<limbT>)
+{
+  if (!std::is_constant_evaluated()) {
+#if defined(SUBTLE_ADDCARRY_X86_ACTIVE_)
+    if constexpr (sizeof(limbT) == 8) {
+      unsigned long long diff = 0;
+      borrow = _subborrow_u64(static_cast<unsigned char>(borrow), a, b, &diff);
+      return static_cast<limbT>(diff);
+    } else {
+      unsigned int diff = 0;
+      borrow = _subborrow_u32(static_cast<unsigned char>(borrow), a, b, &diff);
+      return static_cast<limbT>(diff);
+    }
+#elif defined(SUBTLE_ADDCARRY_BUILTIN_ACTIVE_)
+    if constexpr (sizeof(limbT) == 8) {
+      unsigned long long borrow_out = 0;
+      const auto diff = __builtin_subcll(a, b, borrow, &borrow_out);
+      borrow = static_cast<limbT>(borrow_out);
+      return static_cast<limbT>(diff);
+    } else {
+      unsigned int borrow_out = 0;
+      const auto diff = __builtin_subc(a, b, borrow, &borrow_out);
+      borrow = static_cast<limbT>(borrow_out);
+      return static_cast<limbT>(diff);
+    }
+#endif
+  }
+
+  // Borrow out is the majority of the top bits of the complemented a, b and the difference.
+  constexpr size_t top = std::numeric_limits<limbT>::digits - 1;
+
+  const auto diff = static_cast<limbT>(a - b - borrow);
+  borrow = static_cast<limbT>(((~a & b) | ((~a | b) & diff)) >> top);
+  return diff;
+}
+
+// Calls step( i ) for every limb index i below n, in increasing order. For fixed extents
+// of 4 to 8 limbs -- the operand sizes of elliptic-curve fields -- the calls are unrolled
+// at compile time, so that the carry can stay in the flags register along a straight
+// adc / sbb chain, instead of being saved and restored around a loop branch.
+template<size_t N, typename stepT>
+forceinline constexpr void
+ct_for_each_limb(const size_t n, const stepT& step)
+{
+  if constexpr (N != std::dynamic_extent && N >= 4 && N <= 8) {
+    [&]<size_t... I>(std::index_sequence<I...>) { (step(I), ...); }(std::make_index_sequence<N>{});
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      step(i);
+    }
+  }
+}
+
+// Given equal-length limb spans r, a, b, this routine computes r = a + b, modulo
+// 2^( bits in the span ), and returns truth value ( all bits set ) if the addition
+// carried out of the top limb, or false value ( all bits zero ) otherwise.
+//
+// r may be the same span as a or b.
+template<typename limbT, typename returnT, size_t N>
+forceinline constexpr returnT
+ct_add_carry(std::span<limbT, N> r, std::span<const limbT, N> a, std::span<const limbT, N> b)
+  requires(ct_limb<limbT> && std::is_unsigned_v<returnT>)
+{
+  limbT carry = 0;
+  ct_for_each_limb<N>(r.size(), [&](const size_t i) { r[i] = ct_addc(a[i], b[i], carry); });
+
+  return static_cast<returnT>(returnT{ 0 } - static_cast<returnT>(carry));
+}
+
+// Given equal-length limb spans r, a, b, this routine computes r = a - b, modulo
+// 2^( bits in the span ), and returns truth value ( all bits set ) if the subtraction
+// borrowed out of the top limb -- i.e. if a < b -- or false value otherwise.
+//
+// r may be the same span as a or b.
+template<typename limbT, typename returnT, size_t N>
+forceinline constexpr returnT
+ct_sub_borrow(std::span<limbT, N> r, std::span<const limbT, N> a, std::span<const limbT, N> b)
+  requires(ct_limb<limbT> && std::is_unsigned_v<returnT>)
+{
+  limbT borrow = 0;
+  ct_for_each_limb<N>(r.size(), [&](const size_t i) { r[i] = ct_subb(a[i], b[i], borrow); });
+
+  return static_cast<returnT>(returnT{ 0 } - static_cast<returnT>(borrow));
+}
+
+// Given a limb span x, an equal-length limb span m and an extra top limb hi of x, this
+// routine subtracts m from x in place if hi:x >= m, and leaves x as it is otherwise --
+// the final step of a Montgomery or Barrett reduction, where hi catches the carry out
+// of the preceding addition ( pass 0 when there is none ). Returns truth value ( all
+// bits set ) if m was subtracted, or false value ( all bits zero ) otherwise.
+//
+// Both cases run the same two passes: the first one only propagates the borrow of
+// x - m, which ( absorbed by hi ) decides the comparison, the second one subtracts m
+// masked by that decision. No scratch is needed.
+template<typename limbT, typename returnT, size_t N>
+forceinline constexpr returnT
+ct_cond_sub(std::span<limbT, N> x, std::span<const limbT, N> m, const limbT hi = 0)
+  requires(ct_limb<limbT> && std::is_unsigned_v<returnT>)
+{
+  limbT borrow = 0;
+  ct_for_each_limb<N>(x.size(), [&](const size_t i) { static_cast<void>(ct_subb(x[i], m[i], borrow)); });
+  static_cast<void>(ct_subb(hi, limbT{ 0 }, borrow));
+
+  // All bits set iff hi:x - m did not borrow, i.e. hi:x >= m.
+  auto mask = static_cast<limbT>(borrow - 1U);
+  ct_barrier(mask);
+
+  borrow = 0;
+  ct_for_each_limb<N>(x.size(), [&](const size_t i) { x[i] = ct_subb(x[i], static_cast<limbT>(m[i] & mask), borrow); });
+
+  return static_cast<returnT>(returnT{ 0 } - static_cast<returnT>(mask & 1U));
+}
+
+// Given a limb span x, this routine returns the bit length of the integer it holds -- 0
+// if that is zero. Every limb is visited: the bit length of the most significant
+// non-zero one, offset by its position, is kept by masked selection as the scan goes up,
+// rather than found by an early exit from the top.
+template<typename limbT, size_t N>
+forceinline constexpr size_t
+ct_bit_length(std::span<const limbT, N> x)
+  requires(ct_limb<limbT>)
+{
+  constexpr size_t digits = std::numeric_limits<limbT>::digits;
+
+  size_t len = 0;
+  for (size_t i = 0; i < x.size(); i++) {
+    const auto nonzero = static_cast<size_t>(~ct_is_zero<limbT, size_t>(x[i]));
+    len = ct_select(nonzero, i * digits + ct_bit_length(x[i]), len);
+  }
+
+  return len;
+}
+
+// Given a limb span x, this routine returns the number of leading zero bits of the
+// integer it holds, over the width of the span -- all of them if it is zero.
+template<typename limbT, size_t N>
+forceinline constexpr size_t
+ct_clz(std::span<const limbT, N> x)
+  requires(ct_limb<limbT>)
+{
+  return x.size() * std::numeric_limits<limbT>::digits - ct_bit_length(x);
+}
+
+// Given a limb span x, this routine returns the number of trailing zero bits of the
+// integer it holds -- the width of the span if it is zero. As with ct_bit_length, every
+// limb is visited, scanning down this time, so that the least significant non-zero limb
+// is selected last.
+template<typename limbT, size_t N>
+forceinline constexpr size_t
+ct_ctz(std::span<const limbT, N> x)
+  requires(ct_limb<limbT>)
+{
+  constexpr size_t digits = std::numeric_limits<limbT>::digits;
+
+  size_t tz = x.size() * digits;
+  for (size_t i = x.size(); i > 0; i--) {
+    const auto nonzero = static_cast<size_t>(~ct_is_zero<limbT, size_t>(x[i - 1]));
+    tz = ct_select(nonzero, (i - 1) * digits + ct_ctz(x[i - 1]), tz);
+  }
+
+  return tz;
+}
+
+// Given 64-bit limbs a, b, c and a carry limb, this routine returns the low limb of
+// a * b + c + carry, setting carry to the high limb. The sum always fits in two limbs,
+// as ( 2^64 - 1 )^2 + 2 * ( 2^64 - 1 ) = 2^128 - 1.
+//
+// Uses the compiler's 128-bit integer where there is one ( a single mul on 64-bit
+// targets ), or else four 32x32-bit partial products, whose latency doesn't depend on
+// the operands either.
+forceinline constexpr uint64_t
+ct_mac(const uint64_t a, const uint64_t b, const uint64_t c, uint64_t& carry)
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ using wide_t = unsigned __int128;
+
+  const wide_t t = static_cast<wide_t>(a) * b + c + carry;
+  carry = static_cast<uint64_t>(t >> 64);
+  return static_cast<uint64_t>(t);
+#else
+  constexpr uint64_t half = 0xffffffffULL;
+
+  const uint64_t p0 = (a & half) * (b & half);
+  const uint64_t p1 = (a & half) * (b >> 32);
+  const uint64_t p2 = (a >> 32) * (b & half);
+  const uint64_t p3 = (a >> 32) * (b >> 32);
+
+  const uint64_t mid = (p0 >> 32) + (p1 & half) + (p2 & half);
+  uint64_t lo = (p0 & half) | (mid << 32);
+  const uint64_t hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+
+  uint64_t k0 = 0;
+  uint64_t k1 = 0;
+  lo = ct_addc(lo, c, k0);
+  lo = ct_addc(lo, carry, k1);
+  carry = hi + k0 + k1;
+  return lo;
+#endif
+}
+
+// Montgomery arithmetic modulo a fixed odd modulus n of LIMBS 64-bit limbs -- 256 to
+// 4096 bits -- with R = 2^( 64 * LIMBS ). Values in Montgomery form are a * R mod n,
+// and multiplying two of them with mul ( or one by itself with sqr ) yields the
+// Montgomery form of their product, with no division involved.
+//
+// The modulus is public: it is given at construction, along with the derived constants
+// -n^-1 mod 2^64 and R^2 mod n. Operands are secret, and every routine runs a fixed
+// sequence of limb multiplications and additions for them, ending in ct_cond_sub
+// instead of a data-dependent final subtraction. Operands must be below n.
+//
+// mul is the Coarsely Integrated Operand Scanning ( CIOS ) method, interleaving one
+// row of the product with one word of the reduction, in LIMBS + 2 limbs of working
+// space. Above 4 limbs, sqr computes the full square first, with each cross product
+// a[i] * a[j] computed once and doubled -- about half of the product's multiplications
+// -- and then reduces it word by word.
+template<size_t LIMBS>
+  requires(LIMBS >= 4 && LIMBS <= 64)
+class ct_montgomery
+{
+  std::array<uint64_t, LIMBS> n{};
+  std::array<uint64_t, LIMBS> r2{};
+  uint64_t n0inv = 0;
+
+  // Given a 2 * LIMBS limb value t below n * R, this routine writes t * R^-1 mod n
+  // to r, zeroizing t: LIMBS word-wise reduction steps, each one adding the multiple
+  // of n which clears the lowest remaining limb of t.
+  forceinline constexpr void reduce(std::span<uint64_t, LIMBS> r, std::span<uint64_t, 2 * LIMBS> t) const
+  {
+    uint64_t top = 0;
+
+    for (size_t i = 0; i < LIMBS; i++) {
+      const uint64_t m = t[i] * n0inv;
+
+      uint64_t carry = 0;
+      ct_for_each_limb<LIMBS>(LIMBS, [&](const size_t j) { t[i + j] = ct_mac(m, n[j], t[i + j], carry); });
+
+      // The carry out of position i + LIMBS is owed to the next position, which the
+      // next step adds it to.
+      t[i + LIMBS] = ct_addc(t[i + LIMBS], carry, top);
+    }
+
+    auto hi = t.template subspan<LIMBS, LIMBS>();
+    ct_cond_sub<uint64_t, uint64_t, LIMBS>(hi, n, top);
+    std::ranges::copy(hi, r.begin());
+
+    ct_zeroize(t);
+  }
+
+public:
+  // Given an odd modulus n > 1 of LIMBS limbs, this routine sets up Montgomery
+  // arithmetic modulo n.
+  constexpr explicit ct_montgomery(std::span<const uint64_t, LIMBS> modulus)
+  {
+    std::ranges::copy(modulus, n.begin());
+
+    // Newton's iteration for n[0]^-1 mod 2^64: n[0] is its own inverse modulo 2^3, and
+    // every step doubles the number of correct low bits.
+    uint64_t inv = n[0];
+    for (size_t i = 0; i < 5; i++) {
+      inv *= 2U - n[0] * inv;
+    }
+    n0inv = uint64_t{ 0 } - inv;
+
+    // R^2 mod n, doubling 1 modulo n 2 * 64 * LIMBS times.
+    r2[0] = 1;
+    for (size_t i = 0; i < 2 * 64 * LIMBS; i++) {
+      const auto carry = ct_add_carry<uint64_t, uint64_t, LIMBS>(r2, r2, r2);
+      ct_cond_sub<uint64_t, uint64_t, LIMBS>(r2, n, carry & 1U);
+    }
+  }
+
+  // Returns the modulus n.
+  [[nodiscard]] constexpr std::span<const uint64_t, LIMBS> modulus() const { return n; }
+
+  // Given a, b in Montgomery form, this routine writes their product a * b * R^-1 mod n,
+  // again in Montgomery form, to r. r may be the same span as a or b.
+  forceinline constexpr void mul(std::span<uint64_t, LIMBS> r, std::span<const uint64_t, LIMBS> a, std::span<const uint64_t, LIMBS> b) const
+  {
+    std::array<uint64_t, LIMBS + 2> t{};
+
+    for (size_t i = 0; i < LIMBS; i++) {
+      // t += a * b[i]
+      uint64_t carry = 0;
+      ct_for_each_limb<LIMBS>(LIMBS, [&](const size_t j) { t[j] = ct_mac(a[j], b[i], t[j], carry); });
+
+      uint64_t k = 0;
+      t[LIMBS] = ct_addc(t[LIMBS], carry, k);
+      t[LIMBS + 1] = k;
+
+      // t = ( t + m * n ) / 2^64, m chosen so that the division is exact
+      const uint64_t m = t[0] * n0inv;
+
+      carry = 0;
+      ct_for_each_limb<LIMBS>(LIMBS, [&](const size_t j) {
+        const uint64_t word = ct_mac(m, n[j], t[j], carry);
+        if (j > 0) {
+          t[j - 1] = word;
+        }
+      });
+
+      k = 0;
+      t[LIMBS - 1] = ct_addc(t[LIMBS], carry, k);
+      t[LIMBS] = t[LIMBS + 1] + k;
+    }
+
+    // t < 2n, as a LIMBS + 1 limb value.
+    auto lo = std::span(t).template first<LIMBS>();
+    ct_cond_sub<uint64_t, uint64_t, LIMBS>(lo, n, t[LIMBS]);
+    std::ranges::copy(lo, r.begin());
+
+    ct_zeroize(std::span(t));
+  }
+
+  // Given a in Montgomery form, this routine writes a * a * R^-1 mod n to r. r may be
+  // the same span as a.
+  forceinline constexpr void sqr(std::span<uint64_t, LIMBS> r, std::span<const uint64_t, LIMBS> a) const
+  {
+    // At 4 limbs, the extra passes cost more than the 6 multiplications they save.
+    if constexpr (LIMBS == 4) {
+      mul(r, a, a);
+      return;
+    }
+
+    std::array<uint64_t, 2 * LIMBS> t{};
+
+    // Cross products a[i] * a[j], for i < j
+    for (size_t i = 0; i < LIMBS - 1; i++) {
+      uint64_t carry = 0;
+      for (size_t j = i + 1; j < LIMBS; j++) {
+        t[i + j] = ct_mac(a[i], a[j], t[i + j], carry);
+      }
+      t[i + LIMBS] = carry;
+    }
+
+    // Doubled, as each of them shows up twice in the square
+    for (size_t i = 2 * LIMBS - 1; i > 0; i--) {
+      t[i] = (t[i] << 1) | (t[i - 1] >> 63);
+    }
+
+    // Plus the squares a[i] * a[i] on the diagonal
+    uint64_t k = 0;
+    for (size_t i = 0; i < LIMBS; i++) {
+      uint64_t hi = 0;
+      const uint64_t lo = ct_mac(a[i], a[i], 0, hi);
+
+      t[2 * i] = ct_addc(t[2 * i], lo, k);
+      t[2 * i + 1] = ct_addc(t[2 * i + 1], hi, k);
+    }
+
+    reduce(r, t);
+  }
+
+  // Given a below n, this routine writes its Montgomery form a * R mod n to r. r may
+  // be the same span as a.
+  forceinline constexpr void to_montgomery(std::span<uint64_t, LIMBS> r, std::span<const uint64_t, LIMBS> a) const { mul(r, a, r2); }
+
+  // Given a in Montgomery form, this routine writes a * R^-1 mod n -- the plain value
+  // it stands for -- to r. r may be the same span as a.
+  forceinline constexpr void from_montgomery(std::span<uint64_t, LIMBS> r, std::span<const uint64_t, LIMBS> a) const
+  {
+    std::array<uint64_t, 2 * LIMBS> t{};
+    std::ranges::copy(a, t.begin());
+
+    reduce(r, t);
+  }
+};
+
+#if defined(__SIZEOF_INT128__)
+
+// Constant-time inversion modulo a fixed odd modulus n of LIMBS 64-bit limbs, by
+// Bernstein and Yang's safegcd: a run of divsteps on ( f, g ) = ( n, a ), each one
+// halving g after conditionally subtracting or adding f, ends with f = +/-1 and g = 0
+// while the same transitions, applied to ( d, e ) = ( 0, 1 ) modulo n, leave +/-a^-1
+// in d. A Fermat inversion a^( n - 2 ) costs about as many modular multiplications
+// as n has bits; this costs the equivalent of a few dozen.
+//
+// The divsteps only look at the low bits of f and g, so they run 62 at a time on
+// single words, accumulating a 2x2 transition matrix scaled by 2^62, which is then
+// applied to the full f, g and d, e -- held as signed 62-bit limbs, so that products
+// with matrix entries fit in 128 bits. Every step is mask arithmetic, as with
+// ct_select / ct_swap, and the number of batches is fixed by the width of n: enough
+// divsteps for any input, by Bernstein and Yang's bound of ( 49d + 57 ) / 17 steps
+// for d-bit inputs ( ( 49d + 80 ) / 17 below 46 bits ). Timing doesn't depend on a.
+//
+// The modulus is public. n need not be prime: the result is the inverse of a whenever
+// gcd( a, n ) = 1, and 0 is mapped to 0. Requires a 128-bit integer type.
+template<size_t LIMBS>
+  requires(LIMBS >= 1 && LIMBS <= 64)
+class ct_modinv
+{
+  __extension__ using swide_t = __int128;
+
+  static constexpr size_t BITS = 64 * LIMBS;
+  static constexpr size_t DIVSTEPS = BITS < 46 ? (49 * BITS + 80) / 17 : (49 * BITS + 57) / 17;
+  static constexpr size_t BATCHES = (DIVSTEPS + 61) / 62;
+
+  // Signed 62-bit limbs: all but the top one in [0, 2^62), the top one signed.
+  static constexpr size_t SLIMBS = BITS / 62 + 1;
+  static constexpr uint64_t M62 = std::numeric_limits<uint64_t>::max() >> 2;
+
+  using signed62_t = std::array<int64_t, SLIMBS>;
+
+  // 2x2 transition matrix of 62 divsteps, scaled by 2^62.
+  struct trans_t
+  {
+    int64_t u = 0, v = 0, q = 0, r = 0;
+  };
+
+  signed62_t n62{};
+  uint64_t n_inv62 = 0;
+
+  // Splits little-endian 64-bit limbs into signed 62-bit limbs.
+  static constexpr signed62_t to_signed62(std::span<const uint64_t, LIMBS> a)
+  {
+    signed62_t r{};
+    for (size_t i = 0; i < SLIMBS; i++) {
+      const size_t word = (62 * i) / 64;
+      const size_t off = (62 * i) % 64;
+
+      uint64_t limb = word < LIMBS ? a[word] >> off : 0;
+      if (off > 2 && word + 1 < LIMBS) {
+        limb |= a[word + 1] << (64 - off);
+      }
+      r[i] = static_cast<int64_t>(limb & M62);
+    }
+
+    return r;
+  }
+
+  // Joins signed 62-bit limbs, all in [0, 2^62), back into 64-bit limbs.
+  static constexpr void from_signed62(std::span<uint64_t, LIMBS> r, const signed62_t& a)
+  {
+    std::ranges::fill(r, uint64_t{ 0 });
+    for (size_t i = 0; i < SLIMBS; i++) {
+      const size_t word = (62 * i) / 64;
+      const size_t off = (62 * i) % 64;
+      const auto limb = static_cast<uint64_t>(a[i]);
+
+      if (word < LIMBS) {
+        r[word] |= limb << off;
+      }
+      if (off > 2 && word + 1 < LIMBS) {
+        r[word + 1] |= limb >> (64 - off);
+      }
+    }
+  }
+
+  // Runs 62 divsteps on the low words f0, g0 of f, g ( f odd ), given eta = -delta,
+  // and returns the updated eta, writing their transition matrix to t. Both branches
+  // of a divstep are computed, under the masks for "delta > 0" and "g is odd".
+  static constexpr int64_t divsteps_62(int64_t eta, const uint64_t f0, const uint64_t g0, trans_t& t)
+  {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t f = f0, g = g0;
+
+    for (size_t i = 0; i < 62; i++) {
+      // delta > 0 and g odd: ( f, g ) = ( g, ( g - f ) / 2 ), else g = ( g + ( g odd ) f ) / 2
+      auto neg = static_cast<uint64_t>(eta >> 63);
+      auto odd = uint64_t{ 0 } - (g & 1U);
+      ct_barrier(neg);
+      ct_barrier(odd);
+
+      g += ((f ^ neg) - neg) & odd;
+      q += ((u ^ neg) - neg) & odd;
+      r += ((v ^ neg) - neg) & odd;
+
+      const uint64_t swap = neg & odd;
+      eta = static_cast<int64_t>((static_cast<uint64_t>(eta) ^ swap) - 1U - swap);
+
+      f += g & swap;
+      u += q & swap;
+      v += r & swap;
+
+      g >>= 1;
+      u <<= 1;
+      v <<= 1;
+    }
+
+    t = trans_t{ static_cast<int64_t>(u), static_cast<int64_t>(v), static_cast<int64_t>(q), static_cast<int64_t>(r) };
+    return eta;
+  }
+
+  // ( f, g ) = t * ( f, g ) / 2^62 -- an exact division.
+  static constexpr void update_fg(signed62_t& f, signed62_t& g, const trans_t& t)
+  {
+    swide_t cf = static_cast<swide_t>(t.u) * f[0] + static_cast<swide_t>(t.v) * g[0];
+    swide_t cg = static_cast<swide_t>(t.q) * f[0] + static_cast<swide_t>(t.r) * g[0];
+    cf >>= 62;
+    cg >>= 62;
+
+    for (size_t i = 1; i < SLIMBS; i++) {
+      cf += static_cast<swide_t>(t.u) * f[i] + static_cast<swide_t>(t.v) * g[i];
+      cg += static_cast<swide_t>(t.q) * f[i] + static_cast<swide_t>(t.r) * g[i];
+
+      f[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cf) & M62);
+      g[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cg) & M62);
+      cf >>= 62;
+      cg >>= 62;
+    }
+
+    f[SLIMBS - 1] = static_cast<int64_t>(cf);
+    g[SLIMBS - 1] = static_cast<int64_t>(cg);
+  }
+
+  // ( d, e ) = t * ( d, e ) / 2^62 modulo n, keeping both in ( -2n, n ): multiples
+  // md, me of n are added to make the division exact, offset by n for a negative d / e.
+  constexpr void update_de(signed62_t& d, signed62_t& e, const trans_t& t) const
+  {
+    const int64_t sd = d[SLIMBS - 1] >> 63;
+    const int64_t se = e[SLIMBS - 1] >> 63;
+
+    auto md = static_cast<uint64_t>((t.u & sd) + (t.v & se));
+    auto me = static_cast<uint64_t>((t.q & sd) + (t.r & se));
+
+    swide_t cd = static_cast<swide_t>(t.u) * d[0] + static_cast<swide_t>(t.v) * e[0];
+    swide_t ce = static_cast<swide_t>(t.q) * d[0] + static_cast<swide_t>(t.r) * e[0];
+
+    md -= (n_inv62 * static_cast<uint64_t>(cd) + md) & M62;
+    me -= (n_inv62 * static_cast<uint64_t>(ce) + me) & M62;
+
+    const auto smd = static_cast<int64_t>(md);
+    const auto sme = static_cast<int64_t>(me);
+
+    cd += static_cast<swide_t>(n62[0]) * smd;
+    ce += static_cast<swide_t>(n62[0]) * sme;
+    cd >>= 62;
+    ce >>= 62;
+
+    for (size_t i = 1; i < SLIMBS; i++) {
+      cd += static_cast<swide_t>(t.u) * d[i] + static_cast<swide_t>(t.v) * e[i] + static_cast<swide_t>(n62[i]) * smd;
+      ce += static_cast<swide_t>(t.q) * d[i] + static_cast<swide_t>(t.r) * e[i] + static_cast<swide_t>(n62[i]) * sme;
+
+      d[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(cd) & M62);
+      e[i - 1] = static_cast<int64_t>(static_cast<uint64_t>(ce) & M62);
+      cd >>= 62;
+      ce >>= 62;
+    }
+
+    d[SLIMBS - 1] = static_cast<int64_t>(cd);
+    e[SLIMBS - 1] = static_cast<int64_t>(ce);
+  }
+
+  // Carries every limb but the top one back into [0, 2^62).
+  static constexpr void propagate(signed62_t& a)
+  {
+    for (size_t i = 0; i + 1 < SLIMBS; i++) {
+      a[i + 1] += a[i] >> 62;
+      a[i] = static_cast<int64_t>(static_cast<uint64_t>(a[i]) & M62);
+    }
+  }
+
+  // Given d in ( -2n, n ) and the sign word of f = +/-1, this routine brings d * f
+  // into [0, n): add n if negative, negate along with f, add n if still negative.
+  constexpr void normalize(signed62_t& d, const int64_t f_sign) const
+  {
+    int64_t add = d[SLIMBS - 1] >> 63;
+    for (size_t i = 0; i < SLIMBS; i++) {
+      d[i] += n62[i] & add;
+    }
+
+    const int64_t neg = f_sign >> 63;
+    for (size_t i = 0; i < SLIMBS; i++) {
+      d[i] = (d[i] ^ neg) - neg;
+    }
+    propagate(d);
+
+    add = d[SLIMBS - 1] >> 63;
+    for (size_t i = 0; i < SLIMBS; i++) {
+      d[i] += n62[i] & add;
+    }
+    propagate(d);
+  }
+
+public:
+  // Given an odd modulus n > 1 of LIMBS limbs, this routine sets up inversion modulo n.
+  constexpr explicit ct_modinv(std::span<const uint64_t, LIMBS> modulus)
+    : n62(to_signed62(modulus))
+  {
+    uint64_t inv = modulus[0];
+    for (size_t i = 0; i < 5; i++) {
+      inv *= 2U - modulus[0] * inv;
+    }
+    n_inv62 = inv & M62;
+  }
+
+  // Given a below n, this routine writes a^-1 mod n to r ( or 0, for a = 0 ). r may be
+  // the same span as a.
+  constexpr void invert(std::span<uint64_t, LIMBS> r, std::span<const uint64_t, LIMBS> a) const
+  {
+    signed62_t d{};
+    signed62_t e{};
+    signed62_t f = n62;
+    signed62_t g = to_signed62(a);
+    e[0] = 1;
+
+    int64_t eta = -1;
+    for (size_t i = 0; i < BATCHES; i++) {
+      trans_t t{};
+      eta = divsteps_62(eta, static_cast<uint64_t>(f[0]), static_cast<uint64_t>(g[0]), t);
+
+      update_de(d, e, t);
+      update_fg(f, g, t);
+    }
+
+    normalize(d, f[SLIMBS - 1]);
+    from_signed62(r, d);
+
+    ct_zeroize(std::span(d));
+    ct_zeroize(std::span(e));
+    ct_zeroize(std::span(f));
+    ct_zeroize(std::span(g));
+  }
+};
+
+#endif
+
+}
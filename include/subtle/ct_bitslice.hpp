@@ -0,0 +1,205 @@
+#pragma once
+#include "subtle.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Bitsliced evaluation of 8-bit S-boxes.
+namespace subtle {
+
+// Number of bytes in one bitsliced batch: one byte per bit of a uint64_t bit-plane.
+constexpr size_t CT_BITSLICE_LANES = 64;
+
+// Number of bit-planes in one bitsliced batch: one per bit of a byte.
+constexpr size_t CT_BITSLICE_PLANES = 8;
+
+// Given a batch of 64 bytes, this routine transposes it into 8 bit-planes, such
+// that bit i of planes[b] is bit b of bytes[i].
+//
+// Portable path: eight ct_transpose8x8 calls, one per 8 bytes. With AVX2, pmovmskb
+// collects the top bit of all 32 bytes of a register at once, so each plane is one
+// movemask per 32 bytes, with a byte-wise left shift ( paddb ) between planes.
+forceinline constexpr void
+ct_bitslice_bytes(std::span<const uint8_t, CT_BITSLICE_LANES> bytes, std::span<uint64_t, CT_BITSLICE_PLANES> planes)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    const auto* src = reinterpret_cast<const __m256i*>(bytes.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    __m256i lo = _mm256_loadu_si256(src);
+    __m256i hi = _mm256_loadu_si256(src + 1);
+
+    for (size_t b = CT_BITSLICE_PLANES; b-- > 0;) {
+      const auto lo_bits = static_cast<uint32_t>(_mm256_movemask_epi8(lo));
+      const auto hi_bits = static_cast<uint32_t>(_mm256_movemask_epi8(hi));
+      planes[b] = (static_cast<uint64_t>(hi_bits) << 32) | lo_bits;
+
+      lo = _mm256_add_epi8(lo, lo);
+      hi = _mm256_add_epi8(hi, hi);
+    }
+    return;
+  }
+#endif
+
+  std::ranges::fill(planes, uint64_t{ 0 });
+
+  for (size_t g = 0; g < CT_BITSLICE_LANES / 8; g++) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 8; j++) {
+      word |= static_cast<uint64_t>(bytes[8 * g + j]) << (8 * j);
+    }
+
+    word = ct_transpose8x8(word);
+
+    for (size_t b = 0; b < CT_BITSLICE_PLANES; b++) {
+      planes[b] |= ((word >> (8 * b)) & 0xffULL) << (8 * g);
+    }
+  }
+}
+
+// Inverse of ct_bitslice_bytes: given 8 bit-planes, this routine gathers them back
+// into a batch of 64 bytes, such that bit b of bytes[i] is bit i of planes[b].
+//
+// With AVX2, each 32-bit half of a plane is broadcast, pshufb spreads byte i / 8 of
+// it over byte i, and a compare against the per-byte bit selector 1 << ( i % 8 )
+// turns bit i into a full byte mask, of which bit b is kept.
+forceinline constexpr void
+ct_unbitslice_bytes(std::span<const uint64_t, CT_BITSLICE_PLANES> planes, std::span<uint8_t, CT_BITSLICE_LANES> bytes)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit_sel = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+
+    auto* dst = reinterpret_cast<__m256i*>(bytes.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    for (size_t half = 0; half < 2; half++) {
+      __m256i acc = _mm256_setzero_si256();
+
+      for (size_t b = 0; b < CT_BITSLICE_PLANES; b++) {
+        const auto word = static_cast<uint32_t>(planes[b] >> (32 * half));
+
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(word)), spread);
+        v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit_sel), bit_sel);
+        acc = _mm256_or_si256(acc, _mm256_and_si256(v, _mm256_set1_epi8(static_cast<char>(1U << b))));
+      }
+
+      _mm256_storeu_si256(dst + half, acc);
+    }
+    return;
+  }
+#endif
+
+  for (size_t g = 0; g < CT_BITSLICE_LANES / 8; g++) {
+    uint64_t word = 0;
+    for (size_t b = 0; b < CT_BITSLICE_PLANES; b++) {
+      word |= ((planes[b] >> (8 * g)) & 0xffULL) << (8 * b);
+    }
+
+    word = ct_transpose8x8(word);
+
+    for (size_t j = 0; j < 8; j++) {
+      bytes[8 * g + j] = static_cast<uint8_t>(word >> (8 * j));
+    }
+  }
+}
+
+// A bitsliced circuit over one batch: any callable which maps the 8 input bit-planes
+// to the 8 output bit-planes in place, using only bitwise gates -- i.e. a Boolean
+// circuit evaluated on 64 bytes at once.
+template<typename circuitT>
+concept ct_bitsliced_circuit = std::is_invocable_v<const circuitT&, std::span<uint64_t, CT_BITSLICE_PLANES>>;
+
+// Given a bitsliced circuit and two equal-length byte spans dst, src, this routine
+// writes circuit( src[i] ) to dst[i] for every i: bytes are transposed into bit-planes
+// 64 at a time, pushed through the circuit and transposed back. A trailing partial
+// batch is zero-padded through a stack buffer -- the length is public, so this only
+// depends on it. dst and src may be the same span.
+template<typename circuitT>
+forceinline constexpr void
+ct_bitsliced_substitute(const circuitT& circuit, std::span<uint8_t> dst, std::span<const uint8_t> src)
+  requires(ct_bitsliced_circuit<circuitT>)
+{
+  std::array<uint8_t, CT_BITSLICE_LANES> batch{};
+  std::array<uint64_t, CT_BITSLICE_PLANES> planes{};
+
+  for (size_t off = 0; off < src.size(); off += CT_BITSLICE_LANES) {
+    const size_t len = std::min(CT_BITSLICE_LANES, src.size() - off);
+
+    std::ranges::fill(batch, uint8_t{ 0 });
+    std::ranges::copy(src.subspan(off, len), batch.begin());
+
+    ct_bitslice_bytes(batch, planes);
+    circuit(std::span<uint64_t, CT_BITSLICE_PLANES>(planes));
+    ct_unbitslice_bytes(planes, batch);
+
+    std::ranges::copy(std::span<const uint8_t>(batch).first(len), dst.subspan(off, len).begin());
+  }
+
+  ct_zeroize(std::span(batch));
+  ct_zeroize(std::span(planes));
+}
+
+// Generic bitsliced evaluator of an 8-bit to 8-bit S-box given by its ( public )
+// 256-entry table -- a drop-in, much faster replacement for running ct_lookup over
+// the table once per byte, which costs 256 ct_eq / ct_select pairs per byte.
+//
+// Each output bit is a Boolean function of the 8 input bits, evaluated as a full
+// multiplexer tree over the table: the 256 leaves ( that output bit of every table
+// entry, as all-zero / all-one plane masks ) are merged pairwise, 8 levels deep, each
+// level selecting on one input bit-plane with a ^ ( ( a ^ b ) & sel ). All 8 output
+// bits share the selector of a level, so they are merged side by side. That is 255
+// 3-operation muxes per output bit per 64 bytes -- about 100 word operations per
+// byte, with no secret-dependent branch or memory access, as every leaf is visited.
+class ct_sbox_bitsliced
+{
+  std::array<uint8_t, 256> table{};
+
+public:
+  constexpr explicit ct_sbox_bitsliced(std::span<const uint8_t, 256> sbox) { std::ranges::copy(sbox, table.begin()); }
+
+  // Evaluates the S-box on one batch of 8 bit-planes, in place.
+  forceinline constexpr void operator()(std::span<uint64_t, CT_BITSLICE_PLANES> planes) const
+  {
+    // level[k][j] holds output bit j of the sub-tree k of the current level.
+    std::array<std::array<uint64_t, CT_BITSLICE_PLANES>, 128> level{};
+
+    uint64_t sel = planes[0];
+    ct_barrier(sel);
+
+    for (size_t k = 0; k < 128; k++) {
+      const uint8_t lo = table[2 * k];
+      const uint8_t hi = table[2 * k + 1];
+
+      for (size_t j = 0; j < CT_BITSLICE_PLANES; j++) {
+        const uint64_t a = -static_cast<uint64_t>((lo >> j) & 1U);
+        const uint64_t b = -static_cast<uint64_t>((hi >> j) & 1U);
+        level[k][j] = a ^ ((a ^ b) & sel);
+      }
+    }
+
+    for (size_t i = 1; i < CT_BITSLICE_PLANES; i++) {
+      sel = planes[i];
+      ct_barrier(sel);
+
+      for (size_t k = 0; k < (size_t{ 128 } >> i); k++) {
+        for (size_t j = 0; j < CT_BITSLICE_PLANES; j++) {
+          const uint64_t a = level[2 * k][j];
+          const uint64_t b = level[2 * k + 1][j];
+          level[k][j] = a ^ ((a ^ b) & sel);
+        }
+      }
+    }
+
+    std::ranges::copy(level[0], planes.begin());
+  }
+
+  // Applies the S-box to every byte of src, writing the results to the equal-length
+  // span dst. dst and src may be the same span.
+  forceinline constexpr void apply(std::span<uint8_t> dst, std::span<const uint8_t> src) const { ct_bitsliced_substitute(*this, dst, src); }
+};
+
+}
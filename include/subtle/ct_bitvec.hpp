@@ -0,0 +1,209 @@
+#pragma once
+#include "subtle.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// Packed bit vectors of secret bits, with word-parallel logical operations and rotation
+// by a secret amount ( BIKE / HQC style quasi-cyclic arithmetic ).
+namespace subtle {
+
+// A vector of BITS secret bits, packed little-endian into 64-bit words: bit i is bit
+// i % 64 of word i / 64. The bits of the last word above BITS -- when BITS is not a
+// multiple of 64 -- are kept zero by every operation, so that whole-word operations,
+// ct_hamming_weight among them, can ignore them.
+//
+// Bit indices given to get / set are public; the bits themselves, and the amount given
+// to ct_rotate, are secret.
+template<size_t BITS>
+  requires(BITS > 0)
+class ct_bitvec
+{
+public:
+  static constexpr size_t word_count = (BITS + 63) / 64;
+
+  // Valid bits of the last word.
+  static constexpr uint64_t top_mask = BITS % 64 == 0 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << (BITS % 64)) - 1;
+
+private:
+  std::array<uint64_t, word_count> bits{};
+
+public:
+  constexpr ct_bitvec() = default;
+
+  // Builds the vector from its packed words, clearing the bits above BITS.
+  constexpr explicit ct_bitvec(std::span<const uint64_t, word_count> words)
+  {
+    std::ranges::copy(words, bits.begin());
+    bits[word_count - 1] &= top_mask;
+  }
+
+  static constexpr size_t size() { return BITS; }
+
+  // The packed words, the bits above BITS of the last one being zero -- writers must
+  // keep them so.
+  constexpr std::span<uint64_t, word_count> words() { return bits; }
+  constexpr std::span<const uint64_t, word_count> words() const { return bits; }
+
+  // Given a public index i < BITS, this routine returns bit i ( 0 or 1 ).
+  constexpr uint64_t get(const size_t i) const { return (bits[i / 64] >> (i % 64)) & 1U; }
+
+  // Given a public index i < BITS and a secret bit ( 0 or 1 ), this routine sets bit i
+  // to bit.
+  constexpr void set(const size_t i, const uint64_t bit)
+  {
+    const uint64_t pos = uint64_t{ 1 } << (i % 64);
+    bits[i / 64] = (bits[i / 64] & ~pos) | ((bit & 1U) << (i % 64));
+  }
+
+  // Number of bits set, with ct_hamming_weight over the words.
+  constexpr size_t weight() const { return ct_hamming_weight(words()); }
+
+  // Word-parallel XOR, AND and OR with another vector, through ct_zip_span -- a whole
+  // AVX2 register of words at a time, when compiled for it.
+  constexpr ct_bitvec& operator^=(const ct_bitvec& other)
+  {
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    const auto avx2_op = [](const __m256i a, const __m256i b) { return _mm256_xor_si256(a, b); };
+#else
+    const auto avx2_op = nullptr;
+#endif
+
+    ct_zip_span(words(), std::as_const(*this).words(), other.words(), [](const uint64_t a, const uint64_t b) { return a ^ b; }, avx2_op);
+    return *this;
+  }
+
+  constexpr ct_bitvec& operator&=(const ct_bitvec& other)
+  {
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    const auto avx2_op = [](const __m256i a, const __m256i b) { return _mm256_and_si256(a, b); };
+#else
+    const auto avx2_op = nullptr;
+#endif
+
+    ct_zip_span(words(), std::as_const(*this).words(), other.words(), [](const uint64_t a, const uint64_t b) { return a & b; }, avx2_op);
+    return *this;
+  }
+
+  constexpr ct_bitvec& operator|=(const ct_bitvec& other)
+  {
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    const auto avx2_op = [](const __m256i a, const __m256i b) { return _mm256_or_si256(a, b); };
+#else
+    const auto avx2_op = nullptr;
+#endif
+
+    ct_zip_span(words(), std::as_const(*this).words(), other.words(), [](const uint64_t a, const uint64_t b) { return a | b; }, avx2_op);
+    return *this;
+  }
+
+  friend constexpr ct_bitvec operator^(ct_bitvec lhs, const ct_bitvec& rhs) { return lhs ^= rhs; }
+  friend constexpr ct_bitvec operator&(ct_bitvec lhs, const ct_bitvec& rhs) { return lhs &= rhs; }
+  friend constexpr ct_bitvec operator|(ct_bitvec lhs, const ct_bitvec& rhs) { return lhs |= rhs; }
+
+  constexpr bool operator==(const ct_bitvec&) const = default;
+};
+
+// One stage of ct_rotate, over word_count words held in the middle third of src and
+// dst, whose outer thirds are zero: the words of the vector rotated by the public amount
+// c ( 0 < c < BITS ), i.e. ( v << c ) | ( v >> ( BITS - c ) ) truncated to BITS bits,
+// are written to dst where mask is all ones, and the words of v itself where it is zero.
+//
+// The zero padding lets every word be computed by the same four loads and shifts, with
+// no bounds to check, and a bit shift of 0 is handled by splitting 64 - s into 1 +
+// ( 63 - s ), so that a register's worth of words at a time is straight-line AVX2 code.
+template<size_t BITS>
+forceinline constexpr void
+ct_rotate_stage(std::span<uint64_t, 3 * ct_bitvec<BITS>::word_count> dst,
+                std::span<const uint64_t, 3 * ct_bitvec<BITS>::word_count> src,
+                const size_t c,
+                const uint64_t mask)
+{
+  constexpr size_t n = ct_bitvec<BITS>::word_count;
+
+  const size_t q1 = c / 64;
+  const size_t s1 = c % 64;
+  const size_t q2 = (BITS - c) / 64;
+  const size_t s2 = (BITS - c) % 64;
+
+  const auto word = [&](const size_t i) {
+    const uint64_t lo = (src[n + i - q1] << s1) | ((src[n + i - q1 - 1] >> 1) >> (63 - s1));
+    const uint64_t hi = (src[n + i + q2] >> s2) | ((src[n + i + q2 + 1] << 1) << (63 - s2));
+    return (mask & (lo | hi)) | (~mask & src[n + i]);
+  };
+
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+    const __m128i vs1 = _mm_cvtsi64_si128(static_cast<long long>(s1));
+    const __m128i vr1 = _mm_cvtsi64_si128(static_cast<long long>(63 - s1));
+    const __m128i vs2 = _mm_cvtsi64_si128(static_cast<long long>(s2));
+    const __m128i vr2 = _mm_cvtsi64_si128(static_cast<long long>(63 - s2));
+
+    const auto load = [&](const size_t j) {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data() + j)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    };
+
+    for (; i + 4 <= n; i += 4) {
+      const __m256i lo = _mm256_or_si256(_mm256_sll_epi64(load(n + i - q1), vs1), _mm256_srl_epi64(_mm256_srli_epi64(load(n + i - q1 - 1), 1), vr1));
+      const __m256i hi = _mm256_or_si256(_mm256_srl_epi64(load(n + i + q2), vs2), _mm256_sll_epi64(_mm256_slli_epi64(load(n + i + q2 + 1), 1), vr2));
+
+      const __m256i rotated = _mm256_or_si256(lo, hi);
+      const __m256i out = _mm256_or_si256(_mm256_and_si256(vmask, rotated), _mm256_andnot_si256(vmask, load(n + i)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data() + n + i), out); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    dst[n + i] = word(i);
+  }
+
+  dst[2 * n - 1] &= ct_bitvec<BITS>::top_mask;
+}
+
+// Given a bit vector vec and a secret amount ( of unsigned type amountT ), this routine
+// rotates vec by amount positions towards the higher indices -- bit i moves to bit
+// ( i + amount ) mod BITS, i.e. vec is multiplied by x^amount modulo x^BITS - 1.
+//
+// This is a barrel shifter: amount is reduced modulo BITS with ct_mod, then for each
+// of its bit_width( BITS - 1 ) bits, the vector is rotated by the matching power of two
+// and the result kept or dropped by a mask. Every stage is the same word-parallel pass
+// whatever the amount, so the cost is O( BITS / 64 * log BITS ) word operations, where
+// selecting among all BITS rotations would be quadratic. The working space -- two
+// buffers of 3 * word_count words -- is on the stack.
+template<size_t BITS, typename amountT>
+forceinline constexpr void
+ct_rotate(ct_bitvec<BITS>& vec, const amountT amount)
+  requires(std::is_unsigned_v<amountT>)
+{
+  constexpr size_t n = ct_bitvec<BITS>::word_count;
+  constexpr size_t stages = static_cast<size_t>(std::bit_width(BITS - 1));
+
+  const uint64_t amt = ct_mod<BITS, uint64_t>(static_cast<uint64_t>(amount));
+
+  std::array<uint64_t, 3 * n> buf_a{};
+  std::array<uint64_t, 3 * n> buf_b{};
+  std::ranges::copy(vec.words(), buf_a.begin() + n);
+
+  std::span<uint64_t, 3 * n> src = buf_a;
+  std::span<uint64_t, 3 * n> dst = buf_b;
+
+  for (size_t k = 0; k < stages; k++) {
+    uint64_t mask = 0U - ((amt >> k) & 1U);
+    ct_barrier(mask);
+
+    ct_rotate_stage<BITS>(dst, src, size_t{ 1 } << k, mask);
+    std::swap(src, dst);
+  }
+
+  std::ranges::copy(src.template subspan<n, n>(), vec.words().begin());
+}
+
+}
@@ -0,0 +1,405 @@
+#pragma once
+#include "subtle.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Hex and Base64 ( RFC 4648, standard and URL-safe alphabets ) encoding and decoding of
+// secrets -- keys in PEM files, hex-encoded seeds in configuration -- without lookup
+// tables: every character is mapped to or from its value by range arithmetic on masks,
+// so neither the memory accessed nor the code path depends on the data, and a decoder
+// reports invalid characters through a secret validity mask, rather than by branching.
+//
+// Lengths are public: that of the encoded text, and hence that of the decoded secret.
+namespace subtle {
+
+// Given a byte c and a public range [lo, hi] of byte values, this routine returns 0xff if
+// lo <= c <= hi, or 0x00 otherwise -- both differences are negative exactly when c is in
+// range, as in ct_lt, and the sign is smeared over the low byte by an arithmetic shift.
+forceinline constexpr uint8_t
+ct_in_range(const uint8_t c, const uint8_t lo, const uint8_t hi)
+{
+  const auto x = static_cast<int32_t>(c);
+  return static_cast<uint8_t>(((lo - 1 - x) & (x - hi - 1)) >> 8);
+}
+
+// Given a 6-bit value v, this routine returns its Base64 character -- 'A' plus v, bumped
+// into the next range of the alphabet once per range boundary v has crossed, each bump
+// masked by a comparison. url_safe picks '-' and '_' over '+' and '/' for 62 and 63.
+template<bool url_safe>
+forceinline constexpr char
+ct_base64_char(const uint8_t v)
+{
+  const auto x = static_cast<int32_t>(v);
+  const auto gt = [&](const int32_t k) { return (k - x) >> 8; }; // all ones if x > k
+
+  int32_t c = x + 'A';
+  c += gt(25) & ('a' - 26 - 'A');
+  c -= gt(51) & ('a' - 26 - ('0' - 52));
+  c -= gt(61) & (('0' - 52) - ((url_safe ? '-' : '+') - 62));
+  c += gt(62) & (((url_safe ? '_' : '/') - 63) - ((url_safe ? '-' : '+') - 62));
+
+  return static_cast<char>(c);
+}
+
+// Given a character c, this routine returns its 6-bit Base64 value, and ORs into bad all
+// ones if it is not in the alphabet -- url_safe selecting '-' and '_' over '+' and '/'.
+template<bool url_safe>
+forceinline constexpr uint8_t
+ct_base64_value(const char c, uint8_t& bad)
+{
+  const auto u = static_cast<uint8_t>(c);
+
+  const uint8_t upper = ct_in_range(u, 'A', 'Z');
+  const uint8_t lower = ct_in_range(u, 'a', 'z');
+  const uint8_t digit = ct_in_range(u, '0', '9');
+  const uint8_t c62 = ct_in_range(u, url_safe ? '-' : '+', url_safe ? '-' : '+');
+  const uint8_t c63 = ct_in_range(u, url_safe ? '_' : '/', url_safe ? '_' : '/');
+
+  bad |= static_cast<uint8_t>(~(upper | lower | digit | c62 | c63));
+  return static_cast<uint8_t>((upper & (u - 'A')) | (lower & (u - 'a' + 26)) | (digit & (u - '0' + 52)) | (c62 & 62U) | (c63 & 63U));
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Byte lanes of c in [lo, hi] -- both bounds printable ASCII, so that the signed compares
+// leave bytes 0x80 and above out of every range.
+forceinline __m256i
+ct_in_range_avx2(const __m256i c, const char lo, const char hi)
+{
+  return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(static_cast<char>(lo - 1))), _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), c));
+}
+
+// ct_base64_char over 32 6-bit values at a time.
+template<bool url_safe>
+forceinline __m256i
+ct_base64_chars_avx2(const __m256i v)
+{
+  const auto gt = [&](const char k) { return _mm256_cmpgt_epi8(v, _mm256_set1_epi8(k)); };
+  const auto bump = [](const __m256i mask, const int32_t d) { return _mm256_and_si256(mask, _mm256_set1_epi8(static_cast<char>(d))); };
+
+  __m256i c = _mm256_add_epi8(v, _mm256_set1_epi8('A'));
+  c = _mm256_add_epi8(c, bump(gt(25), 'a' - 26 - 'A'));
+  c = _mm256_sub_epi8(c, bump(gt(51), 'a' - 26 - ('0' - 52)));
+  c = _mm256_sub_epi8(c, bump(gt(61), ('0' - 52) - ((url_safe ? '-' : '+') - 62)));
+  c = _mm256_add_epi8(c, bump(gt(62), ((url_safe ? '_' : '/') - 63) - ((url_safe ? '-' : '+') - 62)));
+
+  return c;
+}
+
+// ct_base64_value over 32 characters at a time, ORing into bad all ones in the lanes of
+// characters out of the alphabet.
+template<bool url_safe>
+forceinline __m256i
+ct_base64_values_avx2(const __m256i c, __m256i& bad)
+{
+  const __m256i upper = ct_in_range_avx2(c, 'A', 'Z');
+  const __m256i lower = ct_in_range_avx2(c, 'a', 'z');
+  const __m256i digit = ct_in_range_avx2(c, '0', '9');
+  const __m256i c62 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(url_safe ? '-' : '+'));
+  const __m256i c63 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(url_safe ? '_' : '/'));
+
+  const __m256i any = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, c62)), c63);
+  bad = _mm256_or_si256(bad, _mm256_xor_si256(any, _mm256_set1_epi8(-1)));
+
+  __m256i v = _mm256_and_si256(upper, _mm256_sub_epi8(c, _mm256_set1_epi8('A')));
+  v = _mm256_or_si256(v, _mm256_and_si256(lower, _mm256_sub_epi8(c, _mm256_set1_epi8('a' - 26))));
+  v = _mm256_or_si256(v, _mm256_and_si256(digit, _mm256_add_epi8(c, _mm256_set1_epi8(52 - '0'))));
+  v = _mm256_or_si256(v, _mm256_and_si256(c62, _mm256_set1_epi8(62)));
+  v = _mm256_or_si256(v, _mm256_and_si256(c63, _mm256_set1_epi8(63)));
+
+  return v;
+}
+
+#endif
+
+// Given a span in of n bytes and a span out of 2n characters, this routine writes the
+// lowercase hex encoding of in to out. A nibble x maps to '0' + x, plus 'a' - '0' - 10
+// where x > 9 -- with AVX2, 32 bytes to 64 characters at a time.
+template<size_t M, size_t N>
+forceinline constexpr void
+ct_hex_encode(std::span<char, M> out, std::span<const uint8_t, N> in)
+{
+  const auto hex = [](const uint32_t x) { return static_cast<char>(x + '0' + ((static_cast<uint32_t>(static_cast<int32_t>(9 - x) >> 8)) & ('a' - '0' - 10))); };
+
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const auto ascii = [](const __m256i x) {
+      const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8(9)), _mm256_set1_epi8('a' - '0' - 10));
+      return _mm256_add_epi8(_mm256_add_epi8(x, _mm256_set1_epi8('0')), letter);
+    };
+
+    for (; i + 32 <= in.size(); i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const __m256i hi = ascii(_mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+      const __m256i lo = ascii(_mm256_and_si256(v, nibble));
+
+      // Interleaving within 128-bit lanes yields bytes 0..7 and 16..23, then 8..15 and 24..31
+      const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+      const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+
+      auto* dst = reinterpret_cast<__m256i*>(out.data() + 2 * i); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm256_storeu_si256(dst, _mm256_permute2x128_si256(a, b, 0x20));
+      _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(a, b, 0x31)); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    out[2 * i] = hex(static_cast<uint32_t>(in[i] >> 4));
+    out[2 * i + 1] = hex(static_cast<uint32_t>(in[i] & 0x0fU));
+  }
+}
+
+// Given a span in of 2n hex characters, of either case, and a span out of n bytes, this
+// routine decodes in into out, returning truth value ( all bits of returnT set ) if every
+// character is a hex digit, or false value ( all bits zero ) otherwise -- in which case
+// out holds garbage. An odd-length in is rejected outright, being public. With AVX2, 32
+// characters to 16 bytes at a time, pairs of nibbles being joined by vpmaddubsw.
+template<typename returnT, size_t M, size_t N>
+forceinline constexpr returnT
+ct_hex_decode(std::span<uint8_t, M> out, std::span<const char, N> in)
+  requires(std::is_unsigned_v<returnT>)
+{
+  if (in.size() != 2 * out.size()) {
+    return returnT{ 0 };
+  }
+
+  uint8_t bad = 0;
+  const auto nibble = [&](const char c) {
+    const auto u = static_cast<uint8_t>(c);
+    const auto l = static_cast<uint8_t>(u | 0x20U);
+
+    const uint8_t digit = ct_in_range(u, '0', '9');
+    const uint8_t alpha = ct_in_range(l, 'a', 'f');
+
+    bad |= static_cast<uint8_t>(~(digit | alpha));
+    return static_cast<uint8_t>((digit & (u - '0')) | (alpha & (l - 'a' + 10)));
+  };
+
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    __m256i badv = _mm256_setzero_si256();
+
+    for (; i + 16 <= out.size(); i += 16) {
+      const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + 2 * i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const __m256i l = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+
+      const __m256i digit = ct_in_range_avx2(c, '0', '9');
+      const __m256i alpha = ct_in_range_avx2(l, 'a', 'f');
+      badv = _mm256_or_si256(badv, _mm256_xor_si256(_mm256_or_si256(digit, alpha), _mm256_set1_epi8(-1)));
+
+      const __m256i v = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                                        _mm256_and_si256(alpha, _mm256_sub_epi8(l, _mm256_set1_epi8('a' - 10))));
+
+      // 16 * high + low nibble in each 16-bit lane, then packed to bytes in both 128-bit
+      // lanes, whose low halves are gathered
+      const __m256i w = _mm256_maddubs_epi16(v, _mm256_set1_epi16(0x0110));
+      const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(w, w), 0b1000);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), _mm256_castsi256_si128(packed)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    const uint64_t any = ct_hreduce_avx2<uint64_t>(badv, [](const __m256i a, const __m256i b) { return _mm256_or_si256(a, b); });
+    bad = static_cast<uint8_t>(~ct_is_zero<uint64_t, uint8_t>(any));
+  }
+#endif
+
+  for (; i < out.size(); i++) {
+    const uint8_t hi = nibble(in[2 * i]);
+    const uint8_t lo = nibble(in[2 * i + 1]);
+    out[i] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+
+  return ct_is_zero<uint8_t, returnT>(bad);
+}
+
+// Number of Base64 characters encoding n bytes: padded with '=' to a multiple of four in
+// the standard alphabet, unpadded in the URL-safe one.
+template<bool url_safe = false>
+constexpr size_t
+ct_base64_encoded_size(const size_t n)
+{
+  if constexpr (url_safe) {
+    return n / 3 * 4 + (n % 3 == 0 ? 0 : n % 3 + 1);
+  } else {
+    return (n + 2) / 3 * 4;
+  }
+}
+
+// Number of bytes encoded by the Base64 text in, which must be well-formed for the result
+// to be meaningful. In the standard alphabet this looks at whether in ends in '=' -- which
+// is as public as the length of the decoded secret, that it tells.
+template<bool url_safe = false, size_t N>
+constexpr size_t
+ct_base64_decoded_size(std::span<const char, N> in)
+{
+  if constexpr (url_safe) {
+    return in.size() / 4 * 3 + (in.size() % 4 == 0 ? 0 : in.size() % 4 - 1);
+  } else {
+    const size_t n = in.size();
+    const size_t pad = static_cast<size_t>(n >= 1 && in[n - 1] == '=') + static_cast<size_t>(n >= 2 && in[n - 2] == '=');
+    return n / 4 * 3 - std::min(pad, n / 4 * 3);
+  }
+}
+
+// Given a span in of n bytes and a span out of ct_base64_encoded_size< url_safe >( n )
+// characters, this routine writes the Base64 encoding of in to out -- in the standard
+// alphabet, with '=' padding, or, if url_safe, in the URL-safe one, without.
+//
+// Each 6-bit value is mapped by ct_base64_char. With AVX2, 24 bytes make 32 characters at
+// a time: vpshufb spreads each 3-byte group over a 32-bit lane, a multiply-high and a
+// multiply-low shift its four 6-bit fields into bytes, and the arithmetic mapping runs on
+// all 32 at once.
+template<bool url_safe = false, size_t M, size_t N>
+forceinline constexpr void
+ct_base64_encode(std::span<char, M> out, std::span<const uint8_t, N> in)
+{
+  size_t i = 0;
+  size_t o = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    // Two 16-byte loads, at i and i + 12, put a 12-byte half of the 24 in each 128-bit lane
+    for (; i + 28 <= in.size(); i += 24, o += 32) {
+      const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));      // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i + 12)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const __m256i v = _mm256_shuffle_epi8(_mm256_set_m128i(hi, lo), spread);
+
+      const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+      const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+
+      const __m256i chars = ct_base64_chars_avx2<url_safe>(_mm256_or_si256(t0, t1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data() + o), chars); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+  }
+#endif
+
+  for (; i + 3 <= in.size(); i += 3, o += 4) {
+    const uint32_t w = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+
+    out[o] = ct_base64_char<url_safe>(static_cast<uint8_t>(w >> 18));
+    out[o + 1] = ct_base64_char<url_safe>(static_cast<uint8_t>((w >> 12) & 63U));
+    out[o + 2] = ct_base64_char<url_safe>(static_cast<uint8_t>((w >> 6) & 63U));
+    out[o + 3] = ct_base64_char<url_safe>(static_cast<uint8_t>(w & 63U));
+  }
+
+  // A last group of one or two bytes, whose count is public
+  const size_t rest = in.size() - i;
+  if (rest > 0) {
+    const uint32_t w = (static_cast<uint32_t>(in[i]) << 16) | (rest == 2 ? static_cast<uint32_t>(in[i + 1]) << 8 : 0U);
+
+    out[o] = ct_base64_char<url_safe>(static_cast<uint8_t>(w >> 18));
+    out[o + 1] = ct_base64_char<url_safe>(static_cast<uint8_t>((w >> 12) & 63U));
+    if (rest == 2) {
+      out[o + 2] = ct_base64_char<url_safe>(static_cast<uint8_t>((w >> 6) & 63U));
+    }
+
+    if constexpr (!url_safe) {
+      if (rest == 1) {
+        out[o + 2] = '=';
+      }
+      out[o + 3] = '=';
+    }
+  }
+}
+
+// Given a span in of Base64 characters and a span out of ct_base64_decoded_size< url_safe >(
+// in ) bytes, this routine decodes in into out, returning truth value ( all bits of
+// returnT set ) if in is a canonical encoding -- every character in the alphabet, '='
+// padding where, and only where, the standard alphabet wants it, and the unused low bits
+// of the last character zero -- or false value ( all bits zero ) otherwise, in which case
+// out holds garbage. Lengths that no encoding has are rejected outright, being public.
+//
+// Each character is mapped by ct_base64_value. With AVX2, 32 characters make 24 bytes
+// at a time: the values are mapped by range masks on all 32 at once, then vpmaddubsw and
+// vpmaddwd join them into 24-bit groups, which vpshufb and vpermd pack together.
+template<typename returnT, bool url_safe = false, size_t M, size_t N>
+forceinline constexpr returnT
+ct_base64_decode(std::span<uint8_t, M> out, std::span<const char, N> in)
+  requires(std::is_unsigned_v<returnT>)
+{
+  const size_t n = in.size();
+  const size_t rest = out.size() % 3;
+
+  // The last, partial group spans rest + 1 characters, and the full groups 4 each
+  const size_t body = out.size() / 3 * 4;
+  const size_t tail = rest == 0 ? 0 : rest + 1;
+  const size_t expected = url_safe || rest == 0 ? body + tail : body + 4;
+  if (n != expected) {
+    return returnT{ 0 };
+  }
+
+  uint8_t bad = 0;
+  size_t i = 0;
+  size_t o = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    __m256i badv = _mm256_setzero_si256();
+
+    for (; i + 32 <= body; i += 32, o += 24) {
+      const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const __m256i v = ct_base64_values_avx2<url_safe>(c, badv);
+
+      const __m256i pairs = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+      const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+      const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(groups, pack), gather);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + o), _mm256_castsi256_si128(bytes));                 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out.data() + o + 16), _mm256_extracti128_si256(bytes, 1)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    const uint64_t any = ct_hreduce_avx2<uint64_t>(badv, [](const __m256i a, const __m256i b) { return _mm256_or_si256(a, b); });
+    bad = static_cast<uint8_t>(~ct_is_zero<uint64_t, uint8_t>(any));
+  }
+#endif
+
+  for (; i < body; i += 4, o += 3) {
+    const uint32_t w = (static_cast<uint32_t>(ct_base64_value<url_safe>(in[i], bad)) << 18) | (static_cast<uint32_t>(ct_base64_value<url_safe>(in[i + 1], bad)) << 12) |
+                       (static_cast<uint32_t>(ct_base64_value<url_safe>(in[i + 2], bad)) << 6) | ct_base64_value<url_safe>(in[i + 3], bad);
+
+    out[o] = static_cast<uint8_t>(w >> 16);
+    out[o + 1] = static_cast<uint8_t>(w >> 8);
+    out[o + 2] = static_cast<uint8_t>(w);
+  }
+
+  // A last group of rest + 1 characters, padded with '=' to four in the standard alphabet.
+  // The bits below the rest bytes must be zero for the encoding to be canonical.
+  if (rest > 0) {
+    uint32_t w = (static_cast<uint32_t>(ct_base64_value<url_safe>(in[i], bad)) << 18) | (static_cast<uint32_t>(ct_base64_value<url_safe>(in[i + 1], bad)) << 12);
+    if (rest == 2) {
+      w |= static_cast<uint32_t>(ct_base64_value<url_safe>(in[i + 2], bad)) << 6;
+    }
+
+    const uint32_t unused = rest == 1 ? 0xffffU : 0xffU;
+    bad |= static_cast<uint8_t>(~ct_is_zero<uint32_t, uint8_t>(w & unused));
+
+    if constexpr (!url_safe) {
+      if (rest == 1) {
+        bad |= static_cast<uint8_t>(~ct_eq<uint8_t, uint8_t>(static_cast<uint8_t>(in[i + 2]), '='));
+      }
+      bad |= static_cast<uint8_t>(~ct_eq<uint8_t, uint8_t>(static_cast<uint8_t>(in[i + 3]), '='));
+    }
+
+    out[o] = static_cast<uint8_t>(w >> 16);
+    if (rest == 2) {
+      out[o + 1] = static_cast<uint8_t>(w >> 8);
+    }
+  }
+
+  return ct_is_zero<uint8_t, returnT>(bad);
+}
+
+}
@@ -0,0 +1,394 @@
+#pragma once
+#include "subtle.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Arithmetic in the binary fields GF(2^m), 2 <= m <= 13, on secret elements -- Shamir
+// secret sharing and Reed-Solomon codes over GF(2^8), Goppa codes ( Classic McEliece )
+// over GF(2^12) and GF(2^13) -- without log / antilog tables: a product is computed by
+// shift-and-add, each step's conditional XOR taken under a mask, so that neither the code
+// path nor the memory accessed depends on the operands.
+//
+// An element is an unsigned integer of at least m bits, whose bit i is the coefficient of
+// x^i; the field is given by its irreducible polynomial poly, of degree m, bit m set --
+// e.g. 0x11b, x^8 + x^4 + x^3 + x + 1 ( AES ), or 0x11d, x^8 + x^4 + x^3 + x^2 + 1 ( the
+// common Reed-Solomon choice ). Operands must be reduced, i.e. below 2^m.
+//
+// With GFNI, GF(2^8) under the AES polynomial is multiplied by gf2p8mulb; with PCLMULQDQ,
+// other fields get a carry-less multiply and a Barrett reduction. Like AVX2, both are
+// chosen when compiling, e.g. with -mgfni / -mpclmul or -march=native.
+#if defined(SUBTLE_AVX2_ACTIVE_) && defined(__GFNI__)
+#define SUBTLE_GFNI_ACTIVE_
+#endif
+#if defined(SUBTLE_AVX2_ACTIVE_) && defined(__PCLMUL__)
+#define SUBTLE_PCLMUL_ACTIVE_
+#endif
+
+namespace subtle {
+
+// Whether poly is a polynomial of degree m, irreducible over GF(2) -- no polynomial of
+// degree 1 to m / 2 divides it -- so that it defines the field GF(2^m).
+consteval bool
+ct_gf_irreducible(const size_t m, const uint32_t poly)
+{
+  if ((poly >> m) != 1U) {
+    return false;
+  }
+
+  for (uint32_t d = 2; d < (1U << (m / 2 + 1)); d++) {
+    const size_t deg = static_cast<size_t>(std::bit_width(d)) - 1;
+
+    uint32_t r = poly;
+    for (size_t i = m + 1; i-- > deg;) {
+      if ((r >> i) & 1U) {
+        r ^= d << (i - deg);
+      }
+    }
+    if (r == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Parameters of a field GF(2^m) accepted by the routines below, with elements of type
+// operandT -- uint8_t for m <= 8, or uint16_t.
+template<size_t m, uint32_t poly, typename operandT>
+concept ct_gf_field = std::is_unsigned_v<operandT> && (sizeof(operandT) <= 2) && (m >= 2) && (m <= 13) && (m <= 8 * sizeof(operandT)) && ct_gf_irreducible(m, poly);
+
+// floor( x^(2m) / poly ), the Barrett constant of the reduction modulo poly.
+consteval uint32_t
+ct_gf_barrett_constant(const size_t m, const uint32_t poly)
+{
+  uint32_t r = uint32_t{ 1 } << (2 * m);
+  uint32_t q = 0;
+  for (size_t i = 2 * m + 1; i-- > m;) {
+    if ((r >> i) & 1U) {
+      r ^= poly << (i - m);
+      q |= uint32_t{ 1 } << (i - m);
+    }
+  }
+  return q;
+}
+
+#if defined(SUBTLE_PCLMUL_ACTIVE_)
+
+// Carry-less product of a and b, each below 2^16.
+forceinline uint32_t
+ct_clmul32(const uint32_t a, const uint32_t b)
+{
+  const __m128i p = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int32_t>(a)), _mm_cvtsi32_si128(static_cast<int32_t>(b)), 0x00);
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(p));
+}
+
+#endif
+
+// Given two elements a and b of GF(2^m), this routine returns their product modulo poly.
+//
+// Per bit i of b, a * x^i is added under the mask of that bit, and a * x^i is stepped to
+// a * x^(i + 1) by a shift, poly being subtracted under the mask of the bit shifted out.
+template<size_t m, uint32_t poly, typename operandT>
+forceinline constexpr operandT
+ct_gf_mul(const operandT a, const operandT b)
+  requires(ct_gf_field<m, poly, operandT>)
+{
+#if defined(SUBTLE_GFNI_ACTIVE_)
+  if constexpr (m == 8 && poly == 0x11b) {
+    if (!std::is_constant_evaluated()) {
+      const __m128i p = _mm_gf2p8mul_epi8(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b));
+      return static_cast<operandT>(_mm_cvtsi128_si32(p));
+    }
+  }
+#endif
+
+#if defined(SUBTLE_PCLMUL_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    // p has degree at most 2m - 2, so the Barrett quotient is exact
+    constexpr uint32_t mu = ct_gf_barrett_constant(m, poly);
+    const uint32_t p = ct_clmul32(a, b);
+    const uint32_t q = ct_clmul32(p >> m, mu) >> m;
+    return static_cast<operandT>((p ^ ct_clmul32(q, poly)) & ((uint32_t{ 1 } << m) - 1U));
+  }
+#endif
+
+  uint32_t x = a;
+  uint32_t r = 0;
+  for (size_t i = 0; i < m; i++) {
+    uint32_t bit = 0U - ((static_cast<uint32_t>(b) >> i) & 1U);
+    uint32_t carry = 0U - ((x >> (m - 1)) & 1U);
+    ct_barrier(bit);
+    ct_barrier(carry);
+
+    r ^= x & bit;
+    x = (x << 1) ^ (poly & carry);
+  }
+
+  return static_cast<operandT>(r);
+}
+
+// Given an element a of GF(2^m), this routine returns its multiplicative inverse, or
+// zero if a is zero, as a^(2^m - 2) -- computed with a fixed sequence of m - 1 squarings
+// and m - 2 multiplications, whatever a.
+template<size_t m, uint32_t poly, typename operandT>
+forceinline constexpr operandT
+ct_gf_inv(const operandT a)
+  requires(ct_gf_field<m, poly, operandT>)
+{
+  // 2^m - 2 = 2 + 4 + ... + 2^(m - 1): r accumulates a^(2^i) for i = 1 .. m - 1
+  operandT t = ct_gf_mul<m, poly>(a, a);
+  operandT r = t;
+  for (size_t i = 2; i < m; i++) {
+    t = ct_gf_mul<m, poly>(t, t);
+    r = ct_gf_mul<m, poly>(r, t);
+  }
+  return r;
+}
+
+// ct_gf_mul and ct_gf_inv in GF(2^8), by default under the AES polynomial.
+template<uint32_t poly = 0x11b>
+forceinline constexpr uint8_t
+ct_gf256_mul(const uint8_t a, const uint8_t b)
+  requires(ct_gf_field<8, poly, uint8_t>)
+{
+  return ct_gf_mul<8, poly>(a, b);
+}
+
+template<uint32_t poly = 0x11b>
+forceinline constexpr uint8_t
+ct_gf256_inv(const uint8_t a)
+  requires(ct_gf_field<8, poly, uint8_t>)
+{
+  return ct_gf_inv<8, poly>(a);
+}
+
+// ct_gf_mul over the elements packed into the 8 / sizeof( operandT ) lanes of two 64-bit
+// words -- the same shift-and-add, with per-lane masks, the bit shifted out of a lane
+// being cleared from the bottom of the next -- so that the span routines below multiply
+// a word of elements at a time where AVX2 is not available, or past its last block.
+template<size_t m, uint32_t poly, typename operandT>
+forceinline constexpr uint64_t
+ct_gf_mul_swar(uint64_t a, const uint64_t b)
+  requires(ct_gf_field<m, poly, operandT>)
+{
+  constexpr uint64_t lane = (uint64_t{ 1 } << (8 * sizeof(operandT))) - 1U;
+  constexpr uint64_t ones = ~uint64_t{ 0 } / lane;
+  constexpr uint64_t reduce = poly & lane;
+
+  uint64_t r = 0;
+  for (size_t i = 0; i < m; i++) {
+    r ^= a & (((b >> i) & ones) * lane);
+    a = ((a << 1) & ~ones) ^ (((a >> (m - 1)) & ones) * reduce);
+  }
+
+  return r;
+}
+
+// Packs the 8 / sizeof( operandT ) elements from index i of a span into a word, and back
+// -- in whatever lane order bit_cast gives, as the operations on words are elementwise.
+template<typename operandT, size_t N>
+forceinline constexpr uint64_t
+ct_gf_load_swar(std::span<const operandT, N> s, const size_t i)
+{
+  std::array<operandT, sizeof(uint64_t) / sizeof(operandT)> lanes{};
+  std::ranges::copy(s.subspan(i, lanes.size()), lanes.begin());
+  return std::bit_cast<uint64_t>(lanes);
+}
+
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_gf_store_swar(std::span<operandT, N> s, const size_t i, const uint64_t w)
+{
+  const auto lanes = std::bit_cast<std::array<operandT, sizeof(uint64_t) / sizeof(operandT)>>(w);
+  std::ranges::copy(lanes, s.subspan(i, lanes.size()).begin());
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// ct_gf_mul over the 8- or 16-bit lanes of two AVX2 registers -- gf2p8mulb, when it
+// applies, or shift-and-add under lane masks.
+template<size_t m, uint32_t poly, typename operandT>
+forceinline __m256i
+ct_gf_mul_avx2(__m256i a, const __m256i b)
+{
+#if defined(SUBTLE_GFNI_ACTIVE_)
+  if constexpr (sizeof(operandT) == 1 && m == 8 && poly == 0x11b) {
+    return _mm256_gf2p8mul_epi8(a, b);
+  }
+#endif
+
+  const __m256i reduce = ct_broadcast_avx2<operandT>(static_cast<operandT>(poly));
+  const __m256i top = ct_broadcast_avx2<operandT>(static_cast<operandT>(1U << (m - 1)));
+
+  __m256i r = _mm256_setzero_si256();
+  for (size_t i = 0; i < m; i++) {
+    const __m256i bit = ct_broadcast_avx2<operandT>(static_cast<operandT>(1U << i));
+    r = _mm256_xor_si256(r, _mm256_and_si256(a, ct_eq_avx2<operandT>(_mm256_and_si256(b, bit), bit)));
+
+    const __m256i carry = ct_eq_avx2<operandT>(_mm256_and_si256(a, top), top);
+    const __m256i twice = sizeof(operandT) == 1 ? _mm256_add_epi8(a, a) : _mm256_add_epi16(a, a);
+    a = _mm256_xor_si256(twice, _mm256_and_si256(carry, reduce));
+  }
+
+  return r;
+}
+
+#endif
+
+// Given spans a and b of GF(2^m) elements and a span dst of the same size, this routine
+// writes the elementwise products a[i] * b[i] to dst -- 32 bytes of elements at a time
+// with AVX2.
+template<size_t m, uint32_t poly, typename operandT, size_t N>
+forceinline constexpr void
+ct_gf_mul_span(std::span<operandT, N> dst, std::span<const operandT, N> a, std::span<const operandT, N> b)
+  requires(ct_gf_field<m, poly, operandT>)
+{
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    for (; i + lanes <= dst.size(); i += lanes) {
+      const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data() + i), ct_gf_mul_avx2<m, poly, operandT>(va, vb)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+  }
+#endif
+
+  constexpr size_t per_word = sizeof(uint64_t) / sizeof(operandT);
+  for (; i + per_word <= dst.size(); i += per_word) {
+    ct_gf_store_swar(dst, i, ct_gf_mul_swar<m, poly, operandT>(ct_gf_load_swar(a, i), ct_gf_load_swar(b, i)));
+  }
+
+  for (; i < dst.size(); i++) {
+    dst[i] = ct_gf_mul<m, poly>(a[i], b[i]);
+  }
+}
+
+// Given a span acc and a span src of GF(2^m) elements, of the same size, and an element
+// c, this routine adds c * src[i] to each acc[i] -- the multiply-accumulate step of
+// Reed-Solomon encoding, of a matrix-vector product, or of Lagrange interpolation.
+//
+// With AVX2, over GF(2^8) and its subfields, c is multiplied by each nibble value once,
+// into two 16-entry tables held in registers, and each product is then two vpshufb
+// lookups of the nibbles of src[i] -- in-register, so of constant time, unlike a table
+// in memory -- or a single gf2p8mulb with GFNI, under the AES polynomial. Wider elements
+// are multiplied 16 to a register by shift-and-add.
+template<size_t m, uint32_t poly, typename operandT, size_t N>
+forceinline constexpr void
+ct_gf_muladd_span(std::span<operandT, N> acc, std::span<const operandT, N> src, const operandT c)
+  requires(ct_gf_field<m, poly, operandT>)
+{
+  size_t i = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+    const __m256i vc = ct_broadcast_avx2<operandT>(c);
+
+    // Products by the low and by the high nibble of each byte, unless gf2p8mulb applies
+    auto product = [&](const __m256i v) { return ct_gf_mul_avx2<m, poly, operandT>(vc, v); };
+    if constexpr (sizeof(operandT) == 1) {
+      const __m256i nibbles = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+      const __m256i lo_tab = ct_gf_mul_avx2<m, poly, operandT>(vc, nibbles);
+      const __m256i hi_tab = ct_gf_mul_avx2<m, poly, operandT>(vc, _mm256_slli_epi16(nibbles, 4));
+      const __m256i low = _mm256_set1_epi8(0x0f);
+
+      for (; i + lanes <= acc.size(); i += lanes) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* dst = reinterpret_cast<__m256i*>(acc.data() + i);                                   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        __m256i p{};
+#if defined(SUBTLE_GFNI_ACTIVE_)
+        if constexpr (m == 8 && poly == 0x11b) {
+          p = product(v);
+        } else
+#endif
+        {
+          const __m256i lo = _mm256_shuffle_epi8(lo_tab, _mm256_and_si256(v, low));
+          const __m256i hi = _mm256_shuffle_epi8(hi_tab, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+          p = _mm256_xor_si256(lo, hi);
+        }
+
+        _mm256_storeu_si256(dst, _mm256_xor_si256(_mm256_loadu_si256(dst), p));
+      }
+    } else {
+      for (; i + lanes <= acc.size(); i += lanes) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data() + i)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* dst = reinterpret_cast<__m256i*>(acc.data() + i);                                   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm256_storeu_si256(dst, _mm256_xor_si256(_mm256_loadu_si256(dst), product(v)));
+      }
+    }
+  }
+#endif
+
+  constexpr size_t per_word = sizeof(uint64_t) / sizeof(operandT);
+  const uint64_t cs = c * (~uint64_t{ 0 } / ((uint64_t{ 1 } << (8 * sizeof(operandT))) - 1U));
+  for (; i + per_word <= acc.size(); i += per_word) {
+    const uint64_t p = ct_gf_mul_swar<m, poly, operandT>(cs, ct_gf_load_swar(src, i));
+    ct_gf_store_swar(acc, i, ct_gf_load_swar(std::span<const operandT, N>(acc), i) ^ p);
+  }
+
+  for (; i < acc.size(); i++) {
+    acc[i] ^= ct_gf_mul<m, poly>(c, src[i]);
+  }
+}
+
+// Given a polynomial f over GF(2^m) by its coefficients, constant term first, and spans
+// xs and ys of the same size, this routine writes f( xs[j] ) to each ys[j] -- e.g. the
+// shares f( 1 ), f( 2 ), ... of a Shamir secret f( 0 ), the coefficients being secret --
+// by Horner's rule, one elementwise multiply-add per coefficient, over 32 bytes of points
+// at a time with AVX2.
+template<size_t m, uint32_t poly, typename operandT, size_t N, size_t K>
+forceinline constexpr void
+ct_gf_poly_eval(std::span<operandT, N> ys, std::span<const operandT, N> xs, std::span<const operandT, K> coeffs)
+  requires(ct_gf_field<m, poly, operandT>)
+{
+  size_t j = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    for (; j + lanes <= ys.size(); j += lanes) {
+      const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs.data() + j)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      __m256i y = _mm256_setzero_si256();
+      for (size_t k = coeffs.size(); k-- > 0;) {
+        y = _mm256_xor_si256(ct_gf_mul_avx2<m, poly, operandT>(y, x), ct_broadcast_avx2<operandT>(coeffs[k]));
+      }
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(ys.data() + j), y); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+  }
+#endif
+
+  constexpr size_t per_word = sizeof(uint64_t) / sizeof(operandT);
+  constexpr uint64_t ones = ~uint64_t{ 0 } / ((uint64_t{ 1 } << (8 * sizeof(operandT))) - 1U);
+  for (; j + per_word <= ys.size(); j += per_word) {
+    const uint64_t x = ct_gf_load_swar(xs, j);
+
+    uint64_t y = 0;
+    for (size_t k = coeffs.size(); k-- > 0;) {
+      y = ct_gf_mul_swar<m, poly, operandT>(y, x) ^ (coeffs[k] * ones);
+    }
+    ct_gf_store_swar(ys, j, y);
+  }
+
+  for (; j < ys.size(); j++) {
+    operandT y = 0;
+    for (size_t k = coeffs.size(); k-- > 0;) {
+      y = static_cast<operandT>(ct_gf_mul<m, poly>(y, xs[j]) ^ coeffs[k]);
+    }
+    ys[j] = y;
+  }
+}
+
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include "subtle.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+// Constant-time normalization of lattice polynomial coefficients ( Kyber, Dilithium,
+// Falcon ... ) into their canonical or centered range.
+namespace subtle {
+
+// A coefficient type accepted by the routines below: the signed 16 and 32-bit
+// integers, in which Kyber / Falcon and Dilithium keep their polynomials.
+template<typename T>
+concept ct_coeff = std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t>;
+
+// Given a coefficient x and the modulus q, this routine returns x + q if x is
+// negative, otherwise x, the sign deciding through a mask.
+template<typename coeffT>
+forceinline constexpr coeffT
+ct_cond_add_if_negative(const coeffT x, const coeffT q)
+  requires(ct_coeff<coeffT>)
+{
+  using Uop = std::make_unsigned_t<coeffT>;
+
+  Uop mask = static_cast<Uop>(0U - static_cast<Uop>(static_cast<Uop>(x) >> (std::numeric_limits<Uop>::digits - 1)));
+  ct_barrier(mask);
+
+  return static_cast<coeffT>(static_cast<Uop>(x) + static_cast<Uop>(static_cast<Uop>(q) & mask));
+}
+
+// Given a coefficient x in [-q, 2q) and the modulus q ( 0 < q < 2^( W - 2 ), W being
+// the bit width of coeffT ), this routine returns the canonical representative of x
+// modulo q, in [0, q) -- conditionally adding q if x is negative, then subtracting q
+// unless that would make it negative. That input range covers what Montgomery and
+// Barrett reductions leave behind.
+template<typename coeffT>
+forceinline constexpr coeffT
+ct_freeze_mod(const coeffT x, const coeffT q)
+  requires(ct_coeff<coeffT>)
+{
+  const coeffT y = ct_cond_add_if_negative(x, q);
+  return ct_cond_add_if_negative(static_cast<coeffT>(y - q), q);
+}
+
+// Given a coefficient x in [0, q) and the modulus q ( 0 < q < 2^( W - 2 ) ), this
+// routine returns the centered representative of x modulo q, i.e. x - q if x is
+// above floor( q / 2 ), otherwise x. For odd q the result is in [-( q - 1 ) / 2,
+// ( q - 1 ) / 2 ], as Dilithium's power2round / decompose and norm checks expect.
+template<typename coeffT>
+forceinline constexpr coeffT
+ct_center(const coeffT x, const coeffT q)
+  requires(ct_coeff<coeffT>)
+{
+  // floor( q / 2 ) - x is negative exactly when x is above floor( q / 2 )
+  const auto t = static_cast<coeffT>(q / 2 - x);
+  return static_cast<coeffT>(x - (ct_cond_add_if_negative(t, q) - t));
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Lane-wise ct_cond_add_if_negative, for 16 int16_t or 8 int32_t coefficients: the
+// arithmetic right shift of each lane by W - 1 is its sign mask.
+template<typename coeffT>
+forceinline __m256i
+ct_cond_add_if_negative_avx2(const __m256i x, const __m256i q)
+  requires(ct_coeff<coeffT>)
+{
+  if constexpr (sizeof(coeffT) == 2) {
+    return _mm256_add_epi16(x, _mm256_and_si256(_mm256_srai_epi16(x, 15), q));
+  } else {
+    return _mm256_add_epi32(x, _mm256_and_si256(_mm256_srai_epi32(x, 31), q));
+  }
+}
+
+// Lane-wise ct_freeze_mod.
+template<typename coeffT>
+forceinline __m256i
+ct_freeze_mod_avx2(const __m256i x, const __m256i q)
+  requires(ct_coeff<coeffT>)
+{
+  const __m256i y = ct_cond_add_if_negative_avx2<coeffT>(x, q);
+
+  if constexpr (sizeof(coeffT) == 2) {
+    return ct_cond_add_if_negative_avx2<coeffT>(_mm256_sub_epi16(y, q), q);
+  } else {
+    return ct_cond_add_if_negative_avx2<coeffT>(_mm256_sub_epi32(y, q), q);
+  }
+}
+
+// Lane-wise ct_center, half holding floor( q / 2 ) in every lane.
+template<typename coeffT>
+forceinline __m256i
+ct_center_avx2(const __m256i x, const __m256i q, const __m256i half)
+  requires(ct_coeff<coeffT>)
+{
+  if constexpr (sizeof(coeffT) == 2) {
+    return _mm256_sub_epi16(x, _mm256_and_si256(_mm256_cmpgt_epi16(x, half), q));
+  } else {
+    return _mm256_sub_epi32(x, _mm256_and_si256(_mm256_cmpgt_epi32(x, half), q));
+  }
+}
+
+#endif
+
+// Given a span vals of coefficients and the modulus q, this routine adds q to every
+// negative coefficient, using ct_cond_add_if_negative -- with AVX2, 16 int16_t or 8
+// int32_t coefficients at a time, a whole 256-coefficient polynomial fully unrolled
+// ( see ct_map_span ).
+template<typename coeffT, size_t N>
+forceinline constexpr void
+ct_cond_add_if_negative(std::span<coeffT, N> vals, const coeffT q)
+  requires(ct_coeff<coeffT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [q](const __m256i x) { return ct_cond_add_if_negative_avx2<coeffT>(x, ct_broadcast_avx2(q)); };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [q](const coeffT x) { return ct_cond_add_if_negative(x, q); }, avx2_op);
+}
+
+// Given a span vals of coefficients in [-q, 2q) and the modulus q, this routine maps
+// every coefficient to its canonical representative in [0, q), using ct_freeze_mod.
+template<typename coeffT, size_t N>
+forceinline constexpr void
+ct_freeze_mod(std::span<coeffT, N> vals, const coeffT q)
+  requires(ct_coeff<coeffT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [q](const __m256i x) { return ct_freeze_mod_avx2<coeffT>(x, ct_broadcast_avx2(q)); };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [q](const coeffT x) { return ct_freeze_mod(x, q); }, avx2_op);
+}
+
+// Given a span vals of coefficients in [0, q) and the modulus q, this routine maps
+// every coefficient to its centered representative, using ct_center.
+template<typename coeffT, size_t N>
+forceinline constexpr void
+ct_center(std::span<coeffT, N> vals, const coeffT q)
+  requires(ct_coeff<coeffT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  const auto avx2_op = [q](const __m256i x) {
+    return ct_center_avx2<coeffT>(x, ct_broadcast_avx2(q), ct_broadcast_avx2(static_cast<coeffT>(q / 2)));
+  };
+#else
+  const auto avx2_op = nullptr;
+#endif
+
+  ct_map_span(vals, [q](const coeffT x) { return ct_center(x, q); }, avx2_op);
+}
+
+}
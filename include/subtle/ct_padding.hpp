@@ -0,0 +1,142 @@
+#pragma once
+#include "subtle.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Padding validation and removal -- PKCS#7, ISO/IEC 7816-4 and PKCS#1 v1.5 ( type 2 ) --
+// without a padding oracle: every byte of the block is read, and neither the code path
+// nor the memory accessed depends on the padding, its validity or the message length.
+namespace subtle {
+
+// Bit mask of the min( 32, buf.size() - i ) valid positions of a ct_eq_bitmask at offset
+// i -- public, as both operands are.
+//
+// The unpadding routines below scan the block 32 bytes to a ct_eq_bitmask at a time, and
+// locate the bytes they are after with ct_bit_length / ct_ctz of those masks, rather than
+// with a select per byte.
+template<size_t N>
+forceinline constexpr uint32_t
+ct_lanes_bitmask(std::span<const uint8_t, N> buf, const size_t i)
+{
+  const size_t m = std::min<size_t>(32, buf.size() - i);
+  return static_cast<uint32_t>((uint64_t{ 1 } << m) - 1U);
+}
+
+// Given a padded block of public size n ( 1 <= n ), this routine checks its PKCS#7
+// padding -- p = block[n - 1] with 1 <= p <= n, and the last p bytes all equal to p --
+// returning truth value ( all bits of returnT set ) if it is valid, or false value ( all
+// bits zero ) otherwise, and setting len to the length n - p of the message, or to zero
+// if the padding is invalid.
+//
+// The position one past the last byte differing from p is tracked a block of 32 at a
+// time, from ct_bit_length of the mismatch mask; the padding is valid if it is at most
+// n - p, so no mask of secret length is ever built.
+template<typename returnT, size_t N>
+forceinline constexpr returnT
+ct_pkcs7_unpad(std::span<const uint8_t, N> block, size_t& len)
+  requires(std::is_unsigned_v<returnT> && (N == std::dynamic_extent || N > 0))
+{
+  const size_t n = block.size();
+  const uint8_t p = block[n - 1];
+
+  size_t end = 0;
+  for (size_t i = 0; i < n; i += 32) {
+    const uint32_t mismatch = ~ct_eq_bitmask(block, i, p) & ct_lanes_bitmask(block, i);
+    end = ct_select(~ct_is_zero<uint32_t, uint64_t>(mismatch), i + ct_bit_length(mismatch), end);
+  }
+
+  const size_t pad = p;
+  const size_t msg = n - pad;
+
+  const auto valid = static_cast<uint64_t>(~ct_is_zero<size_t, uint64_t>(pad) & ct_le<size_t, uint64_t>(pad, n) & ct_le<size_t, uint64_t>(end, msg));
+
+  len = ct_select(valid, msg, size_t{ 0 });
+  return static_cast<returnT>(valid);
+}
+
+// Given a padded block of public size n, this routine checks its ISO/IEC 7816-4 padding
+// -- a 0x80 byte followed by zero or more zero bytes up to the end of the block --
+// returning truth value ( all bits of returnT set ) if it is valid, or false value ( all
+// bits zero ) otherwise, and setting len to the position of the 0x80 byte, i.e. the
+// length of the message, or to zero if the padding is invalid.
+//
+// The padding is valid if the last nonzero byte is 0x80: per block of 32, the highest bit
+// of the nonzero mask gives its position, and, as every 0x80 byte is nonzero, it is 0x80
+// exactly when the mask of 0x80 bytes has the same ct_bit_length.
+template<typename returnT, size_t N>
+forceinline constexpr returnT
+ct_iso7816_unpad(std::span<const uint8_t, N> block, size_t& len)
+  requires(std::is_unsigned_v<returnT>)
+{
+  const size_t n = block.size();
+
+  size_t end = 0;
+  uint64_t marked = 0;
+  for (size_t i = 0; i < n; i += 32) {
+    const uint32_t nonzero = ~ct_eq_bitmask(block, i, uint8_t{ 0x00 }) & ct_lanes_bitmask(block, i);
+    const uint32_t marker = ct_eq_bitmask(block, i, uint8_t{ 0x80 });
+
+    const auto br = static_cast<uint64_t>(~ct_is_zero<uint32_t, uint64_t>(nonzero));
+    const size_t bits = ct_bit_length(nonzero);
+
+    end = ct_select(br, i + bits, end);
+    marked = ct_select(br, ct_eq<size_t, uint64_t>(ct_bit_length(marker), bits), marked);
+  }
+
+  const auto valid = static_cast<uint64_t>(~ct_is_zero<size_t, uint64_t>(end) & marked);
+
+  len = ct_select(valid, end - 1, size_t{ 0 });
+  return static_cast<returnT>(valid);
+}
+
+// Given an encoded message em of public size k -- the modulus size in bytes, at least 11
+// -- this routine checks its PKCS#1 v1.5 encryption padding ( RFC 8017, section 7.2.2 ):
+//
+//   em = 0x00 || 0x02 || PS || 0x00 || M
+//
+// with PS at least 8 nonzero bytes, returning truth value ( all bits of returnT set ) if
+// it is valid, or false value ( all bits zero ) otherwise, and setting len to the length
+// of M, which makes up the last len bytes of em, or to zero if the padding is invalid. A
+// k below 11 is always invalid.
+//
+// The separator is the first zero byte from index 2 on: per block of 32, ct_ctz of the
+// zero mask gives its position, kept from the first block where that mask is nonzero.
+// The validity mask is not to be branched on by the caller either -- Bleichenbacher's
+// attack needs nothing more -- so, in RSA decryption, a random message of the same length
+// should be substituted on failure, with ct_conditional_memcpy ( RFC 8017, section 7.2.2,
+// note ).
+template<typename returnT, size_t N>
+forceinline constexpr returnT
+ct_pkcs1_v15_unpad(std::span<const uint8_t, N> em, size_t& len)
+  requires(std::is_unsigned_v<returnT>)
+{
+  const size_t k = em.size();
+  if (k < 11) {
+    len = 0;
+    return returnT{ 0 };
+  }
+
+  size_t sep = 0;
+  uint64_t found = 0;
+  for (size_t i = 0; i < k; i += 32) {
+    uint32_t zeros = ct_eq_bitmask(em, i, uint8_t{ 0x00 }) & ct_lanes_bitmask(em, i);
+    if (i == 0) {
+      zeros &= ~uint32_t{ 0b11 };
+    }
+
+    const auto first = static_cast<uint64_t>(~found & ~ct_is_zero<uint32_t, uint64_t>(zeros));
+    sep = ct_select(first, i + ct_ctz(zeros), sep);
+    found |= first;
+  }
+
+  const auto valid = static_cast<uint64_t>(ct_is_zero<uint8_t, uint64_t>(em[0]) & ct_eq<uint8_t, uint64_t>(em[1], 0x02) & found &
+                                           ct_ge<size_t, uint64_t>(sep, 10));
+
+  len = ct_select(valid, k - sep - 1, size_t{ 0 });
+  return static_cast<returnT>(valid);
+}
+
+}
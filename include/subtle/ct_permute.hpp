@@ -0,0 +1,353 @@
+#pragma once
+#include "subtle.hpp"
+#include "subtle/ct_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Oblivious application of secret permutations, through a Beneš network.
+namespace subtle {
+
+// A Beneš network permuting n = 2^w elements is made of 2w - 1 layers of n / 2
+// conditional swaps. Layer k = 0, 1, ..., 2w - 2 swaps the pairs ( i, i + 2^s ), for
+// every i with bit s unset, where s = k for the first w layers and s = 2w - 2 - k
+// for the others. The n / 2 swaps of a layer are driven by as many control bits,
+// taken in increasing order of i; all layers are concatenated, the control bit of
+// index b being bit ( b % 8 ) of byte b / 8.
+//
+// Sizes accepted by the Beneš network routines below: powers of 2, from 2 to 2^16.
+template<size_t N>
+concept ct_benes_size = (N >= 2) && (N <= (size_t{ 1 } << 16)) && std::has_single_bit(N);
+
+// Number of bytes holding the control bits of a Beneš network permuting n elements.
+consteval size_t
+ct_benes_control_bytes(const size_t n)
+{
+  const auto w = static_cast<size_t>(std::countr_zero(n));
+  return ((2 * w - 1) * (n / 2) + 7) / 8;
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Given the control bits of as many consecutive swaps as there are 8, 16, 32 or
+// 64-bit lanes in an AVX2 register, this routine expands them into lane masks.
+template<typename operandT>
+forceinline __m256i
+ct_benes_masks_avx2(const uint32_t bits)
+  requires(ct_operand<operandT>)
+{
+  if constexpr (sizeof(operandT) == 8) {
+    const __m256i sel = _mm256_setr_epi64x(1, 2, 4, 8);
+    return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), sel), sel);
+  } else if constexpr (sizeof(operandT) == 4) {
+    const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), sel), sel);
+  } else if constexpr (sizeof(operandT) == 2) {
+    const __m256i sel = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, -32768);
+    return _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(static_cast<short>(bits)), sel), sel);
+  } else {
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i sel = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+    const __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)), spread);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(v, sel), sel);
+  }
+}
+
+#endif
+
+// Given a span vals of 2^w integers, the control bits of a Beneš network and a public
+// layer index and stride, this routine applies that layer: vals[i] and vals[i + stride]
+// are swapped when the control bit of their pair is set.
+//
+// With AVX2, strides of at least one register's worth of lanes swap a register at a
+// time, under lane masks expanded from the next 4 to 32 control bits.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_benes_layer(std::span<operandT, N> vals, std::span<const uint8_t> control, const size_t layer, const size_t stride)
+  requires(ct_operand<operandT>)
+{
+  const size_t n = vals.size();
+  const size_t first_bit = layer * (n / 2);
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  if (!std::is_constant_evaluated()) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+    if (stride >= lanes) {
+      for (size_t base = 0; base < n; base += 2 * stride) {
+        for (size_t j = 0; j < stride; j += lanes) {
+          const size_t bit = first_bit + base / 2 + j;
+
+          uint32_t bits = 0;
+          for (size_t b = 0; b < (lanes + 7) / 8; b++) {
+            bits |= static_cast<uint32_t>(control[bit / 8 + b]) << (8 * b);
+          }
+          bits = (bits >> (bit % 8)) & static_cast<uint32_t>((uint64_t{ 1 } << lanes) - 1);
+
+          auto* pa = reinterpret_cast<__m256i*>(vals.data() + base + j);          // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+          auto* pb = reinterpret_cast<__m256i*>(vals.data() + base + j + stride); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+          const __m256i a = _mm256_loadu_si256(pa);
+          const __m256i b = _mm256_loadu_si256(pb);
+          const __m256i d = _mm256_and_si256(_mm256_xor_si256(a, b), ct_benes_masks_avx2<operandT>(bits));
+
+          _mm256_storeu_si256(pa, _mm256_xor_si256(a, d));
+          _mm256_storeu_si256(pb, _mm256_xor_si256(b, d));
+        }
+      }
+      return;
+    }
+  }
+#endif
+
+  for (size_t base = 0; base < n; base += 2 * stride) {
+    for (size_t j = 0; j < stride; j++) {
+      const size_t bit = first_bit + base / 2 + j;
+      const auto br = static_cast<uint8_t>(0U - ((control[bit / 8] >> (bit % 8)) & 1U));
+
+      ct_swap(br, vals[base + j], vals[base + j + stride]);
+    }
+  }
+}
+
+// Given a span vals of n = 2^w integers and the control bits of a Beneš network
+// computing a permutation pi ( see ct_benes_control_bits ), this routine permutes vals
+// in place, such that afterwards vals[i] holds what was at vals[pi[i]]. Every layer
+// touches every element, so the memory access pattern depends on n alone -- neither
+// pi nor the contents of vals leak through it.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_permute(std::span<operandT, N> vals, std::span<const uint8_t, ct_benes_control_bytes(N)> control)
+  requires(ct_operand<operandT> && ct_benes_size<N>)
+{
+  constexpr auto w = static_cast<size_t>(std::countr_zero(N));
+
+  for (size_t layer = 0; layer < 2 * w - 1; layer++) {
+    const size_t s = layer < w ? layer : 2 * w - 2 - layer;
+    ct_benes_layer(vals, control, layer, size_t{ 1 } << s);
+  }
+}
+
+// Same as above, for a bit vector of n = 2^w bits, packed 64 to a word, bit i being
+// bit ( i % 64 ) of bits[i / 64]. Layers of stride 64 and more swap whole words under
+// 64 control bits at once; smaller strides are delta swaps within each word, under a
+// mask built by spreading its 32 control bits over the lower bit of every pair.
+template<size_t N>
+forceinline constexpr void
+ct_permute_bits(std::span<uint64_t, N> bits, std::span<const uint8_t, ct_benes_control_bytes(64 * N)> control)
+  requires(ct_benes_size<64 * N>)
+{
+  constexpr auto w = static_cast<size_t>(std::countr_zero(64 * N));
+
+  // Runs of 16, 8, 4, 2 and 1 set bits, alternating with as many unset bits.
+  constexpr std::array<uint64_t, 5> RUNS = { 0x0000ffff0000ffffULL, 0x00ff00ff00ff00ffULL, 0x0f0f0f0f0f0f0f0fULL, 0x3333333333333333ULL, 0x5555555555555555ULL };
+
+  const auto control_word = [&](const size_t bit, const size_t count) {
+    uint64_t word = 0;
+    for (size_t b = 0; b < count / 8; b++) {
+      word |= static_cast<uint64_t>(control[bit / 8 + b]) << (8 * b);
+    }
+    return word;
+  };
+
+  for (size_t layer = 0; layer < 2 * w - 1; layer++) {
+    const size_t s = layer < w ? layer : 2 * w - 2 - layer;
+    const size_t stride = size_t{ 1 } << s;
+    const size_t first_bit = layer * (32 * N);
+
+    if (stride >= 64) {
+      const size_t word_stride = stride / 64;
+
+      for (size_t base = 0; base < N; base += 2 * word_stride) {
+        for (size_t j = 0; j < word_stride; j++) {
+          const uint64_t mask = control_word(first_bit + 64 * (base / 2 + j), 64);
+          const uint64_t t = (bits[base + j] ^ bits[base + j + word_stride]) & mask;
+
+          bits[base + j] ^= t;
+          bits[base + j + word_stride] ^= t;
+        }
+      }
+    } else {
+      for (size_t i = 0; i < N; i++) {
+        uint64_t mask = control_word(first_bit + 32 * i, 32);
+
+        // Spread the 32 control bits over runs of stride bits, leaving a gap of
+        // stride bits after each run: bit k lands on the k-th bit with bit s unset.
+        for (size_t c = 16, k = 0; c >= stride; c >>= 1, k++) {
+          mask = (mask | (mask << c)) & RUNS[k];
+        }
+
+        const uint64_t t = ((bits[i] >> stride) ^ bits[i]) & mask;
+        bits[i] ^= t ^ (t << stride);
+      }
+    }
+  }
+}
+
+// Given the current ( sub-)permutation pi of n = 2^w elements, this routine writes the
+// control bits of its Beneš network at the bit positions pos, pos + step, pos + 2 step,
+// ... of out, which must be zero on entry. scratch holds 2n words.
+//
+// This is the constant-time recursion of Bernstein's "Verified fast formulas for
+// control bits for permutation networks" ( https://cr.yp.to/papers/controlbits-20200923.pdf ),
+// as used by Classic McEliece: each step of the Nassimi-Sahni setup algorithm is
+// phrased as sorts of packed ( key << 16 ) | value words, all done by ct_sort, and a
+// few element-wise ct_min. The order of the work depends on n alone.
+template<typename indexT>
+constexpr void
+ct_benes_recursion(std::span<uint8_t> out, size_t pos, const size_t step, std::span<const indexT> pi, const size_t w, std::span<uint32_t> scratch)
+{
+  const size_t n = pi.size();
+
+  if (w == 1) {
+    out[pos / 8] = static_cast<uint8_t>(out[pos / 8] ^ (static_cast<uint32_t>(pi[0]) << (pos % 8)));
+    return;
+  }
+
+  const auto A = scratch.first(n);
+  const auto B = scratch.subspan(n, n);
+
+  const auto p = [&](const size_t x) { return static_cast<uint32_t>(pi[x]); };
+
+  for (size_t x = 0; x < n; x++) {
+    A[x] = ((p(x) ^ 1U) << 16) | p(x ^ 1);
+  }
+  ct_sort(A); // A = ( id << 16 ) + pibar
+
+  for (size_t x = 0; x < n; x++) {
+    const uint32_t px = A[x] & 0xffffU;
+    const uint32_t cx = ct_min(px, static_cast<uint32_t>(x));
+    B[x] = (px << 16) | cx;
+  }
+  // B = ( p << 16 ) + c
+
+  for (size_t x = 0; x < n; x++) {
+    A[x] = (A[x] << 16) | static_cast<uint32_t>(x); // A = ( pibar << 16 ) + id
+  }
+  ct_sort(A); // A = ( id << 16 ) + pibar^-1
+
+  for (size_t x = 0; x < n; x++) {
+    A[x] = (A[x] << 16) + (B[x] >> 16); // A = ( pibar^-1 << 16 ) + pibar
+  }
+  ct_sort(A); // A = ( id << 16 ) + pibar^2
+
+  for (size_t x = 0; x < n; x++) {
+    B[x] = (A[x] << 16) | (B[x] & 0xffffU);
+  }
+
+  for (size_t i = 1; i < w - 1; i++) {
+    // B = ( p << 16 ) + c
+
+    for (size_t x = 0; x < n; x++) {
+      A[x] = (B[x] & ~0xffffU) | static_cast<uint32_t>(x);
+    }
+    ct_sort(A); // A = ( id << 16 ) + p^-1
+
+    for (size_t x = 0; x < n; x++) {
+      A[x] = (A[x] << 16) | (B[x] & 0xffffU); // A = ( p^-1 << 16 ) + c
+    }
+
+    if (i < w - 2) {
+      for (size_t x = 0; x < n; x++) {
+        B[x] = (A[x] & ~0xffffU) | (B[x] >> 16); // B = ( p^-1 << 16 ) + p
+      }
+      ct_sort(B); // B = ( id << 16 ) + p^-2
+
+      for (size_t x = 0; x < n; x++) {
+        B[x] = (B[x] << 16) | (A[x] & 0xffffU); // B = ( p^-2 << 16 ) + c
+      }
+    }
+
+    ct_sort(A); // A = ( id << 16 ) + cp
+
+    for (size_t x = 0; x < n; x++) {
+      const uint32_t cpx = (B[x] & ~0xffffU) | (A[x] & 0xffffU);
+      B[x] = ct_min(B[x], cpx);
+    }
+  }
+
+  for (size_t x = 0; x < n; x++) {
+    B[x] &= 0xffffU;
+  }
+
+  for (size_t x = 0; x < n; x++) {
+    A[x] = (p(x) << 16) + static_cast<uint32_t>(x);
+  }
+  ct_sort(A); // A = ( id << 16 ) + pi^-1
+
+  for (size_t j = 0; j < n / 2; j++) {
+    const size_t x = 2 * j;
+    const uint32_t fj = B[x] & 1U;                // f[j]
+    const uint32_t Fx = static_cast<uint32_t>(x) + fj; // F[x]
+    const uint32_t Fx1 = Fx ^ 1U;                 // F[x + 1]
+
+    out[pos / 8] = static_cast<uint8_t>(out[pos / 8] ^ (fj << (pos % 8)));
+    pos += step;
+
+    B[x] = (A[x] << 16) | Fx;
+    B[x + 1] = (A[x + 1] << 16) | Fx1;
+  }
+  // B = ( pi^-1 << 16 ) + F
+
+  ct_sort(B); // B = ( id << 16 ) + F( pi )
+
+  pos += (2 * w - 3) * step * (n / 2);
+
+  for (size_t k = 0; k < n / 2; k++) {
+    const size_t y = 2 * k;
+    const uint32_t lk = B[y] & 1U;                // l[k]
+    const uint32_t Ly = static_cast<uint32_t>(y) + lk; // L[y]
+    const uint32_t Ly1 = Ly ^ 1U;                 // L[y + 1]
+
+    out[pos / 8] = static_cast<uint8_t>(out[pos / 8] ^ (lk << (pos % 8)));
+    pos += step;
+
+    A[y] = (Ly << 16) | (B[y] & 0xffffU);
+    A[y + 1] = (Ly1 << 16) | (B[y + 1] & 0xffffU);
+  }
+  // A = ( L << 16 ) + F( pi )
+
+  ct_sort(A); // A = ( id << 16 ) + F( pi( L ) ) = ( id << 16 ) + M
+
+  pos -= (2 * w - 2) * step * (n / 2);
+
+  // The two half-size permutations of the inner network, stored where B was.
+  const auto q = B;
+  for (size_t j = 0; j < n / 2; j++) {
+    q[j] = (A[2 * j] & 0xffffU) >> 1;
+    q[j + n / 2] = (A[2 * j + 1] & 0xffffU) >> 1;
+  }
+
+  const std::span<const uint32_t> q0 = q.first(n / 2);
+  const std::span<const uint32_t> q1 = q.subspan(n / 2);
+
+  ct_benes_recursion<uint32_t>(out, pos, 2 * step, q0, w - 1, scratch.first(n));
+  ct_benes_recursion<uint32_t>(out, pos + step, 2 * step, q1, w - 1, scratch.first(n));
+}
+
+// Given a permutation pi of { 0, 1, ..., n - 1 } ( n = 2^w ), this routine computes the
+// control bits of the Beneš network which permutes vals into vals[pi[0]], vals[pi[1]],
+// ..., vals[pi[n - 1]] -- see ct_permute. It runs in constant time: both the work done
+// and the memory access pattern only depend on n, never on pi. scratch is caller-provided
+// working memory of 2n words, left zeroized on return, as it held secret data.
+//
+// Its cost is that of O( w^2 ) oblivious sorts of n words, so a permutation which is
+// applied more than once should have its control bits computed once and kept.
+template<typename indexT, size_t N>
+constexpr void
+ct_benes_control_bits(std::span<const indexT, N> pi, std::span<uint8_t, ct_benes_control_bytes(N)> control, std::span<uint32_t, 2 * N> scratch)
+  requires(std::is_unsigned_v<indexT> && ct_benes_size<N>)
+{
+  constexpr auto w = static_cast<size_t>(std::countr_zero(N));
+
+  std::ranges::fill(control, uint8_t{ 0 });
+  ct_benes_recursion<indexT>(control, 0, 1, pi, w, scratch);
+
+  ct_zeroize(scratch);
+}
+
+}
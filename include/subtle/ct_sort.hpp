@@ -0,0 +1,471 @@
+#pragma once
+#include "subtle.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+// Oblivious sorting, shuffling and compaction of secret data.
+namespace subtle {
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Reverses the order of the lanes of an AVX2 register.
+template<typename operandT>
+forceinline __m256i
+ct_reverse_lanes_avx2(const __m256i v)
+  requires(ct_operand<operandT>)
+{
+  if constexpr (sizeof(operandT) == 8) {
+    return _mm256_permute4x64_epi64(v, 0x1b);
+  } else if constexpr (sizeof(operandT) == 4) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  } else {
+    const __m256i in_lane = sizeof(operandT) == 1
+                              ? _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+                              : _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1, 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, in_lane), 0x4e);
+  }
+}
+
+// Given a block of 32 and 64-bit integers held in two AVX2 registers -- 16 of them,
+// v0 holding elements 0..7 and v1 elements 8..15, or 8 of them, v0 holding elements
+// 0..3 and v1 elements 4..7 -- these routines run the in-block stages of the sorting
+// network below without leaving the registers: the pairs of a stage are gathered into
+// two registers by a fixed lane shuffle, compare-exchanged and shuffled back.
+//
+// Mirror stage of width m ( 2, 4, ... up to the block size ): compare-exchanges
+// elements t and m - 1 - t of every aligned group of m elements.
+template<typename operandT>
+forceinline void
+ct_sort_block_mirror_avx2(__m256i& v0, __m256i& v1, const size_t m)
+  requires(ct_operand<operandT> && (sizeof(operandT) >= sizeof(uint32_t)))
+{
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+  if (m == 2 * lanes) {
+    __m256i hi = ct_reverse_lanes_avx2<operandT>(v1);
+    ct_minmax_avx2<operandT>(v0, hi);
+    v1 = ct_reverse_lanes_avx2<operandT>(hi);
+  } else if (m == lanes) {
+    // Groups of m are 128-bit halves: reverse the upper ones within their half.
+    constexpr int half_reverse = sizeof(operandT) == 4 ? 0x1b : 0x4e;
+
+    __m256i lo = _mm256_permute2x128_si256(v0, v1, 0x20);
+    __m256i hi = _mm256_shuffle_epi32(_mm256_permute2x128_si256(v0, v1, 0x31), half_reverse);
+    ct_minmax_avx2<operandT>(lo, hi);
+    hi = _mm256_shuffle_epi32(hi, half_reverse);
+    v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+    v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+  } else if (sizeof(operandT) == 4 && m == 4) {
+    __m256i lo = _mm256_unpacklo_epi64(v0, v1);
+    __m256i hi = _mm256_shuffle_epi32(_mm256_unpackhi_epi64(v0, v1), 0xb1);
+    ct_minmax_avx2<operandT>(lo, hi);
+    hi = _mm256_shuffle_epi32(hi, 0xb1);
+    v0 = _mm256_unpacklo_epi64(lo, hi);
+    v1 = _mm256_unpackhi_epi64(lo, hi);
+  } else if constexpr (sizeof(operandT) == 4) {
+    __m256i lo = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), 0x88));
+    __m256i hi = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), 0xdd));
+    ct_minmax_avx2<operandT>(lo, hi);
+    v0 = _mm256_unpacklo_epi32(lo, hi);
+    v1 = _mm256_unpackhi_epi32(lo, hi);
+  } else {
+    __m256i lo = _mm256_unpacklo_epi64(v0, v1);
+    __m256i hi = _mm256_unpackhi_epi64(v0, v1);
+    ct_minmax_avx2<operandT>(lo, hi);
+    v0 = _mm256_unpacklo_epi64(lo, hi);
+    v1 = _mm256_unpackhi_epi64(lo, hi);
+  }
+}
+
+// Half-cleaner stages of distance j = top, top / 2, ..., 1 ( top at most half the
+// block size ): compare-exchanges elements i and i + j, for every i with bit j unset.
+template<typename operandT>
+forceinline void
+ct_sort_block_cleaners_avx2(__m256i& v0, __m256i& v1, const size_t top)
+  requires(ct_operand<operandT> && (sizeof(operandT) >= sizeof(uint32_t)))
+{
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+  if (top >= lanes) {
+    ct_minmax_avx2<operandT>(v0, v1);
+  }
+  if (top >= lanes / 2) {
+    __m256i lo = _mm256_permute2x128_si256(v0, v1, 0x20);
+    __m256i hi = _mm256_permute2x128_si256(v0, v1, 0x31);
+    ct_minmax_avx2<operandT>(lo, hi);
+    v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+    v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+  }
+  if constexpr (sizeof(operandT) == 4) {
+    if (top >= 2) {
+      __m256i lo = _mm256_unpacklo_epi64(v0, v1);
+      __m256i hi = _mm256_unpackhi_epi64(v0, v1);
+      ct_minmax_avx2<operandT>(lo, hi);
+      v0 = _mm256_unpacklo_epi64(lo, hi);
+      v1 = _mm256_unpackhi_epi64(lo, hi);
+    }
+  }
+  if (top >= 1) {
+    ct_sort_block_mirror_avx2<operandT>(v0, v1, 2);
+  }
+}
+
+#endif
+
+// Given a span vals of integers and a public run [lo, hi) with distance d, this
+// routine compare-exchanges the pairs ( vals[i], vals[i + d] ) for every i in the run,
+// leaving the minimum of each pair at i and the maximum at i + d. The pairs must be
+// disjoint ( d >= hi - lo ), so that they can be processed side by side -- with AVX2,
+// a register's worth of lanes at a time.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_minmax_run(std::span<operandT, N> vals, size_t lo, const size_t hi, const size_t d)
+  requires(ct_operand<operandT>)
+{
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+  if (!std::is_constant_evaluated() && (N == std::dynamic_extent || N >= lanes)) {
+    for (; lo + lanes <= hi; lo += lanes) {
+      auto* pa = reinterpret_cast<__m256i*>(vals.data() + lo);     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto* pb = reinterpret_cast<__m256i*>(vals.data() + lo + d); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      __m256i a = _mm256_loadu_si256(pa);
+      __m256i b = _mm256_loadu_si256(pb);
+      ct_minmax_avx2<operandT>(a, b);
+
+      _mm256_storeu_si256(pa, a);
+      _mm256_storeu_si256(pb, b);
+    }
+  }
+#endif
+
+  for (size_t i = lo; i < hi; i++) {
+    ct_minmax(vals[i], vals[i + d]);
+  }
+}
+
+// Given a span vals of integers and public indices first < last, this routine
+// compare-exchanges the mirrored pairs ( vals[first + t], vals[last - t] ) for every
+// t in [0, count), count being at most ( last - first + 1 ) / 2. With AVX2, the upper
+// elements are loaded a register at a time and lane-reversed.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_minmax_mirror(std::span<operandT, N> vals, const size_t first, const size_t last, const size_t count)
+  requires(ct_operand<operandT>)
+{
+  size_t t = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+
+  if (!std::is_constant_evaluated() && (N == std::dynamic_extent || N >= lanes)) {
+    for (; t + lanes <= count; t += lanes) {
+      auto* pa = reinterpret_cast<__m256i*>(vals.data() + first + t);              // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto* pb = reinterpret_cast<__m256i*>(vals.data() + last - t - (lanes - 1)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      __m256i a = _mm256_loadu_si256(pa);
+      __m256i b = ct_reverse_lanes_avx2<operandT>(_mm256_loadu_si256(pb));
+      ct_minmax_avx2<operandT>(a, b);
+
+      _mm256_storeu_si256(pa, a);
+      _mm256_storeu_si256(pb, ct_reverse_lanes_avx2<operandT>(b));
+    }
+  }
+#endif
+
+  for (; t < count; t++) {
+    ct_minmax(vals[first + t], vals[last - t]);
+  }
+}
+
+// Given a span vals of integers, a public width m ( a power of 2 ) and a public distance
+// j_min >= 1, this routine runs one merge of the sorting network below over every aligned
+// group of m elements: the mirror stage, then the half-cleaner stages of distance m / 4
+// down to j_min.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_sort_merge(std::span<operandT, N> vals, const size_t m, const size_t j_min)
+  requires(ct_operand<operandT>)
+{
+  const size_t n = vals.size();
+
+  // Positions at or past n act as +infinity, so any pair reaching past n is left alone.
+  for (size_t base = 0; base + m / 2 < n; base += m) {
+    const size_t skip = base + m > n ? base + m - n : 0;
+    ct_minmax_mirror(vals, base + skip, base + m - 1 - skip, m / 2 - skip);
+  }
+
+  for (size_t j = m / 4; j >= j_min; j >>= 1) {
+    for (size_t base = 0; base + j < n; base += 2 * j) {
+      ct_minmax_run(vals, base, std::min(base + j, n - j), j);
+    }
+  }
+}
+
+// Given a span vals of integers, this routine sorts it in ascending order, in place,
+// without any data-dependent branch or memory access: which elements get compared and
+// swapped is decided by the ( public ) length alone.
+//
+// The network is a bitonic sorter in its all-ascending form: sorted runs of m / 2
+// elements are merged pairwise, for m = 2, 4, 8, ..., by a mirror stage comparing
+// elements t and m - 1 - t of every group of m, followed by half-cleaner stages
+// comparing elements i and i + j, for j = m / 4, ..., 1. Every comparator puts the
+// minimum at the lower index, so a length which is not a power of 2 is handled as
+// if padded with +infinity: comparators reaching past the end are simply dropped.
+// That is n / 4 * log2( n ) * ( log2( n ) + 1 ) compare-exchanges, laid out in
+// contiguous runs which vectorize.
+//
+// With AVX2, 32 and 64-bit integers are first sorted in blocks of two registers ( 16
+// and 8 elements respectively ), and every merge ends with its stages of distance less
+// than the block size, all of which stay within aligned blocks. So these run inside two
+// registers ( vpminsd / vpmaxsd or their 64-bit emulation, plus fixed shuffles ) instead
+// of element by element.
+template<typename operandT, size_t N>
+forceinline constexpr void
+ct_sort(std::span<operandT, N> vals)
+  requires(ct_operand<operandT>)
+{
+  const size_t n = vals.size();
+  if (n < 2) {
+    return;
+  }
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+  constexpr size_t BLOCK = 2 * sizeof(__m256i) / sizeof(operandT);
+
+  if constexpr (sizeof(operandT) >= sizeof(uint32_t) && (N == std::dynamic_extent || N >= BLOCK)) {
+    if (!std::is_constant_evaluated()) {
+
+      const size_t full = n - n % BLOCK;
+      const auto tail = vals.subspan(full);
+
+      for (size_t base = 0; base < full; base += BLOCK) {
+        auto* p = reinterpret_cast<__m256i*>(vals.data() + base); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        __m256i v0 = _mm256_loadu_si256(p);
+        __m256i v1 = _mm256_loadu_si256(p + 1);
+
+        for (size_t m = 2; m <= BLOCK; m <<= 1) {
+          ct_sort_block_mirror_avx2<operandT>(v0, v1, m);
+          ct_sort_block_cleaners_avx2<operandT>(v0, v1, m / 4);
+        }
+
+        _mm256_storeu_si256(p, v0);
+        _mm256_storeu_si256(p + 1, v1);
+      }
+      for (size_t m = 2; m <= BLOCK; m <<= 1) {
+        ct_sort_merge(tail, m, 1);
+      }
+
+      for (size_t m = 2 * BLOCK; m / 2 < n; m <<= 1) {
+        ct_sort_merge(vals, m, BLOCK);
+
+        for (size_t base = 0; base < full; base += BLOCK) {
+          auto* p = reinterpret_cast<__m256i*>(vals.data() + base); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+          __m256i v0 = _mm256_loadu_si256(p);
+          __m256i v1 = _mm256_loadu_si256(p + 1);
+          ct_sort_block_cleaners_avx2<operandT>(v0, v1, BLOCK / 2);
+
+          _mm256_storeu_si256(p, v0);
+          _mm256_storeu_si256(p + 1, v1);
+        }
+        for (size_t j = BLOCK / 2; j > 0; j >>= 1) {
+          for (size_t base = 0; base + j < tail.size(); base += 2 * j) {
+            ct_minmax_run(tail, base, std::min(base + j, tail.size() - j), j);
+          }
+        }
+      }
+      return;
+    }
+  }
+#endif
+
+  for (size_t m = 2; m / 2 < n; m <<= 1) {
+    ct_sort_merge(vals, m, 1);
+  }
+}
+
+// Given a span vals of integers of at most 32 bits and an equal-length span of uniformly
+// random 64-bit words ( supplied by the caller, e.g. from a CSPRNG ), this routine
+// permutes vals uniformly at random, in place, without a data-dependent branch or memory
+// access -- unlike a Fisher-Yates shuffle, which indexes memory with secret values.
+//
+// Each element is tagged with the upper bits of its random word, the tag and the element
+// are packed into that word, and the words are sorted by ct_sort: the tag order is the
+// new element order. The random words are consumed -- used as working memory and
+// zeroized on return.
+//
+// The shuffle is uniform when all tags are distinct, which this routine returns as a
+// truth value. With tags of 32 bits or more, a collision is unlikely but possible; on
+// a false return value, the caller should shuffle again with fresh random words. Tags
+// are independent of vals, so retrying leaks nothing about them.
+//
+// Elements of 64 bits have no room for a tag: shuffle their indices instead, then apply
+// the permutation with ct_benes_control_bits and ct_permute.
+template<typename operandT, typename returnT, size_t N>
+forceinline constexpr returnT
+ct_shuffle(std::span<operandT, N> vals, std::span<uint64_t, N> random_words)
+  requires(ct_operand<operandT> && (sizeof(operandT) <= sizeof(uint32_t)) && std::is_unsigned_v<returnT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  constexpr size_t value_bits = std::numeric_limits<Uop>::digits;
+  constexpr uint64_t value_mask = (uint64_t{ 1 } << value_bits) - 1;
+
+  for (size_t i = 0; i < vals.size(); i++) {
+    random_words[i] = (random_words[i] & ~value_mask) | static_cast<Uop>(vals[i]);
+  }
+
+  ct_sort(random_words);
+
+  returnT collision = 0;
+  for (size_t i = 0; i < vals.size(); i++) {
+    vals[i] = static_cast<operandT>(static_cast<Uop>(random_words[i] & value_mask));
+
+    if (i + 1 < vals.size()) {
+      collision |= ct_eq<uint64_t, returnT>(random_words[i] >> value_bits, random_words[i + 1] >> value_bits);
+    }
+  }
+
+  ct_zeroize(random_words);
+  return static_cast<returnT>(~collision);
+}
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+
+// Given 32-bit lane masks for max( 8, lanes ) consecutive elements of type operandT,
+// held in as many consecutive registers as needed, this routine converts them into lane masks of
+// operandT: narrowing with saturating packs ( which keep all-one / all-zero lanes as
+// they are ) or widening with sign extension.
+template<typename operandT>
+forceinline void
+ct_compact_masks_avx2(const __m256i* masks32, __m256i* masks)
+  requires(ct_operand<operandT>)
+{
+  if constexpr (sizeof(operandT) == 1) {
+    const __m256i lo = _mm256_permute4x64_epi64(_mm256_packs_epi32(masks32[0], masks32[1]), 0xd8);
+    const __m256i hi = _mm256_permute4x64_epi64(_mm256_packs_epi32(masks32[2], masks32[3]), 0xd8);
+    masks[0] = _mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xd8);
+  } else if constexpr (sizeof(operandT) == 2) {
+    masks[0] = _mm256_permute4x64_epi64(_mm256_packs_epi32(masks32[0], masks32[1]), 0xd8);
+  } else if constexpr (sizeof(operandT) == 4) {
+    masks[0] = masks32[0];
+  } else {
+    masks[0] = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(masks32[0]));
+    masks[1] = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(masks32[0], 1));
+  }
+}
+
+#endif
+
+// Given a span vals of integers, an equal-length span keep_masks holding truth value
+// for the elements to keep and false value for the others, and caller-provided scratch
+// of as many 32-bit words, this routine moves the kept elements to the front of vals,
+// in their original order, and zeroes the positions past them. It returns how many
+// elements were kept -- a secret value, which must not be branched upon.
+//
+// Neither which elements are kept nor how many leaks through branches or memory
+// accesses. Each kept element has to move left by d, the number of dropped elements
+// before it, and does so over log2( n ) layers, moving by 2^b in layer b if bit b of
+// d is set. Taking the bits from the least significant one up, the elements never
+// collide and keep their order, and every layer is a single pass of ct_select over
+// all positions, in increasing order: a position takes the element 2^b places to its
+// right if that one moves, or else keeps its own. That is O( n log n ) work, with no
+// sorting involved. scratch holds the remaining distance of every element, and is
+// zeroized on return.
+//
+// With AVX2 each layer runs a register at a time, on the elements as well as on the
+// distances, both selected under lane masks derived from the same distance bits.
+template<typename operandT, typename maskT, size_t N>
+forceinline constexpr size_t
+ct_compact(std::span<operandT, N> vals, std::span<const maskT, N> keep_masks, std::span<uint32_t, N> scratch)
+  requires(ct_operand<operandT> && std::is_unsigned_v<maskT>)
+{
+  const size_t n = vals.size();
+
+  // Distance of every kept element, 0 for the dropped ones, which never move.
+  uint32_t dropped = 0;
+  for (size_t i = 0; i < n; i++) {
+    const auto keep = static_cast<uint32_t>(keep_masks[i] & 1U);
+    scratch[i] = dropped & (0U - keep);
+    dropped += keep ^ 1U;
+  }
+
+  for (size_t shift = 1; shift < n; shift <<= 1) {
+    const auto bit = static_cast<uint32_t>(shift);
+    size_t q = 0;
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    if (!std::is_constant_evaluated()) {
+      constexpr size_t lanes = sizeof(__m256i) / sizeof(operandT);
+      constexpr size_t chunk = std::max<size_t>(lanes, 8);
+
+      const __m256i sel = _mm256_set1_epi32(static_cast<int>(bit));
+
+      for (; q + shift + chunk <= n; q += chunk) {
+        // Plain arrays, as std::array would drop the vector type's alignment attribute.
+        __m256i moves_in[chunk / 8];  // NOLINT(*-avoid-c-arrays)
+        __m256i masks[chunk / lanes]; // NOLINT(*-avoid-c-arrays)
+
+        for (size_t r = 0; r < chunk / 8; r++) {
+          auto* pd = reinterpret_cast<__m256i*>(scratch.data() + q + 8 * r);         // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+          auto* ps = reinterpret_cast<__m256i*>(scratch.data() + q + shift + 8 * r); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+          const __m256i dist = _mm256_loadu_si256(pd);
+          const __m256i dist_in = _mm256_loadu_si256(ps);
+
+          const __m256i move_out = _mm256_cmpeq_epi32(_mm256_and_si256(dist, sel), sel);
+          moves_in[r] = _mm256_cmpeq_epi32(_mm256_and_si256(dist_in, sel), sel);
+
+          _mm256_storeu_si256(pd, _mm256_blendv_epi8(_mm256_andnot_si256(move_out, dist), dist_in, moves_in[r]));
+        }
+
+        ct_compact_masks_avx2<operandT>(moves_in, masks);
+
+        for (size_t r = 0; r < chunk / lanes; r++) {
+          auto* pv = reinterpret_cast<__m256i*>(vals.data() + q + lanes * r);         // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+          auto* ps = reinterpret_cast<__m256i*>(vals.data() + q + shift + lanes * r); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+          _mm256_storeu_si256(pv, _mm256_blendv_epi8(_mm256_loadu_si256(pv), _mm256_loadu_si256(ps), masks[r]));
+        }
+      }
+    }
+#endif
+
+    for (; q + shift < n; q++) {
+      const uint32_t dist = scratch[q];
+      const uint32_t dist_in = scratch[q + shift];
+
+      const uint32_t move_out = 0U - ((dist & bit) >> std::countr_zero(bit));
+      const uint32_t move_in = 0U - ((dist_in & bit) >> std::countr_zero(bit));
+
+      vals[q] = ct_select(move_in, vals[q + shift], vals[q]);
+      scratch[q] = ct_select(move_in, dist_in, static_cast<uint32_t>(dist & ~move_out));
+    }
+
+    // Nothing moves into the last shift positions, their elements can only move out.
+    for (; q < n; q++) {
+      const uint32_t dist = scratch[q];
+      scratch[q] = dist & ~(0U - ((dist & bit) >> std::countr_zero(bit)));
+    }
+  }
+
+  // i - count has its most significant bit set exactly when i < count.
+  const size_t count = n - dropped;
+  for (size_t i = 0; i < n; i++) {
+    vals[i] = ct_select(static_cast<size_t>(i - count), vals[i], operandT{ 0 });
+  }
+
+  ct_zeroize(scratch);
+  return count;
+}
+
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include "subtle.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Cache-line-blocked container for large secret-indexed tables.
+namespace subtle {
+
+// Cache line size, in bytes, assumed by the blocked layout of ct_table. 64 bytes
+// holds for every mainstream x86-64 core and most AArch64 cores.
+constexpr size_t CT_CACHE_LINE_SIZE = 64;
+
+// Number of cache lines ahead of the current one that a ct_table sweep prefetches.
+constexpr size_t CT_PREFETCH_DISTANCE = 4;
+
+// Hints the hardware to pull the cache line holding addr into the cache. A ct_table
+// sweep prefetches every line in order, so the hints carry no secret information.
+forceinline void
+ct_prefetch([[maybe_unused]] const void* addr)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(addr, 0, 3);
+#endif
+}
+
+// A table of N integers of type T, stored 64-byte aligned and blocked into whole
+// cache lines of entries_per_line entries each -- the tail of the last line is
+// zero-padded. Every access ( lookup, lookup_row, store ) sweeps all the lines in
+// order, touching each exactly once whatever the secret index is, so neither the
+// accessed addresses nor the control flow depend on it.
+//
+// Where ct_lookup pays one ct_eq and one ct_select per entry, the blocked sweep pays
+// one ct_eq per cache line and folds the whole line in with plain bitwise AND / OR
+// over a fixed 64-byte block -- two 256-bit operations when AVX2 is available. The
+// sweep runs ahead of itself with software prefetches, keeping memory traffic, which
+// dominates for tables of several KiB and up, streaming.
+//
+// Secret indices are expected to be in range [0, N) and representable by the index
+// type. An out-of-range index never aliases any of the N entries: it reads back as
+// zero ( or from the zero padding of the last line ) and writes at most that padding.
+template<typename T, size_t N>
+  requires(ct_operand<T> && (N > 0))
+class alignas(CT_CACHE_LINE_SIZE) ct_table
+{
+  using Uop = std::make_unsigned_t<T>;
+
+public:
+  static constexpr size_t entries_per_line = CT_CACHE_LINE_SIZE / sizeof(T);
+  static constexpr size_t line_count = (N + entries_per_line - 1) / entries_per_line;
+
+private:
+  static constexpr size_t line_shift = static_cast<size_t>(std::countr_zero(entries_per_line));
+  static constexpr size_t slot_mask = entries_per_line - 1;
+
+  struct alignas(CT_CACHE_LINE_SIZE) line_t
+  {
+    std::array<T, entries_per_line> elems{};
+  };
+
+  std::array<line_t, line_count> lines{};
+
+  // Issues the prefetch for the line CT_PREFETCH_DISTANCE ahead of line l.
+  forceinline constexpr void prefetch_ahead(const size_t l) const
+  {
+    if (!std::is_constant_evaluated() && (l + CT_PREFETCH_DISTANCE < line_count)) {
+      ct_prefetch(lines[l + CT_PREFETCH_DISTANCE].elems.data());
+    }
+  }
+
+public:
+  constexpr ct_table() = default;
+
+  // Builds the blocked table from N entries, in order.
+  constexpr explicit ct_table(std::span<const T, N> entries)
+  {
+    for (size_t i = 0; i < N; i++) {
+      lines[i >> line_shift].elems[i & slot_mask] = entries[i];
+    }
+  }
+
+  static constexpr size_t size() { return N; }
+
+  // Given a secret line index row ( of type indexT ), this routine copies entries
+  // [row * entries_per_line, (row + 1) * entries_per_line) -- one whole cache line --
+  // into dst, sweeping every line of the table.
+  template<typename indexT>
+  forceinline constexpr void lookup_row(const indexT row, std::span<T, entries_per_line> dst) const
+    requires(std::is_unsigned_v<indexT>)
+  {
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    if (!std::is_constant_evaluated()) {
+      __m256i acc_lo = _mm256_setzero_si256();
+      __m256i acc_hi = _mm256_setzero_si256();
+
+      for (size_t l = 0; l < line_count; l++) {
+        prefetch_ahead(l);
+
+        uint64_t mask = ct_eq<indexT, uint64_t>(static_cast<indexT>(l), row);
+        ct_barrier(mask);
+
+        const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+        const auto* line = reinterpret_cast<const __m256i*>(lines[l].elems.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        acc_lo = _mm256_or_si256(acc_lo, _mm256_and_si256(_mm256_load_si256(line), vmask));
+        acc_hi = _mm256_or_si256(acc_hi, _mm256_and_si256(_mm256_load_si256(line + 1), vmask));
+      }
+
+      auto* out = reinterpret_cast<__m256i*>(dst.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm256_storeu_si256(out, acc_lo);
+      _mm256_storeu_si256(out + 1, acc_hi);
+      return;
+    }
+#endif
+
+    std::array<Uop, entries_per_line> acc{};
+    for (size_t l = 0; l < line_count; l++) {
+      prefetch_ahead(l);
+
+      Uop mask = ct_eq<indexT, Uop>(static_cast<indexT>(l), row);
+      ct_barrier(mask);
+
+      for (size_t k = 0; k < entries_per_line; k++) {
+        acc[k] = static_cast<Uop>(acc[k] | static_cast<Uop>(static_cast<Uop>(lines[l].elems[k]) & mask));
+      }
+    }
+
+    for (size_t k = 0; k < entries_per_line; k++) {
+      dst[k] = static_cast<T>(acc[k]);
+    }
+  }
+
+  // Given a secret index idx ( of type indexT ), this routine returns entry idx of
+  // the table: the cache line holding it is fetched by lookup_row, then the entry is
+  // picked out of that line with ct_lookup.
+  template<typename indexT>
+  forceinline constexpr T lookup(const indexT idx) const
+    requires(std::is_unsigned_v<indexT>)
+  {
+    std::array<T, entries_per_line> line{};
+    lookup_row<indexT>(static_cast<indexT>(idx >> line_shift), line);
+
+    return ct_lookup<indexT, T>(static_cast<indexT>(idx & slot_mask), std::span<const T, entries_per_line>(line));
+  }
+
+  // Given a secret index idx ( of type indexT ) and a value val, this routine
+  // overwrites entry idx of the table with val. Every line is read and written back,
+  // whichever entry is the target.
+  template<typename indexT>
+  forceinline constexpr void store(const indexT idx, const T val)
+    requires(std::is_unsigned_v<indexT>)
+  {
+    const indexT row = static_cast<indexT>(idx >> line_shift);
+    const indexT slot = static_cast<indexT>(idx & slot_mask);
+
+    std::array<Uop, entries_per_line> slot_masks{};
+    for (size_t k = 0; k < entries_per_line; k++) {
+      slot_masks[k] = ct_eq<indexT, Uop>(static_cast<indexT>(k), slot);
+    }
+
+#if defined(SUBTLE_AVX2_ACTIVE_)
+    if (!std::is_constant_evaluated()) {
+      std::array<T, entries_per_line> vals{};
+      vals.fill(val);
+
+      const auto* slot_ptr = reinterpret_cast<const __m256i*>(slot_masks.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      const auto* val_ptr = reinterpret_cast<const __m256i*>(vals.data());        // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      const __m256i slot_lo = _mm256_loadu_si256(slot_ptr);
+      const __m256i slot_hi = _mm256_loadu_si256(slot_ptr + 1);
+      const __m256i val_lo = _mm256_loadu_si256(val_ptr);
+      const __m256i val_hi = _mm256_loadu_si256(val_ptr + 1);
+
+      for (size_t l = 0; l < line_count; l++) {
+        prefetch_ahead(l);
+
+        uint64_t mask = ct_eq<indexT, uint64_t>(static_cast<indexT>(l), row);
+        ct_barrier(mask);
+
+        const __m256i vmask = _mm256_set1_epi64x(static_cast<long long>(mask));
+        auto* line = reinterpret_cast<__m256i*>(lines[l].elems.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        _mm256_store_si256(line, _mm256_blendv_epi8(_mm256_load_si256(line), val_lo, _mm256_and_si256(slot_lo, vmask)));
+        _mm256_store_si256(line + 1, _mm256_blendv_epi8(_mm256_load_si256(line + 1), val_hi, _mm256_and_si256(slot_hi, vmask)));
+      }
+      return;
+    }
+#endif
+
+    for (size_t l = 0; l < line_count; l++) {
+      prefetch_ahead(l);
+
+      Uop mask = ct_eq<indexT, Uop>(static_cast<indexT>(l), row);
+      ct_barrier(mask);
+
+      for (size_t k = 0; k < entries_per_line; k++) {
+        const Uop w = static_cast<Uop>(slot_masks[k] & mask);
+        const Uop cur = static_cast<Uop>(lines[l].elems[k]);
+        lines[l].elems[k] = static_cast<T>(static_cast<Uop>(cur & static_cast<Uop>(~w)) | static_cast<Uop>(static_cast<Uop>(val) & w));
+      }
+    }
+  }
+};
+
+}
@@ -59,9 +59,11 @@ for func in $FUNCTIONS; do
     secrets="${sbuf1}, ${sbuf2}, secret_br${width}"
   elif [[ "$func" == *_conditional_memset_* ]]; then
     secrets="${sbuf1}, ${sx}, secret_br${width}"
+  elif [[ "$func" == *_muladd_span_* ]]; then
+    secrets="${sbuf1}, ${sbuf2}, ${sx}"
   elif [[ "$func" == *_memcmp_* ]]; then
     secrets="${sbuf1}, ${sbuf2}"
-  elif [[ "$func" == *_zeroize_* ]]; then
+  elif [[ "$func" == *_zeroize_* || "$func" == *_unpad_* || "$func" == *_decode_* ]]; then
     secrets="${sbuf1}"
   else
     secrets="${sx}, ${sy}"
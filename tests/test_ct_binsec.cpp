@@ -12,6 +12,10 @@
 //   binsec -sse -checkct -sse-script check.cfg <this_binary>
 
 #include "subtle.hpp"
+#include "subtle/ct_codec.hpp"
+#include "subtle/ct_gf.hpp"
+#include "subtle/ct_padding.hpp"
+#include <array>
 #include <cstdint>
 #include <unistd.h>
 
@@ -1055,6 +1059,88 @@ binsec_ct_zeroize_u64()
   _exit(0);
 }
 
+// --- ct_pkcs7_unpad / ct_iso7816_unpad / ct_pkcs1_v15_unpad (the padded block is secret) ---
+
+extern "C" void
+binsec_ct_pkcs7_unpad_u8()
+{
+  size_t len = 0;
+  sink32 = subtle::ct_pkcs7_unpad<uint32_t>(std::span<const uint8_t, SECRET_BUF_LEN>(secret_buf1_u8), len);
+  sink64 = len;
+  _exit(0);
+}
+
+extern "C" void
+binsec_ct_iso7816_unpad_u8()
+{
+  size_t len = 0;
+  sink32 = subtle::ct_iso7816_unpad<uint32_t>(std::span<const uint8_t, SECRET_BUF_LEN>(secret_buf1_u8), len);
+  sink64 = len;
+  _exit(0);
+}
+
+extern "C" void
+binsec_ct_pkcs1_v15_unpad_u8()
+{
+  size_t len = 0;
+  sink32 = subtle::ct_pkcs1_v15_unpad<uint32_t>(std::span<const uint8_t, SECRET_BUF_LEN>(secret_buf1_u8), len);
+  sink64 = len;
+  _exit(0);
+}
+
+// --- ct_hex_decode / ct_base64_decode (the encoded text is secret) ---
+
+extern "C" void
+binsec_ct_hex_decode_u8()
+{
+  std::array<uint8_t, SECRET_BUF_LEN / 2> out{};
+  const auto* text = reinterpret_cast<const char*>(secret_buf1_u8); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  sink32 = subtle::ct_hex_decode<uint32_t>(std::span(out), std::span<const char, SECRET_BUF_LEN>(text, SECRET_BUF_LEN));
+  sink8 = out[0];
+  _exit(0);
+}
+
+extern "C" void
+binsec_ct_base64_decode_u8()
+{
+  std::array<uint8_t, SECRET_BUF_LEN / 4 * 3> out{};
+  const auto* text = reinterpret_cast<const char*>(secret_buf1_u8); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  sink32 = subtle::ct_base64_decode<uint32_t>(std::span(out), std::span<const char, SECRET_BUF_LEN>(text, SECRET_BUF_LEN));
+  sink8 = out[0];
+  _exit(0);
+}
+
+// --- ct_gf256_mul / ct_gf_mul / ct_gf256_inv / ct_gf_muladd_span ---
+
+extern "C" void
+binsec_ct_gf256_mul_u8()
+{
+  sink8 = subtle::ct_gf256_mul(secret_x8, secret_y8);
+  _exit(0);
+}
+
+extern "C" void
+binsec_ct_gf_mul_u16()
+{
+  sink16 = subtle::ct_gf_mul<13, 0x201b>(static_cast<uint16_t>(secret_x16 & 0x1fffU), static_cast<uint16_t>(secret_y16 & 0x1fffU));
+  _exit(0);
+}
+
+extern "C" void
+binsec_ct_gf256_inv_u8()
+{
+  sink8 = subtle::ct_gf256_inv(secret_x8);
+  _exit(0);
+}
+
+extern "C" void
+binsec_ct_gf_muladd_span_u8()
+{
+  subtle::ct_gf_muladd_span<8, 0x11d>(std::span<uint8_t, SECRET_BUF_LEN>(secret_buf2_u8), std::span<const uint8_t, SECRET_BUF_LEN>(secret_buf1_u8), secret_x8);
+  sink8 = secret_buf2_u8[0];
+  _exit(0);
+}
+
 // Binsec starts from the specified function, not main.
 int
 main()
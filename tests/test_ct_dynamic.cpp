@@ -1,10 +1,21 @@
 #include "subtle.hpp"
+#include "subtle/ct_bigint.hpp"
+#include "subtle/ct_bitvec.hpp"
+#include "subtle/ct_bitslice.hpp"
+#include "subtle/ct_codec.hpp"
+#include "subtle/ct_gf.hpp"
+#include "subtle/ct_lattice.hpp"
+#include "subtle/ct_padding.hpp"
+#include "subtle/ct_permute.hpp"
+#include "subtle/ct_sort.hpp"
+#include "subtle/ct_table.hpp"
 #include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <limits>
+#include <numeric>
 #include <random>
 
 // Constant-time verification via uninitialized-memory taint tracking.
@@ -360,6 +371,755 @@ verify_ct_lookup()
   }
 }
 
+// --- Cache-line-blocked table ---
+
+template<typename operandT, typename indexT>
+void
+verify_ct_table()
+{
+  constexpr size_t FIXED_TABLE_SIZE = 128;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<operandT> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    std::array<operandT, FIXED_TABLE_SIZE> entries{};
+    std::ranges::generate(entries, [&]() { return dis(gen); });
+
+    subtle::ct_table<operandT, FIXED_TABLE_SIZE> table{ std::span<const operandT, FIXED_TABLE_SIZE>(entries) };
+    indexT idx = static_cast<indexT>(gen() % FIXED_TABLE_SIZE);
+    operandT val = dis(gen);
+
+    CT_POISON(&table, sizeof(table));
+    CT_POISON(&idx, sizeof(idx));
+    CT_POISON(&val, sizeof(val));
+
+    volatile operandT sink = table.template lookup<indexT>(idx);
+    static_cast<void>(sink);
+
+    table.template store<indexT>(idx, val);
+    volatile operandT sink_stored = table.template lookup<indexT>(static_cast<indexT>(0));
+    static_cast<void>(sink_stored);
+  }
+}
+
+// --- Bit-matrix transposes ---
+
+template<typename rowT>
+void
+verify_ct_transpose()
+{
+  constexpr size_t N = std::numeric_limits<rowT>::digits;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<rowT> dis(std::numeric_limits<rowT>::min(), std::numeric_limits<rowT>::max());
+
+  for (size_t i = 0; i < ITERATIONS / N; i++) {
+    std::array<rowT, N> rows{};
+    std::ranges::generate(rows, [&]() { return dis(gen); });
+
+    CT_POISON(rows.data(), rows.size() * sizeof(rowT));
+    subtle::ct_transpose_square<rowT, N>(std::span<rowT, N>(rows));
+
+    volatile rowT sink = rows[0];
+    static_cast<void>(sink);
+  }
+}
+
+// --- Bitsliced S-box ( the S-box table is public, the input bytes are secret ) ---
+
+void
+verify_ct_sbox_bitsliced()
+{
+  constexpr size_t FIXED_BUF_SIZE = 2 * subtle::CT_BITSLICE_LANES + 16;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis(0, 255);
+
+  std::array<uint8_t, 256> table{};
+  std::ranges::generate(table, [&]() { return static_cast<uint8_t>(dis(gen)); });
+  const subtle::ct_sbox_bitsliced sbox(table);
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<uint8_t, FIXED_BUF_SIZE> buf{};
+    std::ranges::generate(buf, [&]() { return static_cast<uint8_t>(dis(gen)); });
+
+    CT_POISON(buf.data(), buf.size());
+    sbox.apply(buf, buf);
+
+    volatile uint8_t sink = buf[0];
+    static_cast<void>(sink);
+  }
+}
+
+// --- Sorting network ( the length is public, the values are secret ) ---
+
+template<typename T>
+void
+verify_ct_sort()
+{
+  constexpr size_t FIXED_BUF_SIZE = 45;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<T> dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<T, FIXED_BUF_SIZE> buf{};
+    std::ranges::generate(buf, [&]() { return dis(gen); });
+
+    CT_POISON(buf.data(), buf.size() * sizeof(T));
+    subtle::ct_sort(std::span<T, FIXED_BUF_SIZE>(buf));
+
+    volatile T sink = buf[0];
+    static_cast<void>(sink);
+  }
+}
+
+// --- Beneš network ( the permutation and the permuted values are secret ) ---
+
+template<typename T>
+void
+verify_ct_permute()
+{
+  constexpr size_t FIXED_BUF_SIZE = 64;
+  constexpr size_t CONTROL_BYTES = subtle::ct_benes_control_bytes(FIXED_BUF_SIZE);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<T> dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 1024; i++) {
+    std::array<uint16_t, FIXED_BUF_SIZE> pi{};
+    std::iota(pi.begin(), pi.end(), uint16_t{ 0 });
+    std::ranges::shuffle(pi, gen);
+
+    std::array<T, FIXED_BUF_SIZE> buf{};
+    std::ranges::generate(buf, [&]() { return dis(gen); });
+
+    std::array<uint8_t, CONTROL_BYTES> control{};
+    std::array<uint32_t, 2 * FIXED_BUF_SIZE> scratch{};
+
+    CT_POISON(pi.data(), pi.size() * sizeof(uint16_t));
+    CT_POISON(buf.data(), buf.size() * sizeof(T));
+
+    subtle::ct_benes_control_bits<uint16_t, FIXED_BUF_SIZE>(pi, control, scratch);
+    subtle::ct_permute(std::span<T, FIXED_BUF_SIZE>(buf), std::span<const uint8_t, CONTROL_BYTES>(control));
+
+    volatile T sink = buf[0];
+    static_cast<void>(sink);
+  }
+}
+
+// --- Oblivious shuffle ( the values and the random words are secret ) ---
+
+template<typename T>
+void
+verify_ct_shuffle()
+{
+  constexpr size_t FIXED_BUF_SIZE = 45;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<T> dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<T, FIXED_BUF_SIZE> buf{};
+    std::ranges::generate(buf, [&]() { return dis(gen); });
+
+    std::array<uint64_t, FIXED_BUF_SIZE> random_words{};
+    std::ranges::generate(random_words, [&]() { return gen(); });
+
+    CT_POISON(buf.data(), buf.size() * sizeof(T));
+    CT_POISON(random_words.data(), random_words.size() * sizeof(uint64_t));
+
+    volatile uint32_t sink = subtle::ct_shuffle<T, uint32_t, FIXED_BUF_SIZE>(buf, random_words);
+    static_cast<void>(sink);
+  }
+}
+
+// --- Oblivious compaction ( the values and the keep masks are secret ) ---
+
+template<typename T>
+void
+verify_ct_compact()
+{
+  constexpr size_t FIXED_BUF_SIZE = 45;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<T> dis(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+  std::bernoulli_distribution keep_dis(0.5);
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<T, FIXED_BUF_SIZE> buf{};
+    std::ranges::generate(buf, [&]() { return dis(gen); });
+
+    std::array<uint32_t, FIXED_BUF_SIZE> keep_masks{};
+    std::ranges::generate(keep_masks, [&]() { return keep_dis(gen) ? std::numeric_limits<uint32_t>::max() : 0U; });
+
+    std::array<uint32_t, FIXED_BUF_SIZE> scratch{};
+
+    CT_POISON(buf.data(), buf.size() * sizeof(T));
+    CT_POISON(keep_masks.data(), keep_masks.size() * sizeof(uint32_t));
+
+    volatile size_t sink = subtle::ct_compact<T, uint32_t, FIXED_BUF_SIZE>(buf, keep_masks, scratch);
+    static_cast<void>(sink);
+  }
+}
+
+// --- Multi-precision add / sub / conditional subtract ( all operands are secret ) ---
+
+template<typename limbT, size_t N>
+void
+verify_ct_add_sub()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<limbT, N> a{};
+    std::array<limbT, N> b{};
+    std::array<limbT, N> r{};
+    std::ranges::generate(a, [&]() { return static_cast<limbT>(gen()); });
+    std::ranges::generate(b, [&]() { return static_cast<limbT>(gen()); });
+    auto hi = static_cast<limbT>(gen() & 1U);
+
+    CT_POISON(a.data(), a.size() * sizeof(limbT));
+    CT_POISON(b.data(), b.size() * sizeof(limbT));
+    CT_POISON(&hi, sizeof(hi));
+
+    volatile uint32_t sink = subtle::ct_add_carry<limbT, uint32_t, N>(r, a, b);
+    sink = subtle::ct_sub_borrow<limbT, uint32_t, N>(r, a, b);
+    sink = subtle::ct_cond_sub<limbT, uint32_t, N>(a, b, hi);
+    sink = subtle::ct_cond_sub<limbT, uint32_t>(std::span<limbT>(a), std::span<const limbT>(b), hi);
+    static_cast<void>(sink);
+  }
+}
+
+// --- Montgomery arithmetic ( the modulus is public, the operands are secret ) ---
+
+template<size_t LIMBS>
+void
+verify_ct_montgomery()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  std::array<uint64_t, LIMBS> n{};
+  std::ranges::generate(n, [&]() { return gen(); });
+  n[0] |= 1U;
+  n[LIMBS - 1] |= 1ULL << 63;
+
+  const subtle::ct_montgomery<LIMBS> mont(n);
+
+  for (size_t i = 0; i < ITERATIONS / 256; i++) {
+    std::array<uint64_t, LIMBS> a{};
+    std::array<uint64_t, LIMBS> b{};
+    std::ranges::generate(a, [&]() { return gen(); });
+    std::ranges::generate(b, [&]() { return gen(); });
+    a[LIMBS - 1] >>= 1;
+    b[LIMBS - 1] >>= 1;
+
+    CT_POISON(a.data(), a.size() * sizeof(uint64_t));
+    CT_POISON(b.data(), b.size() * sizeof(uint64_t));
+
+    mont.to_montgomery(a, a);
+    mont.to_montgomery(b, b);
+    mont.mul(a, a, b);
+    mont.sqr(b, b);
+    mont.from_montgomery(a, a);
+
+    volatile uint64_t sink = a[0] ^ b[0];
+    static_cast<void>(sink);
+  }
+}
+
+// --- safegcd inversion ( the modulus is public, the input is secret ) ---
+
+void
+verify_ct_modinv()
+{
+  constexpr std::array<uint64_t, 4> P256 = { 0xffffffffffffffffULL, 0x00000000ffffffffULL, 0, 0xffffffff00000001ULL };
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const subtle::ct_modinv<4> modinv(P256);
+
+  for (size_t i = 0; i < ITERATIONS / 256; i++) {
+    std::array<uint64_t, 4> a{};
+    std::ranges::generate(a, [&]() { return gen(); });
+    a[3] >>= 1;
+
+    CT_POISON(a.data(), a.size() * sizeof(uint64_t));
+
+    modinv.invert(a, a);
+
+    volatile uint64_t sink = a[0];
+    static_cast<void>(sink);
+  }
+}
+
+// --- Division by a constant ---
+
+template<typename operandT>
+void
+verify_ct_div()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<operandT> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    std::array<operandT, 4> vals{};
+    std::ranges::generate(vals, [&]() { return dis(gen); });
+
+    CT_POISON(vals.data(), vals.size() * sizeof(operandT));
+
+    const operandT quot = subtle::ct_div<3329>(vals[0]);
+    const operandT rem = subtle::ct_mod<251>(vals[1]);
+    const operandT rounded = subtle::ct_div_round<7>(static_cast<operandT>(vals[2] >> 1));
+    subtle::ct_mod<12>(std::span(vals));
+
+    volatile operandT sink = quot ^ rem ^ rounded ^ vals[3];
+    static_cast<void>(sink);
+  }
+}
+
+template<typename operandT>
+void
+verify_ct_divmod()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<operandT> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 16; i++) {
+    std::array<operandT, 2> vals = { dis(gen), static_cast<operandT>(dis(gen) >> (i % 8)) };
+    if (i % 64 == 0) {
+      vals[1] = 0;
+    }
+
+    CT_POISON(vals.data(), vals.size() * sizeof(operandT));
+
+    operandT quot{};
+    operandT rem{};
+    const auto is_zero = subtle::ct_divmod<operandT, uint32_t>(vals[0], vals[1], quot, rem);
+
+    volatile operandT sink = quot ^ rem ^ static_cast<operandT>(is_zero);
+    static_cast<void>(sink);
+  }
+}
+
+// --- Signed arithmetic helpers ---
+
+template<typename operandT>
+void
+verify_ct_signed_arith()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int64_t> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<operandT, 67> vals{};
+    std::ranges::generate(vals, [&]() { return static_cast<operandT>(dis(gen)); });
+    uint32_t br = static_cast<uint32_t>(0U - (gen() & 1U));
+
+    CT_POISON(vals.data(), vals.size() * sizeof(operandT));
+    CT_POISON(&br, sizeof(br));
+
+    const operandT abs = subtle::ct_abs(vals[0]);
+    const operandT sign = subtle::ct_sign(vals[1]);
+    const operandT neg = subtle::ct_cneg(br, vals[2]);
+    const operandT clamped = subtle::ct_clamp(vals[3], operandT{ -100 }, operandT{ 100 });
+
+    subtle::ct_abs(std::span(vals));
+    subtle::ct_cneg(br, std::span(vals));
+    subtle::ct_clamp(std::span(vals), operandT{ -100 }, operandT{ 100 });
+    subtle::ct_sign(std::span(vals));
+
+    volatile operandT sink = abs ^ sign ^ neg ^ clamped ^ vals[4];
+    static_cast<void>(sink);
+  }
+}
+
+template<typename operandT>
+void
+verify_ct_span_reduce()
+{
+  using maskT = std::make_unsigned_t<operandT>;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int64_t> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<operandT, 67> vals{};
+    std::array<maskT, 67> masks{};
+    std::ranges::generate(vals, [&]() { return static_cast<operandT>(dis(gen)); });
+    std::ranges::generate(masks, [&]() { return static_cast<maskT>(0U - (gen() & 1U)); });
+
+    CT_POISON(vals.data(), vals.size() * sizeof(operandT));
+    CT_POISON(masks.data(), masks.size() * sizeof(maskT));
+
+    const std::span<const operandT, 67> cvals = vals;
+    const std::span<const maskT, 67> cmasks = masks;
+
+    const operandT min = subtle::ct_min(cvals);
+    const operandT max = subtle::ct_max(cvals);
+    const size_t argmin = subtle::ct_argmin(cvals);
+    const size_t argmax = subtle::ct_argmax(cvals);
+    const maskT all = subtle::ct_all(cmasks);
+    const maskT any = subtle::ct_any(cmasks);
+
+    volatile size_t sink = static_cast<size_t>(min ^ max) ^ argmin ^ argmax ^ all ^ any;
+    static_cast<void>(sink);
+  }
+}
+
+template<typename operandT, typename maskT>
+void
+verify_ct_elementwise()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int64_t> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<operandT, 67> x{};
+    std::array<operandT, 67> y{};
+    std::array<maskT, 67> masks{};
+    std::ranges::generate(x, [&]() { return static_cast<operandT>(dis(gen)); });
+    std::ranges::generate(y, [&]() { return static_cast<operandT>(dis(gen)); });
+
+    CT_POISON(x.data(), x.size() * sizeof(operandT));
+    CT_POISON(y.data(), y.size() * sizeof(operandT));
+
+    subtle::ct_eq_each(std::span(masks), std::span<const operandT, 67>(x), std::span<const operandT, 67>(y));
+    subtle::ct_lt_each(std::span(masks), std::span<const operandT, 67>(x), std::span<const operandT, 67>(y));
+    subtle::ct_select_each(std::span(x), std::span<const maskT, 67>(masks), std::span<const operandT, 67>(x), std::span<const operandT, 67>(y));
+
+    volatile operandT sink = x[0];
+    static_cast<void>(sink);
+  }
+}
+
+template<typename operandT>
+void
+verify_ct_popcount()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int64_t> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<operandT, 131> x{};
+    std::array<operandT, 131> y{};
+    std::ranges::generate(x, [&]() { return static_cast<operandT>(dis(gen)); });
+    std::ranges::generate(y, [&]() { return static_cast<operandT>(dis(gen)); });
+
+    CT_POISON(x.data(), x.size() * sizeof(operandT));
+    CT_POISON(y.data(), y.size() * sizeof(operandT));
+
+    const size_t pop = subtle::ct_popcount(x[0]);
+    const size_t weight = subtle::ct_hamming_weight(std::span<const operandT, 131>(x));
+    const size_t distance = subtle::ct_hamming_distance(std::span<const operandT, 131>(x), std::span<const operandT, 131>(y));
+
+    volatile size_t sink = pop ^ weight ^ distance;
+    static_cast<void>(sink);
+  }
+}
+
+template<typename operandT>
+void
+verify_ct_bit_scan()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int64_t> dis(std::numeric_limits<operandT>::min(), std::numeric_limits<operandT>::max());
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    auto x = static_cast<operandT>(dis(gen));
+    CT_POISON(&x, sizeof(x));
+
+    volatile size_t sink = subtle::ct_bit_length(x) ^ subtle::ct_clz(x) ^ subtle::ct_ctz(x);
+    static_cast<void>(sink);
+  }
+}
+
+template<typename limbT>
+void
+verify_ct_bit_scan_limbs()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 16; i++) {
+    std::array<limbT, 8> x{};
+    std::ranges::generate(x, [&]() { return gen() % 2 == 0 ? limbT{ 0 } : static_cast<limbT>(gen()); });
+    CT_POISON(x.data(), x.size() * sizeof(limbT));
+
+    const std::span<const limbT, 8> cx = x;
+    volatile size_t sink = subtle::ct_bit_length(cx) ^ subtle::ct_clz(cx) ^ subtle::ct_ctz(cx);
+    static_cast<void>(sink);
+  }
+}
+
+template<size_t BITS>
+void
+verify_ct_bitvec()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 256; i++) {
+    std::array<uint64_t, subtle::ct_bitvec<BITS>::word_count> words{};
+    std::ranges::generate(words, [&]() { return gen(); });
+
+    subtle::ct_bitvec<BITS> a(words);
+    subtle::ct_bitvec<BITS> b(words);
+    uint64_t amount = gen();
+
+    CT_POISON(a.words().data(), a.words().size() * sizeof(uint64_t));
+    CT_POISON(&amount, sizeof(amount));
+
+    subtle::ct_rotate(a, amount);
+    b ^= a;
+
+    volatile size_t sink = b.weight();
+    static_cast<void>(sink);
+  }
+}
+
+void
+verify_ct_rotate_extract()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<uint8_t, 131> record{};
+    std::ranges::generate(record, [&]() { return static_cast<uint8_t>(gen()); });
+    auto offset = static_cast<uint32_t>(gen() % (record.size() - 20 + 1));
+
+    CT_POISON(record.data(), record.size());
+    CT_POISON(&offset, sizeof(offset));
+
+    std::array<uint8_t, 20> mac{};
+    std::array<uint8_t, 20> scratch{};
+    subtle::ct_extract(std::span(mac), std::span<const uint8_t, 131>(record), offset, std::span(scratch));
+
+    std::array<uint8_t, 131> rot_scratch{};
+    subtle::ct_rotate_bytes(std::span(record), offset, std::span(rot_scratch));
+
+    volatile uint8_t sink = mac[0] ^ record[0];
+    static_cast<void>(sink);
+  }
+}
+
+template<typename T>
+void
+verify_ct_prefix()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<T, 77> dst{};
+    std::array<T, 77> src{};
+    std::ranges::generate(src, [&]() { return static_cast<T>(gen()); });
+    auto len = static_cast<size_t>(gen() % (src.size() + 8));
+
+    CT_POISON(src.data(), src.size() * sizeof(T));
+    CT_POISON(&len, sizeof(len));
+
+    subtle::ct_memcpy_prefix(std::span(dst), std::span<const T, 77>(src), len);
+    const auto eq = subtle::ct_memcmp_prefix<T, uint32_t>(std::span<const T, 77>(dst), std::span<const T, 77>(src), len);
+
+    volatile T sink = static_cast<T>(dst[0] ^ static_cast<T>(eq));
+    static_cast<void>(sink);
+  }
+}
+
+template<size_t N>
+void
+verify_ct_padding()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<uint8_t, N> block{};
+    std::ranges::generate(block, [&]() { return static_cast<uint8_t>(gen()); });
+
+    // Well-formed padding half of the time, so that both outcomes are exercised
+    if (gen() % 2 == 0) {
+      const size_t p = 1 + gen() % (N - 11);
+      std::ranges::fill(std::span(block).last(p), static_cast<uint8_t>(p));
+      block[0] = 0x00;
+      block[1] = 0x02;
+    }
+
+    CT_POISON(block.data(), block.size());
+
+    size_t len7 = 0;
+    size_t len_iso = 0;
+    size_t len1 = 0;
+    const auto ok7 = subtle::ct_pkcs7_unpad<uint32_t>(std::span<const uint8_t, N>(block), len7);
+    const auto ok_iso = subtle::ct_iso7816_unpad<uint32_t>(std::span<const uint8_t, N>(block), len_iso);
+    const auto ok1 = subtle::ct_pkcs1_v15_unpad<uint32_t>(std::span<const uint8_t, N>(block), len1);
+
+    volatile size_t sink = (ok7 ^ ok_iso ^ ok1) + len7 + len_iso + len1;
+    static_cast<void>(sink);
+  }
+}
+
+template<typename T>
+void
+verify_ct_find()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<T, 77> vals{};
+    std::ranges::generate(vals, [&]() { return static_cast<T>(gen() % 8); });
+    auto value = static_cast<T>(gen() % 8);
+
+    CT_POISON(vals.data(), vals.size() * sizeof(T));
+    CT_POISON(&value, sizeof(value));
+
+    size_t first = 0;
+    size_t last = 0;
+    const auto f = subtle::ct_find_first<T, uint32_t>(std::span<const T, 77>(vals), value, first);
+    const auto l = subtle::ct_find_last<T, uint32_t>(std::span<const T, 77>(vals), value, last);
+
+    volatile size_t sink = (f ^ l) + first + last;
+    static_cast<void>(sink);
+  }
+}
+
+// Hex and Base64 encoding and decoding of a secret: the decoders see secret text, with
+// invalid characters in it half of the time, so that both outcomes are exercised
+template<size_t N>
+void
+verify_ct_codec()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<uint8_t, N> key{};
+    std::ranges::generate(key, [&]() { return static_cast<uint8_t>(gen()); });
+
+    std::array<char, 2 * N> hex{};
+    std::array<char, subtle::ct_base64_encoded_size(N)> b64{};
+    std::array<char, subtle::ct_base64_encoded_size<true>(N)> url{};
+
+    subtle::ct_hex_encode(std::span(hex), std::span<const uint8_t, N>(key));
+    subtle::ct_base64_encode(std::span(b64), std::span<const uint8_t, N>(key));
+    subtle::ct_base64_encode<true>(std::span(url), std::span<const uint8_t, N>(key));
+
+    if (gen() % 2 == 0) {
+      hex[gen() % hex.size()] = '#';
+      b64[gen() % (N / 3 * 4)] = '=';
+      url[gen() % url.size()] = '+';
+    }
+
+    // The '=' padding of the standard alphabet is as public as the length of the key
+    CT_POISON(key.data(), key.size());
+    CT_POISON(hex.data(), hex.size());
+    CT_POISON(b64.data(), url.size());
+    CT_POISON(url.data(), url.size());
+
+    std::array<char, hex.size()> enc_hex{};
+    std::array<char, b64.size()> enc_b64{};
+    std::array<char, url.size()> enc_url{};
+    subtle::ct_hex_encode(std::span(enc_hex), std::span<const uint8_t, N>(key));
+    subtle::ct_base64_encode(std::span(enc_b64), std::span<const uint8_t, N>(key));
+    subtle::ct_base64_encode<true>(std::span(enc_url), std::span<const uint8_t, N>(key));
+
+    std::array<uint8_t, N> out{};
+    const auto ok_hex = subtle::ct_hex_decode<uint32_t>(std::span(out), std::span<const char, 2 * N>(hex));
+    const auto ok_b64 = subtle::ct_base64_decode<uint32_t>(std::span(out), std::span<const char, b64.size()>(b64));
+    const auto ok_url = subtle::ct_base64_decode<uint32_t, true>(std::span(out), std::span<const char, url.size()>(url));
+
+    volatile uint32_t sink = ok_hex ^ ok_b64 ^ ok_url ^ out[0] ^ static_cast<uint8_t>(enc_hex[0] ^ enc_b64[0] ^ enc_url[0]);
+    static_cast<void>(sink);
+  }
+}
+
+// GF(2^m) arithmetic on secret elements: products, inverses ( zero among the inputs ),
+// and the span kernels, with secret scalar, coefficients and points
+template<size_t m, uint32_t poly, typename T>
+void
+verify_ct_gf()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto random_elem = [&]() { return static_cast<T>(gen() & ((uint64_t{ 1 } << m) - 1U)); };
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<T, 77> a{};
+    std::array<T, 77> b{};
+    std::array<T, 5> coeffs{};
+    std::ranges::generate(a, random_elem);
+    std::ranges::generate(b, random_elem);
+    std::ranges::generate(coeffs, random_elem);
+    a[0] = 0;
+    T c = random_elem();
+
+    CT_POISON(a.data(), a.size() * sizeof(T));
+    CT_POISON(b.data(), b.size() * sizeof(T));
+    CT_POISON(coeffs.data(), coeffs.size() * sizeof(T));
+    CT_POISON(&c, sizeof(c));
+
+    const T prod = subtle::ct_gf_mul<m, poly>(a[1], b[1]);
+    const T inv = static_cast<T>(subtle::ct_gf_inv<m, poly>(a[0]) ^ subtle::ct_gf_inv<m, poly>(b[2]));
+
+    std::array<T, 77> out{};
+    subtle::ct_gf_mul_span<m, poly>(std::span(out), std::span<const T, 77>(a), std::span<const T, 77>(b));
+    subtle::ct_gf_muladd_span<m, poly>(std::span(out), std::span<const T, 77>(b), c);
+
+    std::array<T, 77> ys{};
+    subtle::ct_gf_poly_eval<m, poly>(std::span(ys), std::span<const T, 77>(a), std::span<const T, 5>(coeffs));
+
+    volatile T sink = static_cast<T>(prod ^ inv ^ out[0] ^ ys[76]);
+    static_cast<void>(sink);
+  }
+}
+
+// --- Lattice coefficient normalization ---
+
+template<typename coeffT, size_t N>
+void
+verify_ct_lattice(const coeffT q)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int32_t> dis(-q, 2 * q - 1);
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<coeffT, N> vals{};
+    std::ranges::generate(vals, [&]() { return static_cast<coeffT>(dis(gen)); });
+
+    CT_POISON(vals.data(), vals.size() * sizeof(coeffT));
+
+    subtle::ct_cond_add_if_negative(std::span(vals), q);
+    subtle::ct_freeze_mod(std::span(vals), q);
+    subtle::ct_center(std::span(vals), q);
+
+    volatile coeffT sink = vals[0];
+    static_cast<void>(sink);
+  }
+}
+
 // --- Zeroize ---
 
 template<typename T>
@@ -614,6 +1374,12 @@ struct lookup_wrapper
   void operator()() { verify_ct_lookup<OpT, RetT>(); }
 };
 
+template<typename OpT, typename RetT>
+struct table_wrapper
+{
+  void operator()() { verify_ct_table<OpT, RetT>(); }
+};
+
 template<typename T>
 struct zeroize_wrapper
 {
@@ -632,6 +1398,30 @@ struct max_wrapper
   void operator()() { verify_ct_max<T>(); }
 };
 
+template<typename T>
+struct sort_wrapper
+{
+  void operator()() { verify_ct_sort<T>(); }
+};
+
+template<typename T>
+struct permute_wrapper
+{
+  void operator()() { verify_ct_permute<T>(); }
+};
+
+template<typename T>
+struct shuffle_wrapper
+{
+  void operator()() { verify_ct_shuffle<T>(); }
+};
+
+template<typename T>
+struct compact_wrapper
+{
+  void operator()() { verify_ct_compact<T>(); }
+};
+
 } // anonymous namespace
 
 int
@@ -690,6 +1480,128 @@ main()
   std::puts("  ct_lookup...");
   verify_all_types<lookup_wrapper>();
 
+  std::puts("  ct_table...");
+  verify_all_types<table_wrapper>();
+
+  std::puts("  ct_transpose8x8 / ct_transpose32x32 / ct_transpose64x64...");
+  verify_ct_transpose<uint8_t>();
+  verify_ct_transpose<uint32_t>();
+  verify_ct_transpose<uint64_t>();
+
+  std::puts("  ct_sbox_bitsliced...");
+  verify_ct_sbox_bitsliced();
+
+  std::puts("  ct_sort...");
+  verify_all_element_types<sort_wrapper>();
+
+  std::puts("  ct_benes_control_bits / ct_permute...");
+  verify_all_element_types<permute_wrapper>();
+
+  std::puts("  ct_shuffle...");
+  shuffle_wrapper<uint8_t>()();
+  shuffle_wrapper<uint16_t>()();
+  shuffle_wrapper<uint32_t>()();
+  shuffle_wrapper<int8_t>()();
+  shuffle_wrapper<int16_t>()();
+  shuffle_wrapper<int32_t>()();
+
+  std::puts("  ct_compact...");
+  verify_all_element_types<compact_wrapper>();
+
+  std::puts("  ct_add_carry / ct_sub_borrow / ct_cond_sub...");
+  verify_ct_add_sub<uint32_t, 8>();
+  verify_ct_add_sub<uint32_t, 13>();
+  verify_ct_add_sub<uint64_t, 4>();
+  verify_ct_add_sub<uint64_t, 9>();
+
+  std::puts("  ct_montgomery...");
+  verify_ct_montgomery<4>();
+  verify_ct_montgomery<7>();
+  verify_ct_montgomery<32>();
+
+  std::puts("  ct_modinv...");
+  verify_ct_modinv();
+
+  std::puts("  ct_div / ct_mod / ct_div_round...");
+  verify_ct_div<uint16_t>();
+  verify_ct_div<uint32_t>();
+  verify_ct_div<uint64_t>();
+
+  std::puts("  ct_divmod...");
+  verify_ct_divmod<uint32_t>();
+  verify_ct_divmod<uint64_t>();
+  verify_ct_divmod<int32_t>();
+  verify_ct_divmod<int64_t>();
+
+  std::puts("  ct_abs / ct_sign / ct_cneg / ct_clamp...");
+  verify_ct_signed_arith<int8_t>();
+  verify_ct_signed_arith<int16_t>();
+  verify_ct_signed_arith<int32_t>();
+  verify_ct_signed_arith<int64_t>();
+
+  std::puts("  ct_min / ct_max / ct_argmin / ct_argmax / ct_all / ct_any over spans...");
+  verify_ct_span_reduce<uint8_t>();
+  verify_ct_span_reduce<int16_t>();
+  verify_ct_span_reduce<uint32_t>();
+  verify_ct_span_reduce<int64_t>();
+
+  std::puts("  ct_eq_each / ct_lt_each / ct_select_each...");
+  verify_ct_elementwise<uint8_t, uint8_t>();
+  verify_ct_elementwise<int16_t, uint16_t>();
+  verify_ct_elementwise<uint32_t, uint32_t>();
+  verify_ct_elementwise<int64_t, uint64_t>();
+  verify_ct_elementwise<int32_t, uint8_t>();
+
+  std::puts("  ct_popcount / ct_hamming_weight / ct_hamming_distance...");
+  verify_ct_popcount<uint8_t>();
+  verify_ct_popcount<int16_t>();
+  verify_ct_popcount<uint32_t>();
+  verify_ct_popcount<int64_t>();
+
+  std::puts("  ct_bit_length / ct_clz / ct_ctz...");
+  verify_ct_bit_scan<uint8_t>();
+  verify_ct_bit_scan<int16_t>();
+  verify_ct_bit_scan<uint32_t>();
+  verify_ct_bit_scan<int64_t>();
+  verify_ct_bit_scan_limbs<uint32_t>();
+  verify_ct_bit_scan_limbs<uint64_t>();
+
+  std::puts("  ct_bitvec / ct_rotate...");
+  verify_ct_bitvec<257>();
+  verify_ct_bitvec<12323>();
+
+  std::puts("  ct_rotate_bytes / ct_extract...");
+  verify_ct_rotate_extract();
+
+  std::puts("  ct_memcpy_prefix / ct_memcmp_prefix...");
+  verify_ct_prefix<uint8_t>();
+  verify_ct_prefix<uint32_t>();
+
+  std::puts("  ct_pkcs7_unpad / ct_iso7816_unpad / ct_pkcs1_v15_unpad...");
+  verify_ct_padding<16>();
+  verify_ct_padding<77>();
+  verify_ct_padding<256>();
+
+  std::puts("  ct_find_first / ct_find_last...");
+  verify_ct_find<uint8_t>();
+  verify_ct_find<uint16_t>();
+  verify_ct_find<uint64_t>();
+
+  std::puts("  ct_hex_encode / ct_hex_decode / ct_base64_encode / ct_base64_decode...");
+  verify_ct_codec<32>();
+  verify_ct_codec<77>();
+
+  std::puts("  ct_gf_mul / ct_gf_inv / ct_gf_mul_span / ct_gf_muladd_span / ct_gf_poly_eval...");
+  verify_ct_gf<8, 0x11b, uint8_t>();
+  verify_ct_gf<8, 0x11d, uint8_t>();
+  verify_ct_gf<13, 0x201b, uint16_t>();
+
+  std::puts("  ct_freeze_mod / ct_center / ct_cond_add_if_negative...");
+  verify_ct_lattice<int16_t, 256>(3329);
+  verify_ct_lattice<int16_t, 67>(12289);
+  verify_ct_lattice<int32_t, 256>(8380417);
+  verify_ct_lattice<int32_t, 67>(8380417);
+
   std::puts("  ct_zeroize...");
   verify_all_element_types<zeroize_wrapper>();
 
@@ -1,10 +1,26 @@
 #pragma once
 #include "subtle.hpp"
+#include "subtle/ct_bigint.hpp"
+#include "subtle/ct_bitvec.hpp"
+#include "subtle/ct_bitslice.hpp"
+#include "subtle/ct_codec.hpp"
+#include "subtle/ct_gf.hpp"
+#include "subtle/ct_lattice.hpp"
+#include "subtle/ct_padding.hpp"
+#include "subtle/ct_permute.hpp"
+#include "subtle/ct_sort.hpp"
+#include "subtle/ct_table.hpp"
 #include <algorithm>
+#include <bit>
+#include <cctype>
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <limits>
+#include <map>
+#include <numeric>
 #include <random>
+#include <string>
+#include <string_view>
 #include <vector>
 
 // Test cases for ensuring functional correctness of constant-time comparison
@@ -396,176 +412,2152 @@ test_ct_max()
   }
 }
 
+// Test functional correctness of constant-time compare-exchange operation over
+// integer types, checking the result against std::min and std::max.
+template<typename operandT>
+void
+test_ct_minmax()
+  requires(subtle::ct_operand<operandT>)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const operandT x = dis(gen);
+    const operandT y = dis(gen);
+
+    operandT a = x;
+    operandT b = y;
+    subtle::ct_minmax(a, b);
+
+    ASSERT_EQ(a, std::min(x, y));
+    ASSERT_EQ(b, std::max(x, y));
+  }
+}
+
+// Test functional correctness of ct_abs ( signed operandT only ), ct_sign, ct_cneg and
+// ct_clamp against their branching counterparts, on random and extreme values, as
+// scalars and over spans -- of fixed extent 256, and of every length up to 67, to
+// cover both the vector kernels and their scalar tails.
+template<typename operandT>
+void
+test_ct_signed_arith()
+  requires(subtle::ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr auto min = std::numeric_limits<operandT>::min();
+  constexpr auto max = std::numeric_limits<operandT>::max();
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  const auto ref_abs = [](const operandT x) { return x < 0 ? static_cast<operandT>(0U - static_cast<Uop>(x)) : x; };
+  const auto ref_sign = [](const operandT x) { return static_cast<operandT>((x > 0) - (x < 0)); };
+  const auto ref_neg = [](const operandT x) { return static_cast<operandT>(0U - static_cast<Uop>(x)); };
+
+  std::vector<operandT> xs = { min, max, operandT{ 0 }, operandT{ 1 }, static_cast<operandT>(max - 1), static_cast<operandT>(min + 1) };
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    xs.push_back(dis(gen));
+  }
+
+  for (const operandT x : xs) {
+    if constexpr (std::is_signed_v<operandT>) {
+      ASSERT_EQ(subtle::ct_abs(x), ref_abs(x));
+    }
+    ASSERT_EQ(subtle::ct_sign(x), ref_sign(x));
+    ASSERT_EQ(subtle::ct_cneg(std::numeric_limits<uint32_t>::max(), x), ref_neg(x));
+    ASSERT_EQ(subtle::ct_cneg(uint8_t{ 0 }, x), x);
+
+    operandT lo = dis(gen);
+    operandT hi = dis(gen);
+    if (lo > hi) {
+      std::swap(lo, hi);
+    }
+    ASSERT_EQ(subtle::ct_clamp(x, lo, hi), std::clamp(x, lo, hi));
+  }
+
+  const auto check = [&]<size_t N>(std::span<operandT, N> vals) {
+    std::ranges::generate(vals, [&]() { return dis(gen); });
+    vals[0] = min;
+    vals[vals.size() - 1] = operandT{ 0 };
+
+    const std::vector<operandT> orig(vals.begin(), vals.end());
+
+    if constexpr (std::is_signed_v<operandT>) {
+      subtle::ct_abs(vals);
+      for (size_t i = 0; i < vals.size(); i++) {
+        ASSERT_EQ(vals[i], ref_abs(orig[i]));
+      }
+      std::ranges::copy(orig, vals.begin());
+    }
+
+    subtle::ct_sign(vals);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], ref_sign(orig[i]));
+    }
+
+    std::ranges::copy(orig, vals.begin());
+    subtle::ct_cneg(uint16_t{ 0xffff }, vals);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], ref_neg(orig[i]));
+    }
+
+    subtle::ct_cneg(uint64_t{ 0 }, vals);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], ref_neg(orig[i]));
+    }
+
+    const operandT lo = std::min(orig[1 % vals.size()], static_cast<operandT>(orig[1 % vals.size()] / 2));
+    const operandT hi = std::max(orig[1 % vals.size()], static_cast<operandT>(orig[1 % vals.size()] / 2));
+
+    std::ranges::copy(orig, vals.begin());
+    subtle::ct_clamp(vals, lo, hi);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], std::clamp(orig[i], lo, hi));
+    }
+  };
+
+  for (size_t i = 0; i < 16; i++) {
+    std::array<operandT, 256> arr{};
+    check(std::span(arr));
+  }
+
+  for (size_t len = 1; len <= 67; len++) {
+    std::vector<operandT> vals(len);
+    check(std::span(vals));
+  }
+}
+
+// Test functional correctness of the span reductions ct_min, ct_max, ct_argmin, ct_argmax
+// ( against std::ranges::min / max / min_element / max_element, ties included ) and of
+// ct_all / ct_any over masks of the unsigned type of the same width, over spans of fixed
+// extent 256 and of every length up to 67.
+template<typename operandT>
+void
+test_ct_span_reduce()
+  requires(subtle::ct_operand<operandT>)
+{
+  using maskT = std::make_unsigned_t<operandT>;
+  constexpr auto truth = std::numeric_limits<maskT>::max();
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  const auto check = [&]<size_t N>(std::span<operandT, N> vals, std::span<maskT, N> masks, const bool ties) {
+    std::ranges::generate(vals, [&]() { return ties ? static_cast<operandT>(dis(gen) & 3) : dis(gen); });
+    const std::span<const operandT, N> cvals = vals;
+
+    ASSERT_EQ(subtle::ct_min(cvals), std::ranges::min(vals));
+    ASSERT_EQ(subtle::ct_max(cvals), std::ranges::max(vals));
+    ASSERT_EQ(subtle::ct_argmin(cvals), static_cast<size_t>(std::ranges::min_element(vals) - vals.begin()));
+    ASSERT_EQ(subtle::ct_argmax(cvals), static_cast<size_t>(std::ranges::max_element(vals) - vals.begin()));
+
+    // Masks mostly one way, with a few -- or none -- the other way
+    for (const bool flip : { false, true }) {
+      std::ranges::generate(masks, [&]() { return (gen() % 64 == 0) ^ flip ? truth : maskT{ 0 }; });
+      const std::span<const maskT, N> cmasks = masks;
+
+      const bool all = std::ranges::all_of(masks, [](const maskT m) { return m != 0; });
+      const bool any = std::ranges::any_of(masks, [](const maskT m) { return m != 0; });
+      ASSERT_EQ(subtle::ct_all(cmasks), all ? truth : maskT{ 0 });
+      ASSERT_EQ(subtle::ct_any(cmasks), any ? truth : maskT{ 0 });
+    }
+  };
+
+  for (size_t i = 0; i < 16; i++) {
+    std::array<operandT, 256> vals{};
+    std::array<maskT, 256> masks{};
+    check(std::span(vals), std::span(masks), i % 2 == 0);
+  }
+
+  for (size_t len = 1; len <= 67; len++) {
+    std::vector<operandT> vals(len);
+    std::vector<maskT> masks(len);
+    check(std::span(vals), std::span(masks), len % 2 == 0);
+  }
+
+  ASSERT_EQ(subtle::ct_all(std::span<const maskT>{}), truth);
+  ASSERT_EQ(subtle::ct_any(std::span<const maskT>{}), maskT{ 0 });
+}
+
+// Test functional correctness of the elementwise ct_eq_each, ct_lt_each and ct_select_each
+// against their per-element scalar counterparts, over spans of fixed extent 256 and of
+// every length up to 67 -- with half the elements made equal, so that both masks occur --
+// including ct_select_each writing in place over one of its sources.
+template<typename operandT, typename maskT>
+void
+test_ct_elementwise()
+  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<maskT>)
+{
+  constexpr auto truth = std::numeric_limits<maskT>::max();
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  const auto check = [&]<size_t N>(std::span<operandT, N> x, std::span<operandT, N> y, std::span<operandT, N> dst, std::span<maskT, N> masks) {
+    std::ranges::generate(x, [&]() { return dis(gen); });
+    std::ranges::generate(y, [&]() { return dis(gen); });
+    for (size_t i = 0; i < x.size(); i += 2) {
+      y[i] = x[i];
+    }
+
+    const std::span<const operandT, N> cx = x;
+    const std::span<const operandT, N> cy = y;
+    const std::span<const maskT, N> cmasks = masks;
+
+    subtle::ct_eq_each(masks, cx, cy);
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_EQ(masks[i], x[i] == y[i] ? truth : maskT{ 0 });
+    }
+
+    subtle::ct_lt_each(masks, cx, cy);
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_EQ(masks[i], x[i] < y[i] ? truth : maskT{ 0 });
+    }
+
+    subtle::ct_select_each(dst, cmasks, cx, cy);
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_EQ(dst[i], std::min(x[i], y[i]));
+    }
+
+    // In place, over the second source
+    const std::vector<operandT> orig(y.begin(), y.end());
+    subtle::ct_lt_each(masks, cy, cx);
+    subtle::ct_select_each(y, cmasks, cx, cy);
+    for (size_t i = 0; i < x.size(); i++) {
+      ASSERT_EQ(y[i], std::max(x[i], orig[i]));
+    }
+  };
+
+  for (size_t i = 0; i < 16; i++) {
+    std::array<operandT, 256> x{};
+    std::array<operandT, 256> y{};
+    std::array<operandT, 256> dst{};
+    std::array<maskT, 256> masks{};
+    check(std::span(x), std::span(y), std::span(dst), std::span(masks));
+  }
+
+  for (size_t len = 1; len <= 67; len++) {
+    std::vector<operandT> x(len);
+    std::vector<operandT> y(len);
+    std::vector<operandT> dst(len);
+    std::vector<maskT> masks(len);
+    check(std::span(x), std::span(y), std::span(dst), std::span(masks));
+  }
+}
+
+// Test functional correctness of ct_popcount against std::popcount, and of the span
+// ct_hamming_weight / ct_hamming_distance against per-element sums of it, over spans of
+// fixed extent 256, of every length up to 67 and of a length spanning more than one
+// 31-register block of the AVX2 kernel -- the latter also with every bit set.
+template<typename operandT>
+void
+test_ct_popcount()
+  requires(subtle::ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  static_assert(subtle::ct_popcount(static_cast<operandT>(0)) == 0);
+  static_assert(subtle::ct_popcount(static_cast<operandT>(-1)) == std::numeric_limits<Uop>::digits);
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const operandT x = dis(gen);
+    ASSERT_EQ(subtle::ct_popcount(x), static_cast<size_t>(std::popcount(static_cast<Uop>(x))));
+  }
+
+  const auto check = [&]<size_t N>(std::span<operandT, N> x, std::span<operandT, N> y, const bool ones) {
+    std::ranges::generate(x, [&]() { return ones ? static_cast<operandT>(-1) : dis(gen); });
+    std::ranges::generate(y, [&]() { return dis(gen); });
+
+    size_t weight = 0;
+    size_t distance = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+      weight += static_cast<size_t>(std::popcount(static_cast<Uop>(x[i])));
+      distance += static_cast<size_t>(std::popcount(static_cast<Uop>(x[i] ^ y[i])));
+    }
+
+    ASSERT_EQ(subtle::ct_hamming_weight(std::span<const operandT, N>(x)), weight);
+    ASSERT_EQ(subtle::ct_hamming_distance(std::span<const operandT, N>(x), std::span<const operandT, N>(y)), distance);
+  };
+
+  for (size_t i = 0; i < 16; i++) {
+    std::array<operandT, 256> x{};
+    std::array<operandT, 256> y{};
+    check(std::span(x), std::span(y), false);
+  }
+
+  for (size_t len = 0; len <= 67; len++) {
+    std::vector<operandT> x(len);
+    std::vector<operandT> y(len);
+    check(std::span(x), std::span(y), false);
+  }
+
+  for (const bool ones : { false, true }) {
+    std::vector<operandT> x(40 * 32 + 13);
+    std::vector<operandT> y(x.size());
+    check(std::span(x), std::span(y), ones);
+  }
+}
+
+// Test functional correctness of ct_bit_length, ct_clz and ct_ctz against std::bit_width,
+// std::countl_zero and std::countr_zero, on zero, on every power of two and on random
+// values of random bit length.
+template<typename operandT>
+void
+test_ct_bit_scan()
+  requires(subtle::ct_operand<operandT>)
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr size_t digits = std::numeric_limits<Uop>::digits;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  static_assert(subtle::ct_bit_length(static_cast<operandT>(0)) == 0);
+  static_assert(subtle::ct_clz(static_cast<operandT>(0)) == digits);
+  static_assert(subtle::ct_ctz(static_cast<operandT>(0)) == digits);
+  static_assert(subtle::ct_bit_length(static_cast<operandT>(-1)) == digits);
+
+  const auto check = [](const Uop u) {
+    const auto x = static_cast<operandT>(u);
+
+    ASSERT_EQ(subtle::ct_bit_length(x), static_cast<size_t>(std::bit_width(u)));
+    ASSERT_EQ(subtle::ct_clz(x), static_cast<size_t>(std::countl_zero(u)));
+    ASSERT_EQ(subtle::ct_ctz(x), static_cast<size_t>(std::countr_zero(u)));
+  };
+
+  check(0);
+  for (size_t bit = 0; bit < digits; bit++) {
+    check(static_cast<Uop>(Uop{ 1 } << bit));
+  }
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const auto u = static_cast<Uop>(dis(gen));
+    check(static_cast<Uop>(u >> (gen() % digits)));
+    check(static_cast<Uop>(u << (gen() % digits)));
+  }
+}
+
+// Test functional correctness of ct_bitvec of BITS bits: XOR, AND, OR and weight against
+// their word-by-word and bit-by-bit definitions, and ct_rotate against moving every bit
+// on its own, for amounts of 0, 1, BITS - 1, BITS, random ones below BITS and random
+// 64-bit ones.
+template<size_t BITS>
+void
+test_ct_bitvec(const size_t iterations)
+{
+  using bitvec = subtle::ct_bitvec<BITS>;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto random_bitvec = [&]() {
+    std::array<uint64_t, bitvec::word_count> words{};
+    std::ranges::generate(words, [&]() { return gen(); });
+    return bitvec(words);
+  };
+
+  for (size_t i = 0; i < iterations; i++) {
+    const bitvec a = random_bitvec();
+    const bitvec b = random_bitvec();
+
+    ASSERT_EQ(a.words().back() & ~bitvec::top_mask, 0U);
+
+    const bitvec x = a ^ b;
+    const bitvec y = a & b;
+    const bitvec z = a | b;
+
+    size_t weight = 0;
+    for (size_t j = 0; j < BITS; j++) {
+      ASSERT_EQ(x.get(j), a.get(j) ^ b.get(j));
+      ASSERT_EQ(y.get(j), a.get(j) & b.get(j));
+      ASSERT_EQ(z.get(j), a.get(j) | b.get(j));
+      weight += a.get(j);
+    }
+    ASSERT_EQ(a.weight(), weight);
+
+    const std::array<uint64_t, 7> amounts{ 0, 1, BITS - 1, BITS, gen() % BITS, gen() % BITS, gen() };
+    for (const uint64_t amount : amounts) {
+      bitvec rotated = a;
+      subtle::ct_rotate(rotated, amount);
+
+      bitvec expected;
+      for (size_t j = 0; j < BITS; j++) {
+        expected.set(static_cast<size_t>((j + amount % BITS) % BITS), a.get(j));
+      }
+
+      ASSERT_EQ(rotated, expected);
+    }
+  }
+}
+
+// Test functional correctness of ct_rotate_bytes against std::ranges::rotate, over spans
+// of fixed extent 256 and of every length up to 70, with shifts below and well above the
+// length, and of ct_extract against copying the window out of src directly, for MAC-sized
+// windows at every offset of records of assorted lengths.
+inline void
+test_ct_rotate_extract()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  static_assert([]() {
+    std::array<uint8_t, 5> buf{ 0, 1, 2, 3, 4 };
+    std::array<uint8_t, 5> scratch{};
+    subtle::ct_rotate_bytes(std::span(buf), 7U, std::span(scratch));
+    return buf == std::array<uint8_t, 5>{ 2, 3, 4, 0, 1 };
+  }());
+
+  const auto check_rotate = [&]<size_t N>(std::span<uint8_t, N> buf, std::span<uint8_t, N> scratch) {
+    std::ranges::generate(buf, [&]() { return static_cast<uint8_t>(gen()); });
+
+    const std::array<uint64_t, 4> shifts{ 0, gen() % (buf.size() + 1), gen() % (4 * buf.size() + 1), gen() };
+    for (const uint64_t shift : shifts) {
+      std::vector<uint8_t> expected(buf.begin(), buf.end());
+      if (!expected.empty()) {
+        std::ranges::rotate(expected, expected.begin() + static_cast<std::ptrdiff_t>(shift % expected.size()));
+      }
+
+      std::vector<uint8_t> orig(buf.begin(), buf.end());
+      subtle::ct_rotate_bytes(buf, shift, scratch);
+      ASSERT_TRUE(std::ranges::equal(buf, expected));
+
+      std::ranges::copy(orig, buf.begin());
+    }
+  };
+
+  for (size_t i = 0; i < 16; i++) {
+    std::array<uint8_t, 256> buf{};
+    std::array<uint8_t, 256> scratch{};
+    check_rotate(std::span(buf), std::span(scratch));
+  }
+
+  for (size_t len = 0; len <= 70; len++) {
+    std::vector<uint8_t> buf(len);
+    std::vector<uint8_t> scratch(len);
+    check_rotate(std::span(buf), std::span(scratch));
+  }
+
+  for (const size_t m : { 1, 20, 32, 48 }) {
+    for (const size_t n : { m, m + 1, 2 * m + 7, size_t{ 300 } }) {
+      std::vector<uint8_t> src(n);
+      std::ranges::generate(src, [&]() { return static_cast<uint8_t>(gen()); });
+
+      for (size_t offset = 0; offset + m <= n; offset++) {
+        std::vector<uint8_t> dst(m);
+        std::vector<uint8_t> scratch(m);
+        subtle::ct_extract(std::span(dst), std::span<const uint8_t>(src), offset, std::span(scratch));
+
+        ASSERT_TRUE(std::ranges::equal(dst, std::span(src).subspan(offset, m)));
+      }
+    }
+  }
+
+  std::array<uint8_t, 256> record{};
+  std::ranges::generate(record, [&]() { return static_cast<uint8_t>(gen()); });
+
+  for (size_t i = 0; i < 64; i++) {
+    const auto offset = static_cast<uint16_t>(gen() % (record.size() - 32 + 1));
+
+    std::array<uint8_t, 32> mac{};
+    std::array<uint8_t, 32> scratch{};
+    subtle::ct_extract(std::span(mac), std::span<const uint8_t, 256>(record), offset, std::span(scratch));
+
+    ASSERT_TRUE(std::ranges::equal(mac, std::span(record).subspan(offset, 32)));
+  }
+}
+
+// Test functional correctness of constant-time prefix copy and comparison under a secret
+// length, against std::ranges::copy_n / std::ranges::equal over the first min( len, size )
+// elements, for lengths below, at and past the capacity.
+template<typename operandT>
+void
+test_ct_prefix()
+{
+  using Uop = std::make_unsigned_t<operandT>;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  static_assert([]() {
+    std::array<operandT, 4> dst{};
+    constexpr std::array<operandT, 4> src{ 1, 2, 3, 4 };
+    subtle::ct_memcpy_prefix(std::span(dst), std::span(src), 2U);
+
+    const auto eq = subtle::ct_memcmp_prefix<operandT, uint32_t>(std::span<const operandT, 4>(dst), std::span(src), 2U);
+    const auto ne = subtle::ct_memcmp_prefix<operandT, uint32_t>(std::span<const operandT, 4>(dst), std::span(src), 3U);
+    return dst == std::array<operandT, 4>{ 1, 2, 0, 0 } && eq == ~0U && ne == 0U;
+  }());
+
+  const auto random_vals = [&](const size_t n) {
+    std::vector<operandT> vals(n);
+    std::ranges::generate(vals, [&]() { return static_cast<operandT>(gen()); });
+    return vals;
+  };
+
+  for (const size_t n : { 0, 1, 7, 31, 32, 33, 100, 257 }) {
+    const auto src = random_vals(n);
+    const auto orig = random_vals(n);
+
+    std::vector<size_t> lens{ n + 1, n + 64, std::numeric_limits<size_t>::max() };
+    for (size_t len = 0; len <= n; len++) {
+      lens.push_back(len);
+    }
+
+    for (const size_t len : lens) {
+      auto dst = orig;
+      subtle::ct_memcpy_prefix(std::span(dst), std::span(src), len);
+
+      const size_t k = std::min(len, n);
+      ASSERT_TRUE(std::ranges::equal(std::span(dst).first(k), std::span(src).first(k)));
+      ASSERT_TRUE(std::ranges::equal(std::span(dst).subspan(k), std::span(orig).subspan(k)));
+
+      const auto eq = subtle::ct_memcmp_prefix<operandT, uint32_t>(std::span<const operandT>(dst), std::span(src), len);
+      EXPECT_EQ(eq, std::numeric_limits<uint32_t>::max());
+
+      // Flip one bit of a random element: the prefixes differ exactly when it lies below len
+      if (n > 0) {
+        const size_t pos = gen() % n;
+        auto other = src;
+        other[pos] = static_cast<operandT>(static_cast<Uop>(other[pos]) ^ static_cast<Uop>(Uop{ 1 } << (gen() % std::numeric_limits<Uop>::digits)));
+
+        const auto cmp = subtle::ct_memcmp_prefix<operandT, uint8_t>(std::span<const operandT>(other), std::span(src), len);
+        EXPECT_EQ(cmp, pos < len ? uint8_t{ 0 } : std::numeric_limits<uint8_t>::max());
+      }
+    }
+  }
+
+  std::array<operandT, 64> buf{};
+  const auto src = random_vals(buf.size());
+  const auto len = static_cast<uint8_t>(gen() % (buf.size() + 1));
+  subtle::ct_memcpy_prefix(std::span(buf), std::span<const operandT, 64>(src.data(), 64), len);
+  ASSERT_TRUE(std::ranges::equal(std::span(buf).first(len), std::span(src).first(len)));
+  ASSERT_TRUE(std::ranges::all_of(std::span(buf).subspan(len), [](const operandT v) { return v == operandT{}; }));
+}
+
+// Test functional correctness of constant-time PKCS#7, ISO/IEC 7816-4 and PKCS#1 v1.5
+// unpadding, on well-formed padding of every length and on random corruptions of it,
+// against straightforward branching reference implementations.
+inline void
+test_ct_padding()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto ref_pkcs7 = [](std::span<const uint8_t> block) -> std::pair<bool, size_t> {
+    const size_t p = block.back();
+    if (p == 0 || p > block.size()) {
+      return { false, 0 };
+    }
+    const bool ok = std::ranges::all_of(block.last(p), [&](const uint8_t b) { return b == p; });
+    return { ok, ok ? block.size() - p : 0 };
+  };
+
+  const auto ref_iso7816 = [](std::span<const uint8_t> block) -> std::pair<bool, size_t> {
+    size_t i = block.size();
+    while (i > 0 && block[i - 1] == 0) {
+      i--;
+    }
+    const bool ok = i > 0 && block[i - 1] == 0x80;
+    return { ok, ok ? i - 1 : 0 };
+  };
+
+  const auto ref_pkcs1 = [](std::span<const uint8_t> em) -> std::pair<bool, size_t> {
+    if (em.size() < 11 || em[0] != 0x00 || em[1] != 0x02) {
+      return { false, 0 };
+    }
+    const auto sep = std::ranges::find(em.subspan(2), uint8_t{ 0 });
+    const auto pos = static_cast<size_t>(sep - em.begin());
+    const bool ok = sep != em.end() && pos >= 10;
+    return { ok, ok ? em.size() - pos - 1 : 0 };
+  };
+
+  const auto random_bytes = [&](std::span<uint8_t> buf, const uint8_t lo) {
+    std::ranges::generate(buf, [&]() { return static_cast<uint8_t>(lo + gen() % (256U - lo)); });
+  };
+
+  // Flips zero or more random bytes to 0x00, 0x80, 0x02 or a random value
+  const auto corrupt = [&](std::span<uint8_t> buf) {
+    const size_t flips = gen() % 3;
+    for (size_t f = 0; f < flips; f++) {
+      const std::array<uint8_t, 4> vals{ 0x00, 0x80, 0x02, static_cast<uint8_t>(gen()) };
+      buf[gen() % buf.size()] = vals[gen() % vals.size()];
+    }
+  };
+
+  const auto check = [](const auto unpad, std::span<const uint8_t> block, const std::pair<bool, size_t>& expected) {
+    size_t len = 0;
+    const uint32_t valid = unpad(block, len);
+
+    EXPECT_EQ(valid, expected.first ? std::numeric_limits<uint32_t>::max() : 0U);
+    EXPECT_EQ(len, expected.second);
+  };
+
+  const auto pkcs7 = [](std::span<const uint8_t> block, size_t& len) { return subtle::ct_pkcs7_unpad<uint32_t>(block, len); };
+  const auto iso7816 = [](std::span<const uint8_t> block, size_t& len) { return subtle::ct_iso7816_unpad<uint32_t>(block, len); };
+  const auto pkcs1 = [](std::span<const uint8_t> em, size_t& len) { return subtle::ct_pkcs1_v15_unpad<uint32_t>(em, len); };
+
+  for (const size_t n : { 1, 8, 16, 31, 32, 33, 64, 100, 255, 256 }) {
+    std::vector<uint8_t> block(n);
+
+    for (size_t p = 0; p <= n + 1; p++) {
+      for (size_t trial = 0; trial < 4; trial++) {
+        // PKCS#7, with a pad byte p that may be 0 or larger than the block
+        random_bytes(block, 0);
+        std::ranges::fill(block.end() - static_cast<std::ptrdiff_t>(std::min(std::max<size_t>(p, 1), n)), block.end(), static_cast<uint8_t>(p));
+        if (trial > 0) {
+          corrupt(block);
+        }
+        check(pkcs7, block, ref_pkcs7(block));
+
+        // ISO/IEC 7816-4, with the marker p bytes from the end
+        if (p >= 1 && p <= n) {
+          random_bytes(block, 0);
+          block[n - p] = 0x80;
+          std::ranges::fill(block.end() - static_cast<std::ptrdiff_t>(p - 1), block.end(), uint8_t{ 0 });
+          if (trial > 0) {
+            corrupt(block);
+          }
+          check(iso7816, block, ref_iso7816(block));
+        }
+
+        // PKCS#1 v1.5, with a message of p bytes
+        if (n >= 2 && p + 3 <= n) {
+          random_bytes(block, 1);
+          block[0] = 0x00;
+          block[1] = 0x02;
+          block[n - p - 1] = 0x00;
+          random_bytes(std::span(block).last(p), 0);
+          if (trial > 0) {
+            corrupt(block);
+          }
+          check(pkcs1, block, ref_pkcs1(block));
+        }
+      }
+    }
+  }
+
+  // Blocks of all zeros, and fixed-extent spans
+  std::array<uint8_t, 16> zeros{};
+  size_t len = 1;
+  EXPECT_EQ((subtle::ct_pkcs7_unpad<uint8_t>(std::span<const uint8_t, 16>(zeros), len)), 0U);
+  EXPECT_EQ((subtle::ct_iso7816_unpad<uint8_t>(std::span<const uint8_t, 16>(zeros), len)), 0U);
+  EXPECT_EQ((subtle::ct_pkcs1_v15_unpad<uint8_t>(std::span<const uint8_t, 16>(zeros), len)), 0U);
+  EXPECT_EQ(len, 0U);
+
+  std::array<uint8_t, 16> aes_block{ 'Y', 'E', 'L', 'L', 'O', 'W', ' ', 'S', 'U', 'B', 'M', 'A', 'R', 'I', 0x02, 0x02 };
+  EXPECT_EQ((subtle::ct_pkcs7_unpad<uint64_t>(std::span<const uint8_t, 16>(aes_block), len)), std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(len, 14U);
+
+  static_assert([]() {
+    constexpr std::array<uint8_t, 8> block{ 'a', 'b', 'c', 0x80, 0, 0, 0, 0 };
+    size_t n = 0;
+    const auto ok = subtle::ct_iso7816_unpad<uint32_t>(std::span(block), n);
+    return ok == ~0U && n == 3;
+  }());
+}
+
+// Test functional correctness of constant-time first / last occurrence search, against
+// std::ranges::find and a reverse std::ranges::find, over values drawn from a small range
+// so that spans hold several matches, one or none.
+template<typename operandT>
+void
+test_ct_find()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  static_assert([]() {
+    constexpr std::array<operandT, 6> vals{ 3, 1, 4, 1, 5, 9 };
+    size_t first = 0;
+    size_t last = 0;
+    size_t none = 0;
+    const auto f = subtle::ct_find_first<operandT, uint32_t>(std::span(vals), operandT{ 1 }, first);
+    const auto l = subtle::ct_find_last<operandT, uint32_t>(std::span(vals), operandT{ 1 }, last);
+    const auto n = subtle::ct_find_first<operandT, uint32_t>(std::span(vals), operandT{ 2 }, none);
+    return f == ~0U && first == 1 && l == ~0U && last == 3 && n == 0U && none == vals.size();
+  }());
+
+  for (const size_t n : { 0, 1, 5, 15, 16, 17, 31, 32, 33, 64, 100, 257 }) {
+    for (size_t trial = 0; trial < 16; trial++) {
+      // A range of n / 2 + 2 values makes a given one absent from about a third of the spans
+      const auto range = static_cast<uint64_t>(n / 2 + 2);
+
+      std::vector<operandT> vals(n);
+      std::ranges::generate(vals, [&]() { return static_cast<operandT>(gen() % range); });
+      const auto value = static_cast<operandT>(gen() % range);
+
+      const auto first_it = std::ranges::find(vals, value);
+      const auto last_it = std::ranges::find(vals.rbegin(), vals.rend(), value);
+      const bool present = first_it != vals.end();
+
+      const auto expected_first = static_cast<size_t>(first_it - vals.begin());
+      const size_t expected_last = present ? static_cast<size_t>(vals.rend() - last_it) - 1 : n;
+
+      size_t first = 0;
+      size_t last = 0;
+      const auto f = subtle::ct_find_first<operandT, uint8_t>(std::span<const operandT>(vals), value, first);
+      const auto l = subtle::ct_find_last<operandT, uint64_t>(std::span<const operandT>(vals), value, last);
+
+      EXPECT_EQ(f, present ? std::numeric_limits<uint8_t>::max() : uint8_t{ 0 });
+      EXPECT_EQ(l, present ? std::numeric_limits<uint64_t>::max() : uint64_t{ 0 });
+      EXPECT_EQ(first, expected_first);
+      EXPECT_EQ(last, expected_last);
+    }
+  }
+
+  // Every position in turn, as the only match of a fixed-extent span
+  std::array<operandT, 70> vals{};
+  for (size_t pos = 0; pos < vals.size(); pos++) {
+    std::ranges::fill(vals, operandT{ 7 });
+    vals[pos] = operandT{ 1 };
+
+    size_t first = 0;
+    size_t last = 0;
+    subtle::ct_find_first<operandT, uint32_t>(std::span<const operandT, 70>(vals), operandT{ 1 }, first);
+    subtle::ct_find_last<operandT, uint32_t>(std::span<const operandT, 70>(vals), operandT{ 1 }, last);
+
+    EXPECT_EQ(first, pos);
+    EXPECT_EQ(last, pos);
+  }
+}
+
+// Test functional correctness of constant-time hex and Base64 encoding and decoding,
+// against straightforward table-driven reference encoders, over every input length up to
+// a few AVX2 blocks, and of the rejection of invalid characters, padding and trailing
+// bits by the decoders.
+inline void
+test_ct_codec()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  const auto ref_hex = [](std::span<const uint8_t> in) {
+    constexpr std::string_view digits = "0123456789abcdef";
+    std::string out;
+    for (const uint8_t b : in) {
+      out += digits[b >> 4];
+      out += digits[b & 0x0fU];
+    }
+    return out;
+  };
+
+  const auto ref_base64 = [](std::span<const uint8_t> in, const bool url_safe) {
+    const std::string_view alphabet = url_safe ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                                               : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < in.size(); i += 3) {
+      const size_t m = std::min<size_t>(3, in.size() - i);
+      uint32_t w = 0;
+      for (size_t j = 0; j < 3; j++) {
+        w = (w << 8) | (j < m ? in[i + j] : 0U);
+      }
+      for (size_t j = 0; j <= m; j++) {
+        out += alphabet[(w >> (18 - 6 * j)) & 63U];
+      }
+      if (!url_safe) {
+        out.append(3 - m, '=');
+      }
+    }
+    return out;
+  };
+
+  constexpr auto valid = std::numeric_limits<uint32_t>::max();
+
+  for (size_t n = 0; n <= 130; n++) {
+    std::vector<uint8_t> in(n);
+    std::ranges::generate(in, [&]() { return static_cast<uint8_t>(gen()); });
+
+    // Hex, encoded lowercase and decoded from either case
+    std::string hex(2 * n, '\0');
+    subtle::ct_hex_encode(std::span(hex), std::span<const uint8_t>(in));
+    EXPECT_EQ(hex, ref_hex(in));
+
+    std::string upper = hex;
+    std::ranges::transform(upper, upper.begin(), [](const char c) { return static_cast<char>(std::toupper(c)); });
+
+    for (const auto& text : { hex, upper }) {
+      std::vector<uint8_t> out(n);
+      EXPECT_EQ((subtle::ct_hex_decode<uint32_t>(std::span(out), std::span<const char>(text))), valid);
+      EXPECT_EQ(out, in);
+    }
+
+    // Base64, in both alphabets
+    std::string b64(subtle::ct_base64_encoded_size(n), '\0');
+    std::string url(subtle::ct_base64_encoded_size<true>(n), '\0');
+    subtle::ct_base64_encode(std::span(b64), std::span<const uint8_t>(in));
+    subtle::ct_base64_encode<true>(std::span(url), std::span<const uint8_t>(in));
+    EXPECT_EQ(b64, ref_base64(in, false));
+    EXPECT_EQ(url, ref_base64(in, true));
+
+    EXPECT_EQ(subtle::ct_base64_decoded_size(std::span<const char>(b64)), n);
+    EXPECT_EQ(subtle::ct_base64_decoded_size<true>(std::span<const char>(url)), n);
+
+    std::vector<uint8_t> out(n);
+    EXPECT_EQ((subtle::ct_base64_decode<uint32_t>(std::span(out), std::span<const char>(b64))), valid);
+    EXPECT_EQ(out, in);
+    std::ranges::fill(out, uint8_t{ 0 });
+    EXPECT_EQ((subtle::ct_base64_decode<uint32_t, true>(std::span(out), std::span<const char>(url))), valid);
+    EXPECT_EQ(out, in);
+
+    if (n == 0) {
+      continue;
+    }
+
+    // A character out of the alphabet, anywhere, is rejected
+    const auto reject = [&](std::string text, const size_t pos, const char c, const auto decode) {
+      text[pos] = c;
+      EXPECT_EQ(decode(text), 0U) << "n = " << n << ", pos = " << pos << ", c = " << static_cast<int>(c);
+    };
+
+    const auto hex_decode = [&](const std::string& text) { return subtle::ct_hex_decode<uint32_t>(std::span(out), std::span<const char>(text)); };
+    const auto b64_decode = [&](const std::string& text) { return subtle::ct_base64_decode<uint32_t>(std::span(out), std::span<const char>(text)); };
+    const auto url_decode = [&](const std::string& text) { return subtle::ct_base64_decode<uint32_t, true>(std::span(out), std::span<const char>(text)); };
+
+    for (const char c : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', static_cast<char>(0xb0), static_cast<char>(0xe1) }) {
+      reject(hex, gen() % hex.size(), c, hex_decode);
+    }
+
+    const size_t chars = subtle::ct_base64_encoded_size<true>(n);
+    for (const char c : { '=', '-', '_', '.', '@', '[', '`', '{', '\0', static_cast<char>(0xc1) }) {
+      reject(b64, gen() % chars, c, b64_decode);
+    }
+    for (const char c : { '=', '+', '/', '.', '@', '[', '`', '{', '\0', static_cast<char>(0xe1) }) {
+      reject(url, gen() % chars, c, url_decode);
+    }
+
+    // Nonzero unused bits in the last character, or the padding altered or missing
+    if (n % 3 != 0) {
+      constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+      std::string text = url;
+      text.back() = alphabet[alphabet.find(text.back()) | 1U];
+      EXPECT_EQ(url_decode(text), 0U);
+
+      reject(b64, b64.size() - 1, 'A', b64_decode);
+      EXPECT_EQ(b64_decode(b64.substr(0, chars)), 0U);
+      EXPECT_EQ(url_decode(url + "="), 0U);
+    }
+
+    EXPECT_EQ(hex_decode(hex.substr(1)), 0U);
+  }
+
+  // Characters with nonzero unused bits, in both positions of a last group
+  std::array<uint8_t, 1> one{};
+  std::array<uint8_t, 2> two{};
+  EXPECT_EQ((subtle::ct_base64_decode<uint32_t>(std::span(one), std::span<const char>(std::string_view("QQ==")))), valid);
+  EXPECT_EQ(one[0], 'A');
+  EXPECT_EQ((subtle::ct_base64_decode<uint32_t>(std::span(one), std::span<const char>(std::string_view("QR==")))), 0U);
+  EXPECT_EQ((subtle::ct_base64_decode<uint32_t>(std::span(two), std::span<const char>(std::string_view("QUI=")))), valid);
+  EXPECT_EQ((subtle::ct_base64_decode<uint32_t>(std::span(two), std::span<const char>(std::string_view("QUJ=")))), 0U);
+  EXPECT_EQ((subtle::ct_base64_decode<uint32_t>(std::span(two), std::span<const char>(std::string_view("QUI")))), 0U);
+  EXPECT_EQ((subtle::ct_base64_decode<uint32_t, true>(std::span(two), std::span<const char>(std::string_view("QUI")))), valid);
+
+  static_assert([]() {
+    constexpr std::array<uint8_t, 4> key{ 0xde, 0xad, 0xbe, 0xef };
+    std::array<char, 8> hex{};
+    std::array<char, 8> b64{};
+    subtle::ct_hex_encode(std::span(hex), std::span(key));
+    subtle::ct_base64_encode(std::span(b64), std::span(key));
+
+    std::array<uint8_t, 4> a{};
+    std::array<uint8_t, 4> b{};
+    const auto ok_hex = subtle::ct_hex_decode<uint32_t>(std::span(a), std::span<const char, 8>(hex));
+    const auto ok_b64 = subtle::ct_base64_decode<uint32_t>(std::span(b), std::span<const char, 8>(b64));
+    return hex == std::array{ 'd', 'e', 'a', 'd', 'b', 'e', 'e', 'f' } && b64 == std::array{ '3', 'q', '2', '+', '7', 'w', '=', '=' } && ok_hex == ~0U &&
+           ok_b64 == ~0U && a == key && b == key;
+  }());
+}
+
+// Test functional correctness of constant-time GF(2^m) arithmetic, for one irreducible
+// polynomial of each degree 2 to 13 ( two of degree 8 ): products against a branching
+// shift-and-add reference, inverses of every element, and the span kernels against the
+// scalar routines, over sizes around the AVX2 block.
+template<size_t m, uint32_t poly, typename operandT>
+void
+test_ct_gf()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  constexpr uint32_t order = uint32_t{ 1 } << m;
+
+  const auto ref_mul = [](uint32_t a, const uint32_t b) {
+    uint32_t r = 0;
+    for (size_t i = 0; i < m; i++) {
+      if ((b >> i) & 1U) {
+        r ^= a;
+      }
+      a <<= 1;
+      if ((a >> m) & 1U) {
+        a ^= poly;
+      }
+    }
+    return static_cast<operandT>(r);
+  };
+
+  const auto random_elem = [&]() { return static_cast<operandT>(gen() % order); };
+
+  // Every product in the small fields, random ones in the larger
+  if constexpr (m <= 8) {
+    for (uint32_t a = 0; a < order; a++) {
+      for (uint32_t b = 0; b < order; b++) {
+        ASSERT_EQ((subtle::ct_gf_mul<m, poly>(static_cast<operandT>(a), static_cast<operandT>(b))), ref_mul(a, b));
+      }
+    }
+  } else {
+    for (size_t trial = 0; trial < 1U << 16; trial++) {
+      const operandT a = random_elem();
+      const operandT b = random_elem();
+      ASSERT_EQ((subtle::ct_gf_mul<m, poly>(a, b)), ref_mul(a, b));
+    }
+  }
+
+  EXPECT_EQ((subtle::ct_gf_inv<m, poly>(operandT{ 0 })), operandT{ 0 });
+  for (uint32_t a = 1; a < order; a++) {
+    const auto inv = subtle::ct_gf_inv<m, poly>(static_cast<operandT>(a));
+    ASSERT_EQ(ref_mul(a, inv), operandT{ 1 }) << "a = " << a;
+  }
+
+  for (const size_t n : { 0, 1, 15, 16, 17, 31, 32, 33, 64, 100 }) {
+    std::vector<operandT> a(n);
+    std::vector<operandT> b(n);
+    std::ranges::generate(a, random_elem);
+    std::ranges::generate(b, random_elem);
+
+    std::vector<operandT> prod(n);
+    subtle::ct_gf_mul_span<m, poly>(std::span(prod), std::span<const operandT>(a), std::span<const operandT>(b));
+    for (size_t i = 0; i < n; i++) {
+      EXPECT_EQ(prod[i], ref_mul(a[i], b[i]));
+    }
+
+    const operandT c = random_elem();
+    std::vector<operandT> acc = b;
+    subtle::ct_gf_muladd_span<m, poly>(std::span(acc), std::span<const operandT>(a), c);
+    for (size_t i = 0; i < n; i++) {
+      EXPECT_EQ(acc[i], static_cast<operandT>(b[i] ^ ref_mul(c, a[i])));
+    }
+
+    for (const size_t k : { 0, 1, 3, 8 }) {
+      std::vector<operandT> coeffs(k);
+      std::ranges::generate(coeffs, random_elem);
+
+      std::vector<operandT> ys(n);
+      subtle::ct_gf_poly_eval<m, poly>(std::span(ys), std::span<const operandT>(a), std::span<const operandT>(coeffs));
+      for (size_t j = 0; j < n; j++) {
+        operandT y = 0;
+        operandT power = 1;
+        for (const operandT coeff : coeffs) {
+          y ^= ref_mul(coeff, power);
+          power = ref_mul(power, a[j]);
+        }
+        EXPECT_EQ(ys[j], y);
+      }
+    }
+  }
+}
+
+// Test constant-time GF(2^8) arithmetic against known values -- the AES S-box inverses and
+// FIPS 197 products -- and a Shamir ( 3, 5 ) sharing round trip, reconstructing the secret
+// bytes by Lagrange interpolation at 0 from any three shares.
+inline void
+test_ct_gf256()
+{
+  EXPECT_EQ(subtle::ct_gf256_mul(0x57, 0x83), 0xc1);
+  EXPECT_EQ(subtle::ct_gf256_mul(0x57, 0x13), 0xfe);
+  EXPECT_EQ(subtle::ct_gf256_inv(0x53), 0xca);
+  EXPECT_EQ(subtle::ct_gf256_inv(0x01), 0x01);
+  EXPECT_EQ(subtle::ct_gf256_mul<0x11d>(0x02, 0x80), 0x1d);
+
+  static_assert(subtle::ct_gf256_mul(0x57, 0x83) == 0xc1 && subtle::ct_gf256_inv(0xca) == 0x53);
+  static_assert(subtle::ct_gf_irreducible(8, 0x11b) && !subtle::ct_gf_irreducible(8, 0x101) && !subtle::ct_gf_irreducible(8, 0x1b));
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  // Secret bytes, each the constant term of a random polynomial of degree 2, evaluated at
+  // x = 1 .. 5 by a multiply-accumulate per coefficient
+  constexpr size_t len = 40;
+  constexpr std::array<uint8_t, 5> xs{ 1, 2, 3, 4, 5 };
+
+  std::array<std::array<uint8_t, len>, 3> coeffs{};
+  for (auto& row : coeffs) {
+    std::ranges::generate(row, [&]() { return static_cast<uint8_t>(gen()); });
+  }
+
+  std::array<std::array<uint8_t, len>, xs.size()> shares{};
+  for (size_t s = 0; s < xs.size(); s++) {
+    uint8_t power = 1;
+    for (const auto& row : coeffs) {
+      subtle::ct_gf_muladd_span<8, 0x11b>(std::span(shares[s]), std::span<const uint8_t, len>(row), power);
+      power = subtle::ct_gf256_mul(power, xs[s]);
+    }
+  }
+
+  for (size_t i = 0; i < xs.size(); i++) {
+    for (size_t j = i + 1; j < xs.size(); j++) {
+      for (size_t k = j + 1; k < xs.size(); k++) {
+        const std::array<size_t, 3> pick{ i, j, k };
+
+        std::array<uint8_t, len> secret{};
+        for (const size_t a : pick) {
+          // Lagrange basis polynomial of share a, at 0: prod x_b / ( x_a + x_b ) over b != a
+          uint8_t basis = 1;
+          for (const size_t b : pick) {
+            if (b != a) {
+              basis = subtle::ct_gf256_mul(basis, subtle::ct_gf256_mul(xs[b], subtle::ct_gf256_inv(static_cast<uint8_t>(xs[a] ^ xs[b]))));
+            }
+          }
+          subtle::ct_gf_muladd_span<8, 0x11b>(std::span(secret), std::span<const uint8_t, len>(shares[a]), basis);
+        }
+
+        EXPECT_EQ(secret, coeffs[0]);
+      }
+    }
+  }
+}
+
 // Test functional correctness of constant-time zeroize operation,
 // verifying all elements of a span are zeroed after the operation.
 template<typename T>
 void
-test_ct_zeroize()
+test_ct_zeroize()
+{
+  constexpr size_t MIN_SIZE = 0;
+  constexpr size_t MAX_SIZE = 1024;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const size_t len = size_dis(gen);
+    std::vector<T> buf(len);
+
+    std::ranges::generate(buf, [&]() -> T { return static_cast<T>(gen()); });
+    subtle::ct_zeroize(std::span<T>(buf));
+
+    for (const auto& elem : buf) {
+      ASSERT_EQ(elem, T{ 0 });
+    }
+  }
+}
+
+// Test functional correctness of constant-time memory comparison operation,
+// checking result against element-wise equality via std::equal.
+template<typename operandT, typename returnT>
+void
+test_ct_memcmp()
+  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<returnT>)
+{
+  constexpr returnT truthv = static_cast<returnT>(~returnT{ 0 });
+  constexpr returnT falsev = 0;
+
+  constexpr size_t MIN_SIZE = 0;
+  constexpr size_t MAX_SIZE = 1024;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const size_t len = size_dis(gen);
+
+    std::vector<operandT> lhs(len);
+    std::vector<operandT> rhs(len);
+
+    std::ranges::generate(lhs, [&]() { return dis(gen); });
+    std::ranges::generate(rhs, [&]() { return dis(gen); });
+
+    const returnT z = subtle::ct_memcmp<operandT, returnT>(std::span<const operandT>(lhs), std::span<const operandT>(rhs));
+    const bool expected = std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    ASSERT_EQ(z, (expected ? truthv : falsev));
+
+    // Identical spans must return truth value
+    const returnT self = subtle::ct_memcmp<operandT, returnT>(std::span<const operandT>(lhs), std::span<const operandT>(lhs));
+    ASSERT_EQ(self, truthv);
+  }
+}
+
+// Test functional correctness of constant-time conditional memcpy operation,
+// verifying that dst is overwritten with src on truth value and left unchanged
+// on false value.
+template<typename operandT, typename branchT>
+void
+test_ct_conditional_memcpy()
+  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<branchT>)
+{
+  constexpr branchT truthv = static_cast<branchT>(~branchT{ 0 });
+  constexpr branchT falsev = 0;
+
+  constexpr size_t MIN_SIZE = 0;
+  constexpr size_t MAX_SIZE = 1024;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const size_t len = size_dis(gen);
+
+    std::vector<operandT> src(len);
+    std::vector<operandT> dst(len);
+
+    std::ranges::generate(src, [&]() { return dis(gen); });
+    std::ranges::generate(dst, [&]() { return dis(gen); });
+
+    // Truth value: dst must become an exact copy of src.
+    std::vector<operandT> dst_truth = dst;
+    subtle::ct_conditional_memcpy<branchT, operandT>(truthv, std::span<operandT>(dst_truth), std::span<const operandT>(src));
+    ASSERT_EQ(dst_truth, src);
+
+    // False value: dst must retain its original contents.
+    std::vector<operandT> dst_false = dst;
+    subtle::ct_conditional_memcpy<branchT, operandT>(falsev, std::span<operandT>(dst_false), std::span<const operandT>(src));
+    ASSERT_EQ(dst_false, dst);
+  }
+}
+
+// Test functional correctness of constant-time conditional memset operation,
+// verifying that dst is filled with the given value on truth value and left
+// unchanged on false value.
+template<typename operandT, typename branchT>
+void
+test_ct_conditional_memset()
+  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<branchT>)
+{
+  constexpr branchT truthv = static_cast<branchT>(~branchT{ 0 });
+  constexpr branchT falsev = 0;
+
+  constexpr size_t MIN_SIZE = 0;
+  constexpr size_t MAX_SIZE = 1024;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const size_t len = size_dis(gen);
+
+    std::vector<operandT> dst(len);
+    std::ranges::generate(dst, [&]() { return dis(gen); });
+
+    const operandT val = dis(gen);
+
+    // Truth value: every element of dst must become val.
+    std::vector<operandT> dst_truth = dst;
+    subtle::ct_conditional_memset<branchT, operandT>(truthv, std::span<operandT>(dst_truth), val);
+    std::vector<operandT> expected(len, val);
+    ASSERT_EQ(dst_truth, expected);
+
+    // False value: dst must retain its original contents.
+    std::vector<operandT> dst_false = dst;
+    subtle::ct_conditional_memset<branchT, operandT>(falsev, std::span<operandT>(dst_false), val);
+    ASSERT_EQ(dst_false, dst);
+  }
+}
+
+// Test functional correctness of constant-time table lookup operation, checking
+// the scanned result against a plain table[idx] access.
+template<typename operandT, typename indexT>
+void
+test_ct_lookup()
+  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<indexT>)
+{
+  constexpr size_t MIN_SIZE = 1;
+  constexpr size_t MAX_SIZE = 256; // fits the narrowest ( uint8_t ) index range
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    const size_t len = size_dis(gen);
+
+    std::vector<operandT> table(len);
+    std::ranges::generate(table, [&]() { return dis(gen); });
+
+    std::uniform_int_distribution<size_t> idx_dis(0, len - 1);
+    const size_t idx = idx_dis(gen);
+
+    const operandT z = subtle::ct_lookup<indexT, operandT>(static_cast<indexT>(idx), std::span<const operandT>(table));
+    ASSERT_EQ(z, table[idx]);
+  }
+}
+
+// Test functional correctness of the cache-line-blocked table, checking every
+// lookup, every row lookup and a sequence of stores against a plain array.
+template<typename operandT, size_t N>
+void
+test_ct_table()
+  requires(subtle::ct_operand<operandT>)
+{
+  using table_t = subtle::ct_table<operandT, N>;
+  constexpr size_t per_line = table_t::entries_per_line;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  std::vector<operandT> entries(N);
+  std::ranges::generate(entries, [&]() { return dis(gen); });
+
+  table_t table(std::span<const operandT, N>(entries.data(), N));
+
+  for (size_t idx = 0; idx < N; idx++) {
+    ASSERT_EQ(table.template lookup<uint32_t>(static_cast<uint32_t>(idx)), entries[idx]);
+  }
+
+  for (size_t row = 0; row < table_t::line_count; row++) {
+    std::array<operandT, per_line> line{};
+    table.template lookup_row<uint32_t>(static_cast<uint32_t>(row), line);
+
+    for (size_t k = 0; k < per_line; k++) {
+      const size_t idx = row * per_line + k;
+      ASSERT_EQ(line[k], (idx < N ? entries[idx] : operandT{ 0 }));
+    }
+  }
+
+  std::uniform_int_distribution<size_t> idx_dis(0, N - 1);
+  for (size_t i = 0; i < N; i++) {
+    const size_t idx = idx_dis(gen);
+    const operandT val = dis(gen);
+
+    table.template store<uint32_t>(static_cast<uint32_t>(idx), val);
+    entries[idx] = val;
+  }
+
+  for (size_t idx = 0; idx < N; idx++) {
+    ASSERT_EQ(table.template lookup<uint32_t>(static_cast<uint32_t>(idx)), entries[idx]);
+  }
+}
+
+// Test that byte batches survive the round trip through bit-planes, and that the
+// planes hold the expected bits.
+inline void
+test_ct_bitslice_bytes()
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis(0, 255);
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<uint8_t, subtle::CT_BITSLICE_LANES> bytes{};
+    std::ranges::generate(bytes, [&]() { return static_cast<uint8_t>(dis(gen)); });
+
+    std::array<uint64_t, subtle::CT_BITSLICE_PLANES> planes{};
+    subtle::ct_bitslice_bytes(bytes, planes);
+
+    for (size_t b = 0; b < subtle::CT_BITSLICE_PLANES; b++) {
+      for (size_t j = 0; j < subtle::CT_BITSLICE_LANES; j++) {
+        ASSERT_EQ((planes[b] >> j) & 1U, static_cast<uint64_t>((bytes[j] >> b) & 1U));
+      }
+    }
+
+    std::array<uint8_t, subtle::CT_BITSLICE_LANES> back{};
+    subtle::ct_unbitslice_bytes(planes, back);
+    ASSERT_EQ(back, bytes);
+  }
+}
+
+// Test functional correctness of the bitsliced S-box evaluator, on random S-box
+// tables and random-length inputs, against plain table lookups.
+inline void
+test_ct_sbox_bitsliced()
+{
+  constexpr size_t MIN_SIZE = 0;
+  constexpr size_t MAX_SIZE = 1024;
+  constexpr size_t SBOX_COUNT = 64;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<uint32_t> dis(0, 255);
+  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+
+  for (size_t s = 0; s < SBOX_COUNT; s++) {
+    std::array<uint8_t, 256> table{};
+    std::ranges::generate(table, [&]() { return static_cast<uint8_t>(dis(gen)); });
+
+    const subtle::ct_sbox_bitsliced sbox(table);
+
+    for (size_t i = 0; i < ITERATIONS / SBOX_COUNT; i++) {
+      const size_t len = size_dis(gen);
+
+      std::vector<uint8_t> src(len);
+      std::ranges::generate(src, [&]() { return static_cast<uint8_t>(dis(gen)); });
+
+      std::vector<uint8_t> expected(len);
+      std::ranges::transform(src, expected.begin(), [&](uint8_t x) { return table[x]; });
+
+      std::vector<uint8_t> dst(len);
+      sbox.apply(dst, src);
+      ASSERT_EQ(dst, expected);
+
+      // In place
+      sbox.apply(src, src);
+      ASSERT_EQ(src, expected);
+    }
+  }
+}
+
+// Test that a hand-written bitsliced circuit is applied byte-wise.
+inline void
+test_ct_bitsliced_substitute()
+{
+  constexpr size_t LEN = 1000;
+
+  // y = rotl( x, 1 ) ^ 0x63, as a circuit: a rotation of planes and a complement of
+  // the planes where 0x63 has a set bit.
+  const auto circuit = [](std::span<uint64_t, subtle::CT_BITSLICE_PLANES> planes) {
+    const uint64_t top = planes[7];
+    for (size_t b = 7; b > 0; b--) {
+      planes[b] = planes[b - 1];
+    }
+    planes[0] = top;
+
+    for (size_t b = 0; b < subtle::CT_BITSLICE_PLANES; b++) {
+      planes[b] ^= -static_cast<uint64_t>((0x63U >> b) & 1U);
+    }
+  };
+
+  std::vector<uint8_t> src(LEN);
+  for (size_t i = 0; i < LEN; i++) {
+    src[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  std::vector<uint8_t> dst(LEN);
+  subtle::ct_bitsliced_substitute(circuit, dst, src);
+
+  for (size_t i = 0; i < LEN; i++) {
+    const auto x = static_cast<uint32_t>(src[i]);
+    ASSERT_EQ(dst[i], static_cast<uint8_t>(((x << 1) | (x >> 7)) ^ 0x63U));
+  }
+}
+
+// Test functional correctness of the constant-time square bit-matrix transposes, for
+// rows of 8, 32 and 64 bits, against a naive bit-by-bit transpose.
+template<typename rowT>
+void
+test_ct_transpose()
+  requires(std::is_unsigned_v<rowT>)
+{
+  constexpr size_t N = std::numeric_limits<rowT>::digits;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<rowT> dis;
+
+  for (size_t i = 0; i < ITERATIONS / N; i++) {
+    std::array<rowT, N> rows{};
+    std::ranges::generate(rows, [&]() { return dis(gen); });
+
+    std::array<rowT, N> expected{};
+    for (size_t r = 0; r < N; r++) {
+      for (size_t c = 0; c < N; c++) {
+        const auto bit = static_cast<rowT>((rows[c] >> r) & 1U);
+        expected[r] = static_cast<rowT>(expected[r] | static_cast<rowT>(bit << c));
+      }
+    }
+
+    std::array<rowT, N> transposed = rows;
+    if constexpr (N == 8) {
+      subtle::ct_transpose8x8(std::span<rowT, N>(transposed));
+    } else if constexpr (N == 32) {
+      subtle::ct_transpose32x32(std::span<rowT, N>(transposed));
+    } else {
+      subtle::ct_transpose64x64(std::span<rowT, N>(transposed));
+    }
+    ASSERT_EQ(transposed, expected);
+
+    // Transposing twice is the identity.
+    subtle::ct_transpose_square<rowT, N>(std::span<rowT, N>(transposed));
+    ASSERT_EQ(transposed, rows);
+  }
+}
+
+// Test functional correctness of the constant-time sorting network, checking it
+// against std::sort on every length up to a few hundred as well as on a few larger,
+// non power-of-two lengths, both on full-range values and on values with many ties.
+template<typename operandT>
+void
+test_ct_sort()
+  requires(subtle::ct_operand<operandT>)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+  std::uniform_int_distribution<int> tie_dis(0, 3);
+
+  const auto check = [&](const size_t n, const bool with_ties) {
+    std::vector<operandT> vals(n);
+    std::ranges::generate(vals, [&]() { return with_ties ? static_cast<operandT>(tie_dis(gen)) : dis(gen); });
+
+    std::vector<operandT> expected = vals;
+    std::ranges::sort(expected);
+
+    subtle::ct_sort(std::span(vals));
+    return vals == expected;
+  };
+
+  for (size_t n = 0; n <= 300; n++) {
+    ASSERT_TRUE(check(n, false));
+    ASSERT_TRUE(check(n, true));
+  }
+
+  for (const size_t n : { 1000UL, 1024UL, 4097UL, 1UL << 14 }) {
+    ASSERT_TRUE(check(n, false));
+    ASSERT_TRUE(check(n, true));
+  }
+
+  // Fixed-extent spans go through the same network.
+  std::array<operandT, 64> fixed{};
+  std::ranges::generate(fixed, [&]() { return dis(gen); });
+
+  std::array<operandT, 64> expected = fixed;
+  std::ranges::sort(expected);
+
+  subtle::ct_sort(std::span<operandT, 64>(fixed));
+  ASSERT_EQ(fixed, expected);
+}
+
+// Test functional correctness of the Beneš network: control bits are computed for a
+// random permutation pi and applied to random integers, which must end up in the order
+// vals[pi[0]], vals[pi[1]], ...
+template<typename operandT, size_t N>
+void
+test_ct_permute()
+  requires(subtle::ct_operand<operandT>)
+{
+  constexpr size_t CONTROL_BYTES = subtle::ct_benes_control_bytes(N);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  std::vector<uint16_t> pi(N);
+  std::vector<uint8_t> control(CONTROL_BYTES);
+  std::vector<uint32_t> scratch(2 * N);
+
+  for (size_t i = 0; i < 8; i++) {
+    std::iota(pi.begin(), pi.end(), uint16_t{ 0 });
+    std::ranges::shuffle(pi, gen);
+
+    subtle::ct_benes_control_bits<uint16_t, N>(std::span<const uint16_t, N>(pi.data(), N),
+                                               std::span<uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES),
+                                               std::span<uint32_t, 2 * N>(scratch.data(), 2 * N));
+    ASSERT_TRUE(std::ranges::all_of(scratch, [](const uint32_t word) { return word == 0; }));
+
+    std::vector<operandT> vals(N);
+    std::ranges::generate(vals, [&]() { return dis(gen); });
+
+    std::vector<operandT> expected(N);
+    for (size_t j = 0; j < N; j++) {
+      expected[j] = vals[pi[j]];
+    }
+
+    subtle::ct_permute(std::span<operandT, N>(vals.data(), N), std::span<const uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES));
+    ASSERT_EQ(vals, expected);
+  }
+}
+
+// Test functional correctness of the Beneš network over a packed bit vector of
+// 64 * WORDS bits, against the bit-by-bit permutation.
+template<size_t WORDS>
+void
+test_ct_permute_bits()
 {
-  constexpr size_t MIN_SIZE = 0;
-  constexpr size_t MAX_SIZE = 1024;
+  constexpr size_t N = 64 * WORDS;
+  constexpr size_t CONTROL_BYTES = subtle::ct_benes_control_bytes(N);
 
   std::random_device rd;
   std::mt19937_64 gen(rd());
-  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
 
-  for (size_t i = 0; i < ITERATIONS; i++) {
-    const size_t len = size_dis(gen);
-    std::vector<T> buf(len);
+  std::vector<uint16_t> pi(N);
+  std::vector<uint8_t> control(CONTROL_BYTES);
+  std::vector<uint32_t> scratch(2 * N);
 
-    std::ranges::generate(buf, [&]() -> T { return static_cast<T>(gen()); });
-    subtle::ct_zeroize(std::span<T>(buf));
+  for (size_t i = 0; i < 8; i++) {
+    std::iota(pi.begin(), pi.end(), uint16_t{ 0 });
+    std::ranges::shuffle(pi, gen);
 
-    for (const auto& elem : buf) {
-      ASSERT_EQ(elem, T{ 0 });
+    subtle::ct_benes_control_bits<uint16_t, N>(std::span<const uint16_t, N>(pi.data(), N),
+                                               std::span<uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES),
+                                               std::span<uint32_t, 2 * N>(scratch.data(), 2 * N));
+
+    std::array<uint64_t, WORDS> bits{};
+    std::ranges::generate(bits, [&]() { return gen(); });
+
+    std::array<uint64_t, WORDS> expected{};
+    for (size_t j = 0; j < N; j++) {
+      const uint64_t bit = (bits[pi[j] / 64] >> (pi[j] % 64)) & 1U;
+      expected[j / 64] |= bit << (j % 64);
     }
+
+    subtle::ct_permute_bits(std::span<uint64_t, WORDS>(bits), std::span<const uint8_t, CONTROL_BYTES>(control.data(), CONTROL_BYTES));
+    ASSERT_EQ(bits, expected);
   }
 }
 
-// Test functional correctness of constant-time memory comparison operation,
-// checking result against element-wise equality via std::equal.
+// Test functional correctness of the oblivious shuffle: the result is a permutation of
+// the input, every permutation of a few elements shows up about equally often, and
+// colliding tags are reported.
 template<typename operandT, typename returnT>
 void
-test_ct_memcmp()
+test_ct_shuffle()
   requires(subtle::ct_operand<operandT> && std::is_unsigned_v<returnT>)
 {
-  constexpr returnT truthv = static_cast<returnT>(~returnT{ 0 });
-  constexpr returnT falsev = 0;
-
-  constexpr size_t MIN_SIZE = 0;
-  constexpr size_t MAX_SIZE = 1024;
+  constexpr auto truth = std::numeric_limits<returnT>::max();
 
   std::random_device rd;
   std::mt19937_64 gen(rd());
   operand_distribution<operandT> dis;
-  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
 
+  for (const size_t n : { 0UL, 1UL, 2UL, 17UL, 64UL, 1000UL, 4096UL }) {
+    std::vector<operandT> vals(n);
+    std::ranges::generate(vals, [&]() { return dis(gen); });
+
+    std::vector<uint64_t> random_words(n);
+    std::ranges::generate(random_words, [&]() { return gen(); });
+
+    std::vector<operandT> shuffled = vals;
+    const returnT distinct = subtle::ct_shuffle<operandT, returnT>(std::span(shuffled), std::span(random_words));
+
+    ASSERT_EQ(distinct, truth);
+    ASSERT_TRUE(std::ranges::all_of(random_words, [](const uint64_t word) { return word == 0; }));
+
+    std::ranges::sort(vals);
+    std::ranges::sort(shuffled);
+    ASSERT_EQ(shuffled, vals);
+  }
+
+  // All 6 orders of 3 distinct elements, each expected ITERATIONS / 6 times.
+  std::map<std::array<operandT, 3>, size_t> counts;
   for (size_t i = 0; i < ITERATIONS; i++) {
-    const size_t len = size_dis(gen);
+    std::array<operandT, 3> vals = { operandT{ 0 }, operandT{ 1 }, operandT{ 2 } };
+    std::array<uint64_t, 3> random_words = { gen(), gen(), gen() };
 
-    std::vector<operandT> lhs(len);
-    std::vector<operandT> rhs(len);
+    ASSERT_EQ((subtle::ct_shuffle<operandT, returnT, 3>(vals, random_words)), truth);
+    counts[vals]++;
+  }
 
-    std::ranges::generate(lhs, [&]() { return dis(gen); });
-    std::ranges::generate(rhs, [&]() { return dis(gen); });
+  ASSERT_EQ(counts.size(), 6U);
+  for (const auto& [order, count] : counts) {
+    ASSERT_NEAR(static_cast<double>(count), ITERATIONS / 6.0, ITERATIONS / 60.0);
+  }
 
-    const returnT z = subtle::ct_memcmp<operandT, returnT>(std::span<const operandT>(lhs), std::span<const operandT>(rhs));
-    const bool expected = std::equal(lhs.begin(), lhs.end(), rhs.begin());
-    ASSERT_EQ(z, (expected ? truthv : falsev));
+  // Identical random words: the tags collide, which must be reported.
+  std::array<operandT, 3> vals = { operandT{ 2 }, operandT{ 0 }, operandT{ 1 } };
+  std::array<uint64_t, 3> random_words = { 42, 42, 42 };
+  ASSERT_EQ((subtle::ct_shuffle<operandT, returnT, 3>(vals, random_words)), returnT{ 0 });
+}
 
-    // Identical spans must return truth value
-    const returnT self = subtle::ct_memcmp<operandT, returnT>(std::span<const operandT>(lhs), std::span<const operandT>(lhs));
-    ASSERT_EQ(self, truthv);
+// Test functional correctness of oblivious compaction, checking it against a stable
+// std::ranges::copy_if, for keep ratios from none to all of the elements.
+template<typename operandT, typename maskT>
+void
+test_ct_compact()
+  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<maskT>)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  operand_distribution<operandT> dis;
+
+  const auto check = [&](const size_t n, const double keep_ratio) {
+    std::bernoulli_distribution keep_dis(keep_ratio);
+
+    std::vector<operandT> vals(n);
+    std::ranges::generate(vals, [&]() { return dis(gen); });
+
+    std::vector<maskT> keep_masks(n);
+    std::ranges::generate(keep_masks, [&]() { return keep_dis(gen) ? std::numeric_limits<maskT>::max() : maskT{ 0 }; });
+
+    std::vector<operandT> expected(n, operandT{ 0 });
+    size_t expected_count = 0;
+    for (size_t i = 0; i < n; i++) {
+      if (keep_masks[i] != 0) {
+        expected[expected_count++] = vals[i];
+      }
+    }
+
+    std::vector<uint32_t> scratch(n);
+    const size_t count = subtle::ct_compact(std::span(vals), std::span<const maskT>(keep_masks), std::span(scratch));
+
+    return count == expected_count && vals == expected && std::ranges::all_of(scratch, [](const uint32_t word) { return word == 0; });
+  };
+
+  for (size_t n = 0; n <= 130; n++) {
+    for (const double keep_ratio : { 0.0, 0.1, 0.5, 0.9, 1.0 }) {
+      ASSERT_TRUE(check(n, keep_ratio));
+    }
+  }
+
+  for (const size_t n : { 1000UL, 4096UL, 10007UL }) {
+    for (const double keep_ratio : { 0.0, 0.1, 0.5, 0.9, 1.0 }) {
+      ASSERT_TRUE(check(n, keep_ratio));
+    }
   }
 }
 
-// Test functional correctness of constant-time conditional memcpy operation,
-// verifying that dst is overwritten with src on truth value and left unchanged
-// on false value.
-template<typename operandT, typename branchT>
+// Draws a random limb, biased towards all-zero and all-one limbs, so that carries and
+// borrows ripple across many limbs often enough.
+template<typename limbT>
+limbT
+random_limb(std::mt19937_64& gen)
+  requires(subtle::ct_limb<limbT>)
+{
+  switch (gen() % 4) {
+    case 0:
+      return 0;
+    case 1:
+      return std::numeric_limits<limbT>::max();
+    default:
+      return static_cast<limbT>(gen());
+  }
+}
+
+// Splits little-endian limbs into little-endian 32-bit limbs, so that reference
+// multi-precision arithmetic can be carried out in plain 64-bit words.
+template<typename limbT>
+std::vector<uint32_t>
+to_u32_limbs(std::span<const limbT> limbs)
+  requires(subtle::ct_limb<limbT>)
+{
+  std::vector<uint32_t> words;
+  for (const limbT limb : limbs) {
+    for (size_t off = 0; off < std::numeric_limits<limbT>::digits; off += 32) {
+      words.push_back(static_cast<uint32_t>(limb >> off));
+    }
+  }
+
+  return words;
+}
+
+// Reference r = a + b ( sub = false ) or r = a - b ( sub = true ) over equal-length
+// 32-bit limb vectors, returning the carry or borrow out of the top limb.
+inline uint32_t
+ref_add_sub(std::vector<uint32_t>& r, const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, const bool sub)
+{
+  uint64_t carry = 0;
+  r.resize(a.size());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    const uint64_t word = sub ? uint64_t{ a[i] } - b[i] - carry : uint64_t{ a[i] } + b[i] + carry;
+    r[i] = static_cast<uint32_t>(word);
+    carry = (word >> 32) & 1U;
+  }
+
+  return static_cast<uint32_t>(carry);
+}
+
+// Test functional correctness of multi-precision addition and subtraction over N limbs,
+// against the 32-bit limb reference, for both the fixed-extent and the dynamic-extent
+// spans, and with the result overwriting an operand.
+template<typename limbT, size_t N>
 void
-test_ct_conditional_memcpy()
-  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<branchT>)
+test_ct_add_sub()
+  requires(subtle::ct_limb<limbT>)
 {
-  constexpr branchT truthv = static_cast<branchT>(~branchT{ 0 });
-  constexpr branchT falsev = 0;
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
 
-  constexpr size_t MIN_SIZE = 0;
-  constexpr size_t MAX_SIZE = 1024;
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<limbT, N> a{};
+    std::array<limbT, N> b{};
+    std::ranges::generate(a, [&]() { return random_limb<limbT>(gen); });
+    std::ranges::generate(b, [&]() { return random_limb<limbT>(gen); });
+
+    const auto a32 = to_u32_limbs<limbT>(a);
+    const auto b32 = to_u32_limbs<limbT>(b);
+
+    for (const bool sub : { false, true }) {
+      std::vector<uint32_t> expected;
+      const uint32_t expected_carry = ref_add_sub(expected, a32, b32, sub);
+      const uint32_t expected_mask = 0U - expected_carry;
+
+      std::array<limbT, N> r{};
+      std::vector<limbT> r_dyn(N);
+      std::array<limbT, N> r_alias = a;
+
+      uint32_t carry = 0;
+      uint32_t carry_dyn = 0;
+      uint32_t carry_alias = 0;
+
+      if (sub) {
+        carry = subtle::ct_sub_borrow<limbT, uint32_t, N>(r, a, b);
+        carry_dyn = subtle::ct_sub_borrow<limbT, uint32_t>(std::span(r_dyn), std::span<const limbT>(a), std::span<const limbT>(b));
+        carry_alias = subtle::ct_sub_borrow<limbT, uint32_t, N>(r_alias, r_alias, b);
+      } else {
+        carry = subtle::ct_add_carry<limbT, uint32_t, N>(r, a, b);
+        carry_dyn = subtle::ct_add_carry<limbT, uint32_t>(std::span(r_dyn), std::span<const limbT>(a), std::span<const limbT>(b));
+        carry_alias = subtle::ct_add_carry<limbT, uint32_t, N>(r_alias, r_alias, b);
+      }
+
+      ASSERT_EQ(to_u32_limbs<limbT>(r), expected);
+      ASSERT_EQ(carry, expected_mask);
+      ASSERT_TRUE(std::ranges::equal(r_dyn, r));
+      ASSERT_EQ(carry_dyn, expected_mask);
+      ASSERT_EQ(r_alias, r);
+      ASSERT_EQ(carry_alias, expected_mask);
+    }
+  }
+}
 
+// Test functional correctness of the conditional subtraction over N limbs: m is taken
+// off hi:x exactly when hi:x >= m, including the corner case x == m.
+template<typename limbT, size_t N>
+void
+test_ct_cond_sub()
+  requires(subtle::ct_limb<limbT>)
+{
   std::random_device rd;
   std::mt19937_64 gen(rd());
-  operand_distribution<operandT> dis;
-  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
 
-  for (size_t i = 0; i < ITERATIONS; i++) {
-    const size_t len = size_dis(gen);
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<limbT, N> m{};
+    std::ranges::generate(m, [&]() { return random_limb<limbT>(gen); });
 
-    std::vector<operandT> src(len);
-    std::vector<operandT> dst(len);
+    std::array<limbT, N> x{};
+    std::ranges::generate(x, [&]() { return random_limb<limbT>(gen); });
+    if (i % 8 == 0) {
+      x = m;
+    }
 
-    std::ranges::generate(src, [&]() { return dis(gen); });
-    std::ranges::generate(dst, [&]() { return dis(gen); });
+    const auto hi = static_cast<limbT>(i % 3 == 0 ? 1U : 0U);
 
-    // Truth value: dst must become an exact copy of src.
-    std::vector<operandT> dst_truth = dst;
-    subtle::ct_conditional_memcpy<branchT, operandT>(truthv, std::span<operandT>(dst_truth), std::span<const operandT>(src));
-    ASSERT_EQ(dst_truth, src);
+    // hi:x - m over N + 1 limbs decides the result.
+    auto x32 = to_u32_limbs<limbT>(x);
+    auto m32 = to_u32_limbs<limbT>(m);
+    x32.push_back(static_cast<uint32_t>(hi));
+    m32.push_back(0);
 
-    // False value: dst must retain its original contents.
-    std::vector<operandT> dst_false = dst;
-    subtle::ct_conditional_memcpy<branchT, operandT>(falsev, std::span<operandT>(dst_false), std::span<const operandT>(src));
-    ASSERT_EQ(dst_false, dst);
+    std::vector<uint32_t> diff;
+    const bool subtract = ref_add_sub(diff, x32, m32, true) == 0;
+    diff.pop_back();
+
+    const auto expected = subtract ? diff : to_u32_limbs<limbT>(x);
+
+    std::vector<limbT> x_dyn(x.begin(), x.end());
+
+    const auto mask = subtle::ct_cond_sub<limbT, uint64_t, N>(x, m, hi);
+    const auto mask_dyn = subtle::ct_cond_sub<limbT, uint64_t>(std::span(x_dyn), std::span<const limbT>(m), hi);
+
+    ASSERT_EQ(to_u32_limbs<limbT>(x), expected);
+    ASSERT_EQ(mask, subtract ? std::numeric_limits<uint64_t>::max() : 0UL);
+    ASSERT_TRUE(std::ranges::equal(x_dyn, x));
+    ASSERT_EQ(mask_dyn, mask);
   }
 }
 
-// Test functional correctness of constant-time conditional memset operation,
-// verifying that dst is filled with the given value on truth value and left
-// unchanged on false value.
-template<typename operandT, typename branchT>
+// Test functional correctness of the multi-limb ct_bit_length, ct_clz and ct_ctz over N
+// limbs, against the scalar counts of the most and least significant non-zero limbs --
+// with runs of zero limbs at the top, at the bottom and everywhere.
+template<typename limbT, size_t N>
 void
-test_ct_conditional_memset()
-  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<branchT>)
+test_ct_bit_scan_limbs()
+  requires(subtle::ct_limb<limbT>)
 {
-  constexpr branchT truthv = static_cast<branchT>(~branchT{ 0 });
-  constexpr branchT falsev = 0;
+  constexpr size_t digits = std::numeric_limits<limbT>::digits;
 
-  constexpr size_t MIN_SIZE = 0;
-  constexpr size_t MAX_SIZE = 1024;
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  for (size_t i = 0; i < ITERATIONS / 64; i++) {
+    std::array<limbT, N> x{};
+    std::ranges::generate(x, [&]() { return random_limb<limbT>(gen); });
+
+    const size_t top = gen() % (N + 1);
+    const size_t bottom = gen() % (N + 1);
+    std::fill(x.begin() + static_cast<std::ptrdiff_t>(N - top), x.end(), limbT{ 0 });
+    std::fill(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(bottom), limbT{ 0 });
+    if (i % 16 == 0) {
+      x.fill(0);
+    }
+
+    size_t bit_length = 0;
+    size_t ctz = N * digits;
+    for (size_t j = 0; j < N; j++) {
+      if (x[j] != 0) {
+        bit_length = j * digits + static_cast<size_t>(std::bit_width(x[j]));
+      }
+
+      if (x[N - 1 - j] != 0) {
+        ctz = (N - 1 - j) * digits + static_cast<size_t>(std::countr_zero(x[N - 1 - j]));
+      }
+    }
+
+    ASSERT_EQ(subtle::ct_bit_length(std::span<const limbT, N>(x)), bit_length);
+    ASSERT_EQ(subtle::ct_clz(std::span<const limbT, N>(x)), N * digits - bit_length);
+    ASSERT_EQ(subtle::ct_ctz(std::span<const limbT, N>(x)), ctz);
+    ASSERT_EQ(subtle::ct_bit_length(std::span<const limbT>(x)), bit_length);
+    ASSERT_EQ(subtle::ct_ctz(std::span<const limbT>(x)), ctz);
+  }
+}
 
+// Reference a * b mod m over equal-length 32-bit limb vectors: the schoolbook product,
+// reduced one bit at a time from the top, with a trial subtraction per bit.
+inline std::vector<uint32_t>
+ref_mulmod(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, const std::vector<uint32_t>& m)
+{
+  const size_t n = m.size();
+
+  std::vector<uint32_t> prod(2 * n, 0);
+  for (size_t i = 0; i < n; i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < n; j++) {
+      const uint64_t word = uint64_t{ a[i] } * b[j] + prod[i + j] + carry;
+      prod[i + j] = static_cast<uint32_t>(word);
+      carry = word >> 32;
+    }
+    prod[i + n] = static_cast<uint32_t>(carry);
+  }
+
+  std::vector<uint32_t> rem(n + 1, 0);
+  std::vector<uint32_t> m_ext(m);
+  m_ext.push_back(0);
+  std::vector<uint32_t> diff;
+
+  for (size_t bit = 64 * n; bit-- > 0;) {
+    for (size_t i = n + 1; i-- > 1;) {
+      rem[i] = (rem[i] << 1) | (rem[i - 1] >> 31);
+    }
+    rem[0] = (rem[0] << 1) | ((prod[bit / 32] >> (bit % 32)) & 1U);
+
+    if (ref_add_sub(diff, rem, m_ext, true) == 0) {
+      rem = diff;
+    }
+  }
+
+  rem.pop_back();
+  return rem;
+}
+
+// Test functional correctness of Montgomery arithmetic modulo random odd moduli of LIMBS
+// limbs: conversions round-trip, and mul / sqr agree with the reference modular product.
+template<size_t LIMBS>
+void
+test_ct_montgomery(const size_t iterations)
+{
   std::random_device rd;
   std::mt19937_64 gen(rd());
-  operand_distribution<operandT> dis;
-  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
 
-  for (size_t i = 0; i < ITERATIONS; i++) {
-    const size_t len = size_dis(gen);
+  // A random value below m, by keeping its top limb below that of m.
+  const auto below = [&](const std::array<uint64_t, LIMBS>& m) {
+    std::array<uint64_t, LIMBS> x{};
+    std::ranges::generate(x, [&]() { return random_limb<uint64_t>(gen); });
+    x[LIMBS - 1] = gen() % m[LIMBS - 1];
+    return x;
+  };
+
+  for (size_t i = 0; i < iterations; i++) {
+    std::array<uint64_t, LIMBS> m{};
+    std::ranges::generate(m, [&]() { return random_limb<uint64_t>(gen); });
+    m[0] |= 1U;
+    m[LIMBS - 1] = i % 3 == 0 ? std::numeric_limits<uint64_t>::max() : std::max<uint64_t>(m[LIMBS - 1] >> (i % 61), 1U);
+
+    const subtle::ct_montgomery<LIMBS> mont(m);
+
+    auto a = below(m);
+    auto b = below(m);
+    if (i % 4 == 1) {
+      // a = b = m - 1
+      std::array<uint64_t, LIMBS> one{};
+      one[0] = 1;
+      subtle::ct_sub_borrow<uint64_t, uint64_t, LIMBS>(a, m, one);
+      b = a;
+    }
 
-    std::vector<operandT> dst(len);
-    std::ranges::generate(dst, [&]() { return dis(gen); });
+    const auto a32 = to_u32_limbs<uint64_t>(a);
+    const auto b32 = to_u32_limbs<uint64_t>(b);
+    const auto m32 = to_u32_limbs<uint64_t>(m);
+
+    std::array<uint64_t, LIMBS> am{};
+    std::array<uint64_t, LIMBS> bm{};
+    mont.to_montgomery(am, a);
+    mont.to_montgomery(bm, b);
+
+    std::array<uint64_t, LIMBS> back{};
+    mont.from_montgomery(back, am);
+    ASSERT_EQ(back, a);
+
+    std::array<uint64_t, LIMBS> prod{};
+    mont.mul(prod, am, bm);
+    mont.from_montgomery(prod, prod);
+    ASSERT_EQ(to_u32_limbs<uint64_t>(prod), ref_mulmod(a32, b32, m32));
+
+    std::array<uint64_t, LIMBS> sq{};
+    mont.sqr(sq, am);
+    mont.from_montgomery(sq, sq);
+    ASSERT_EQ(to_u32_limbs<uint64_t>(sq), ref_mulmod(a32, a32, m32));
+
+    // In place, against the out-of-place product
+    mont.mul(am, am, am);
+    mont.sqr(bm, bm);
+    mont.from_montgomery(am, am);
+    mont.from_montgomery(bm, bm);
+    ASSERT_EQ(am, sq);
+    ASSERT_EQ(to_u32_limbs<uint64_t>(bm), ref_mulmod(b32, b32, m32));
+  }
+}
 
-    const operandT val = dis(gen);
+// Returns the Mersenne number 2^BITS - 1 over LIMBS 64-bit limbs.
+template<size_t LIMBS, size_t BITS>
+constexpr std::array<uint64_t, LIMBS>
+mersenne_limbs()
+  requires(BITS > 64 * (LIMBS - 1) && BITS <= 64 * LIMBS)
+{
+  std::array<uint64_t, LIMBS> m{};
+  m.fill(std::numeric_limits<uint64_t>::max());
+  m[LIMBS - 1] >>= 64 * LIMBS - BITS;
+  return m;
+}
 
-    // Truth value: every element of dst must become val.
-    std::vector<operandT> dst_truth = dst;
-    subtle::ct_conditional_memset<branchT, operandT>(truthv, std::span<operandT>(dst_truth), val);
-    std::vector<operandT> expected(len, val);
-    ASSERT_EQ(dst_truth, expected);
+// Test functional correctness of safegcd inversion modulo the prime p: a * a^-1 = 1
+// mod p for random a and for the extreme inputs 1, 2^k and p - 1, and 0 maps to 0.
+template<size_t LIMBS>
+void
+test_ct_modinv(const std::array<uint64_t, LIMBS>& p, const size_t iterations)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
 
-    // False value: dst must retain its original contents.
-    std::vector<operandT> dst_false = dst;
-    subtle::ct_conditional_memset<branchT, operandT>(falsev, std::span<operandT>(dst_false), val);
-    ASSERT_EQ(dst_false, dst);
+  const subtle::ct_modinv<LIMBS> modinv(p);
+  const auto p32 = to_u32_limbs<uint64_t>(p);
+
+  std::vector<uint32_t> one32(p32.size(), 0);
+  one32[0] = 1;
+
+  std::array<uint64_t, LIMBS> a{};
+  std::array<uint64_t, LIMBS> r{};
+
+  for (size_t i = 0; i < iterations; i++) {
+    std::ranges::generate(a, [&]() { return random_limb<uint64_t>(gen); });
+    a[LIMBS - 1] = p[LIMBS - 1] > 1 ? gen() % p[LIMBS - 1] : 0;
+
+    if (i == 0) {
+      a.fill(0);
+      a[0] = 1;
+    } else if (i == 1) {
+      a.fill(0);
+      a[LIMBS - 1] = p[LIMBS - 1] >> 1;
+    } else if (i == 2) {
+      a = p;
+      a[0] -= 1;
+    }
+
+    if (std::ranges::all_of(a, [](const uint64_t limb) { return limb == 0; })) {
+      continue;
+    }
+
+    modinv.invert(r, a);
+    ASSERT_EQ(ref_mulmod(to_u32_limbs<uint64_t>(a), to_u32_limbs<uint64_t>(r), p32), one32);
+
+    // In place
+    modinv.invert(a, a);
+    ASSERT_EQ(a, r);
   }
+
+  a.fill(0);
+  modinv.invert(r, a);
+  ASSERT_TRUE(std::ranges::all_of(r, [](const uint64_t limb) { return limb == 0; }));
 }
 
-// Test functional correctness of constant-time table lookup operation, checking
-// the scanned result against a plain table[idx] access.
-template<typename operandT, typename indexT>
+// Test functional correctness of division by the constant D, against the / and %
+// operators: exhaustively for 8- and 16-bit operands, on random and extreme values
+// ( 0, D - 1, D, multiples of D around the top of the range, max ) otherwise.
+template<typename operandT, uint64_t D>
 void
-test_ct_lookup()
-  requires(subtle::ct_operand<operandT> && std::is_unsigned_v<indexT>)
+test_ct_div()
 {
-  constexpr size_t MIN_SIZE = 1;
-  constexpr size_t MAX_SIZE = 256; // fits the narrowest ( uint8_t ) index range
+  constexpr auto max = std::numeric_limits<operandT>::max();
+  constexpr auto d = static_cast<operandT>(D);
+
+  const auto check = [](const operandT x) {
+    ASSERT_EQ(subtle::ct_div<D>(x), static_cast<operandT>(x / d));
+    ASSERT_EQ(subtle::ct_mod<D>(x), static_cast<operandT>(x % d));
+
+    if (x <= max - d / 2) {
+      ASSERT_EQ(subtle::ct_div_round<D>(x), static_cast<operandT>(x / d + static_cast<operandT>(x % d >= d - d / 2)));
+    }
+  };
+
+  if constexpr (std::numeric_limits<operandT>::digits <= 16) {
+    for (size_t x = 0; x <= max; x++) {
+      check(static_cast<operandT>(x));
+    }
+  } else {
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    operand_distribution<operandT> dist;
+
+    const operandT top = static_cast<operandT>(max - max % d);
+    for (const operandT x : { operandT{ 0 }, operandT{ 1 }, static_cast<operandT>(d - 1), d, top, static_cast<operandT>(top - 1), static_cast<operandT>(top - d), max }) {
+      check(x);
+    }
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+      const operandT x = dist(gen);
+      check(x);
+      check(static_cast<operandT>(x >> (i % std::numeric_limits<operandT>::digits)));
+    }
+  }
+
+  // Span overloads agree with the scalar routines
+  std::array<operandT, 64> vals{};
+  std::iota(vals.begin(), vals.end(), static_cast<operandT>(max - 63));
+
+  auto quots = vals;
+  auto rems = vals;
+  auto rounded = vals;
+  subtle::ct_div<D>(std::span(quots));
+  subtle::ct_mod<D>(std::span(rems));
+  subtle::ct_div_round<D>(std::span(rounded).template first<32>());
+
+  for (size_t i = 0; i < vals.size(); i++) {
+    ASSERT_EQ(quots[i], subtle::ct_div<D>(vals[i]));
+    ASSERT_EQ(rems[i], subtle::ct_mod<D>(vals[i]));
+    ASSERT_EQ(rounded[i], i < 32 ? subtle::ct_div_round<D>(vals[i]) : vals[i]);
+  }
+}
+
+// Test Kyber's compression rounding, round( 2^d * x / q ) mod 2^d, computed with
+// ct_div_round against exact rational rounding, for every coefficient x in [0, q).
+inline void
+test_ct_div_kyber_compress()
+{
+  constexpr uint32_t q = 3329;
+
+  for (const uint32_t d : { 1U, 4U, 5U, 10U, 11U }) {
+    std::array<uint32_t, q> coeffs{};
+    std::iota(coeffs.begin(), coeffs.end(), 0U);
+
+    for (auto& coeff : coeffs) {
+      coeff <<= d;
+    }
+    subtle::ct_div_round<q>(std::span(coeffs));
+
+    for (uint32_t x = 0; x < q; x++) {
+      // round( a / q ) = floor( ( 2a + q ) / 2q ), for exact ties rounding up
+      const uint32_t expected = (((2 * x) << d) + q) / (2 * q);
+      ASSERT_EQ(coeffs[x] & ((1U << d) - 1), expected & ((1U << d) - 1));
+    }
+  }
+}
+
+// Test functional correctness of division by a secret divisor, against the / and %
+// operators, on random dividends and divisors of random bit lengths, and on the
+// extreme cases: d = 0 ( flagged ), d = 1, d = -1, x < d and x = min.
+template<typename operandT, typename returnT>
+void
+test_ct_divmod()
+{
+  using Uop = std::make_unsigned_t<operandT>;
+  constexpr size_t W = std::numeric_limits<Uop>::digits;
+  constexpr auto min = std::numeric_limits<operandT>::min();
+  constexpr auto max = std::numeric_limits<operandT>::max();
 
   std::random_device rd;
   std::mt19937_64 gen(rd());
-  operand_distribution<operandT> dis;
-  std::uniform_int_distribution<size_t> size_dis(MIN_SIZE, MAX_SIZE);
+  operand_distribution<operandT> dist;
+
+  const auto check = [](const operandT x, const operandT d) {
+    operandT quot{};
+    operandT rem{};
+    const returnT is_zero = subtle::ct_divmod<operandT, returnT>(x, d, quot, rem);
+
+    if (d == 0) {
+      ASSERT_EQ(is_zero, std::numeric_limits<returnT>::max());
+      ASSERT_EQ(quot, static_cast<operandT>(~Uop{ 0 }));
+      ASSERT_EQ(rem, x);
+    } else if (std::is_signed_v<operandT> && x == std::numeric_limits<operandT>::min() && d == static_cast<operandT>(-1)) {
+      ASSERT_EQ(is_zero, returnT{ 0 });
+      ASSERT_EQ(quot, x);
+      ASSERT_EQ(rem, operandT{ 0 });
+    } else {
+      ASSERT_EQ(is_zero, returnT{ 0 });
+      ASSERT_EQ(quot, static_cast<operandT>(x / d));
+      ASSERT_EQ(rem, static_cast<operandT>(x % d));
+    }
+  };
+
+  const std::array<operandT, 6> extremes = { operandT{ 0 }, operandT{ 1 }, static_cast<operandT>(-1), min, max, static_cast<operandT>(max - 1) };
+  for (const operandT x : extremes) {
+    for (const operandT d : extremes) {
+      check(x, d);
+    }
+  }
 
   for (size_t i = 0; i < ITERATIONS; i++) {
-    const size_t len = size_dis(gen);
+    const operandT x = dist(gen);
+    const auto d = static_cast<operandT>(static_cast<Uop>(dist(gen)) >> (gen() % W));
 
-    std::vector<operandT> table(len);
-    std::ranges::generate(table, [&]() { return dis(gen); });
+    check(x, d);
+    check(d, x);
+  }
+}
 
-    std::uniform_int_distribution<size_t> idx_dis(0, len - 1);
-    const size_t idx = idx_dis(gen);
+// Test functional correctness of lattice coefficient normalization modulo q, against
+// reference reductions by the % operator, over whole 256-coefficient polynomials (
+// the fixed-extent kernels ) and over dynamic-extent spans of every length up to 67 (
+// covering the vector loop and its scalar tail ), drawing coefficients from [-q, 2q).
+template<typename coeffT>
+void
+test_ct_lattice(const coeffT q)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<int64_t> dist(-static_cast<int64_t>(q), 2 * static_cast<int64_t>(q) - 1);
 
-    const operandT z = subtle::ct_lookup<indexT, operandT>(static_cast<indexT>(idx), std::span<const operandT>(table));
-    ASSERT_EQ(z, table[idx]);
+  const auto canonical = [q](const coeffT x) { return static_cast<coeffT>(((x % q) + q) % q); };
+  const auto centered = [q](const coeffT x) { return static_cast<coeffT>(x > q / 2 ? x - q : x); };
+
+  const auto check = [&]<size_t N>(std::span<coeffT, N> vals) {
+    std::ranges::generate(vals, [&]() { return static_cast<coeffT>(dist(gen)); });
+    vals[0] = static_cast<coeffT>(-q);
+    vals[vals.size() - 1] = static_cast<coeffT>(2 * q - 1);
+
+    const std::vector<coeffT> orig(vals.begin(), vals.end());
+
+    subtle::ct_cond_add_if_negative(vals, q);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], static_cast<coeffT>(orig[i] < 0 ? orig[i] + q : orig[i]));
+    }
+
+    std::ranges::copy(orig, vals.begin());
+    subtle::ct_freeze_mod(vals, q);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], canonical(orig[i]));
+    }
+
+    std::vector<coeffT> frozen(vals.begin(), vals.end());
+    subtle::ct_center(vals, q);
+    for (size_t i = 0; i < vals.size(); i++) {
+      ASSERT_EQ(vals[i], centered(frozen[i]));
+      ASSERT_EQ(subtle::ct_center(frozen[i], q), vals[i]);
+    }
+  };
+
+  for (size_t i = 0; i < 64; i++) {
+    std::array<coeffT, 256> poly{};
+    check(std::span(poly));
+  }
+
+  for (size_t len = 1; len <= 67; len++) {
+    std::vector<coeffT> vals(len);
+    check(std::span(vals));
   }
 }
 
 }
+
@@ -260,6 +260,21 @@ TYPED_TEST(CtMaxTest, Correctness)
   test_subtle::test_ct_max<operandT>();
 }
 
+// --- ct_minmax tests ---
+
+template<typename T>
+class CtMinmaxTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtMinmaxTest, TypeCombinations);
+
+TYPED_TEST(CtMinmaxTest, Correctness)
+{
+  using operandT = typename TypeParam::first_type;
+
+  test_subtle::test_ct_minmax<operandT>();
+}
+
 // --- ct_zeroize tests ---
 
 using ElementTypes =
@@ -339,3 +354,416 @@ TYPED_TEST(CtLookupTest, Correctness)
 
   test_subtle::test_ct_lookup<operandT, indexT>();
 }
+
+// --- ct_table tests ---
+
+using TableElementTypes = ::testing::Types<uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t>;
+
+template<typename T>
+class CtTableTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtTableTest, TableElementTypes);
+
+TYPED_TEST(CtTableTest, Correctness)
+{
+  test_subtle::test_ct_table<TypeParam, 1>();
+  test_subtle::test_ct_table<TypeParam, 61>();
+  test_subtle::test_ct_table<TypeParam, 1000>();
+  test_subtle::test_ct_table<TypeParam, 4096>();
+}
+
+// --- Bitsliced S-box tests ---
+
+TEST(CtBitsliceTest, BytesRoundTrip)
+{
+  test_subtle::test_ct_bitslice_bytes();
+}
+
+TEST(CtBitsliceTest, SboxCorrectness)
+{
+  test_subtle::test_ct_sbox_bitsliced();
+}
+
+TEST(CtBitsliceTest, CustomCircuit)
+{
+  test_subtle::test_ct_bitsliced_substitute();
+}
+
+// --- Bit-matrix transpose tests ---
+
+template<typename T>
+class CtTransposeTest : public ::testing::Test
+{};
+
+using TransposeRowTypes = ::testing::Types<uint8_t, uint32_t, uint64_t>;
+TYPED_TEST_SUITE(CtTransposeTest, TransposeRowTypes);
+
+TYPED_TEST(CtTransposeTest, Correctness)
+{
+  test_subtle::test_ct_transpose<TypeParam>();
+}
+
+// --- ct_sort tests ---
+
+template<typename T>
+class CtSortTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtSortTest, TableElementTypes);
+
+TYPED_TEST(CtSortTest, Correctness)
+{
+  test_subtle::test_ct_sort<TypeParam>();
+}
+
+// --- Beneš network tests ---
+
+template<typename T>
+class CtPermuteTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtPermuteTest, TableElementTypes);
+
+TYPED_TEST(CtPermuteTest, Correctness)
+{
+  test_subtle::test_ct_permute<TypeParam, 2>();
+  test_subtle::test_ct_permute<TypeParam, 16>();
+  test_subtle::test_ct_permute<TypeParam, 256>();
+  test_subtle::test_ct_permute<TypeParam, 2048>();
+}
+
+TEST(CtPermuteBitsTest, Correctness)
+{
+  test_subtle::test_ct_permute_bits<1>();
+  test_subtle::test_ct_permute_bits<4>();
+  test_subtle::test_ct_permute_bits<128>();
+}
+
+// --- ct_shuffle tests ---
+
+using ShuffleTypeCombinations = ::testing::Types<std::pair<uint8_t, uint32_t>,
+                                                 std::pair<uint16_t, uint64_t>,
+                                                 std::pair<uint32_t, uint8_t>,
+                                                 std::pair<int8_t, uint16_t>,
+                                                 std::pair<int16_t, uint32_t>,
+                                                 std::pair<int32_t, uint64_t>>;
+
+template<typename T>
+class CtShuffleTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtShuffleTest, ShuffleTypeCombinations);
+
+TYPED_TEST(CtShuffleTest, Correctness)
+{
+  using operandT = typename TypeParam::first_type;
+  using returnT = typename TypeParam::second_type;
+
+  test_subtle::test_ct_shuffle<operandT, returnT>();
+}
+
+// --- ct_compact tests ---
+
+template<typename T>
+class CtCompactTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtCompactTest, TypeCombinations);
+
+TYPED_TEST(CtCompactTest, Correctness)
+{
+  using operandT = typename TypeParam::first_type;
+  using maskT = typename TypeParam::second_type;
+
+  test_subtle::test_ct_compact<operandT, maskT>();
+}
+
+// --- ct_add_carry / ct_sub_borrow / ct_cond_sub tests ---
+
+using LimbTypes = ::testing::Types<uint32_t, uint64_t>;
+
+template<typename T>
+class CtBigintTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtBigintTest, LimbTypes);
+
+TYPED_TEST(CtBigintTest, AddSub)
+{
+  test_subtle::test_ct_add_sub<TypeParam, 1>();
+  test_subtle::test_ct_add_sub<TypeParam, 4>();
+  test_subtle::test_ct_add_sub<TypeParam, 6>();
+  test_subtle::test_ct_add_sub<TypeParam, 8>();
+  test_subtle::test_ct_add_sub<TypeParam, 17>();
+}
+
+TYPED_TEST(CtBigintTest, CondSub)
+{
+  test_subtle::test_ct_cond_sub<TypeParam, 1>();
+  test_subtle::test_ct_cond_sub<TypeParam, 4>();
+  test_subtle::test_ct_cond_sub<TypeParam, 6>();
+  test_subtle::test_ct_cond_sub<TypeParam, 8>();
+  test_subtle::test_ct_cond_sub<TypeParam, 17>();
+}
+
+// --- ct_montgomery tests ---
+
+TEST(CtMontgomeryTest, Correctness)
+{
+  test_subtle::test_ct_montgomery<4>(256);
+  test_subtle::test_ct_montgomery<5>(128);
+  test_subtle::test_ct_montgomery<8>(128);
+  test_subtle::test_ct_montgomery<17>(32);
+  test_subtle::test_ct_montgomery<64>(4);
+}
+
+// --- ct_modinv tests ---
+
+TEST(CtModinvTest, Correctness)
+{
+  // NIST P-256, 2^255 - 19 and NIST P-384 primes
+  test_subtle::test_ct_modinv<4>({ 0xffffffffffffffffULL, 0x00000000ffffffffULL, 0, 0xffffffff00000001ULL }, 1024);
+  test_subtle::test_ct_modinv<4>({ 0xffffffffffffffedULL, ~0ULL, ~0ULL, 0x7fffffffffffffffULL }, 1024);
+  test_subtle::test_ct_modinv<6>({ 0x00000000ffffffffULL, 0xffffffff00000000ULL, 0xfffffffffffffffeULL, ~0ULL, ~0ULL, ~0ULL }, 512);
+
+  // Mersenne primes, from one limb up to 51 limbs
+  test_subtle::test_ct_modinv<1>(test_subtle::mersenne_limbs<1, 61>(), 1024);
+  test_subtle::test_ct_modinv<2>(test_subtle::mersenne_limbs<2, 127>(), 1024);
+  test_subtle::test_ct_modinv<9>(test_subtle::mersenne_limbs<9, 521>(), 256);
+  test_subtle::test_ct_modinv<20>(test_subtle::mersenne_limbs<20, 1279>(), 32);
+  test_subtle::test_ct_modinv<51>(test_subtle::mersenne_limbs<51, 3217>(), 4);
+}
+
+// --- ct_div / ct_mod tests ---
+
+TEST(CtDivTest, Correctness)
+{
+  test_subtle::test_ct_div<uint8_t, 1>();
+  test_subtle::test_ct_div<uint8_t, 3>();
+  test_subtle::test_ct_div<uint8_t, 7>();
+  test_subtle::test_ct_div<uint8_t, 129>();
+  test_subtle::test_ct_div<uint8_t, 255>();
+
+  test_subtle::test_ct_div<uint16_t, 2>();
+  test_subtle::test_ct_div<uint16_t, 10>();
+  test_subtle::test_ct_div<uint16_t, 3329>();
+  test_subtle::test_ct_div<uint16_t, 12289>();
+  test_subtle::test_ct_div<uint16_t, 32769>();
+  test_subtle::test_ct_div<uint16_t, 65535>();
+
+  test_subtle::test_ct_div<uint32_t, 1>();
+  test_subtle::test_ct_div<uint32_t, 7>();
+  test_subtle::test_ct_div<uint32_t, 3329>();
+  test_subtle::test_ct_div<uint32_t, 8380417>();
+  test_subtle::test_ct_div<uint32_t, 0x80000001U>();
+  test_subtle::test_ct_div<uint32_t, 0xfffffffeU>();
+
+  test_subtle::test_ct_div<uint64_t, 3>();
+  test_subtle::test_ct_div<uint64_t, 10>();
+  test_subtle::test_ct_div<uint64_t, 8380417>();
+  test_subtle::test_ct_div<uint64_t, 0x8000000000000001ULL>();
+  test_subtle::test_ct_div<uint64_t, 0xffffffffffffffffULL>();
+}
+
+TEST(CtDivTest, KyberCompress)
+{
+  test_subtle::test_ct_div_kyber_compress();
+}
+
+// --- ct_divmod tests ---
+
+using DivmodTypeCombinations = ::testing::Types<std::pair<uint32_t, uint32_t>,
+                                                std::pair<uint32_t, uint8_t>,
+                                                std::pair<uint64_t, uint64_t>,
+                                                std::pair<uint64_t, uint16_t>,
+                                                std::pair<int32_t, uint32_t>,
+                                                std::pair<int64_t, uint64_t>>;
+
+template<typename T>
+class CtDivmodTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtDivmodTest, DivmodTypeCombinations);
+
+TYPED_TEST(CtDivmodTest, Correctness)
+{
+  using operandT = typename TypeParam::first_type;
+  using returnT = typename TypeParam::second_type;
+
+  test_subtle::test_ct_divmod<operandT, returnT>();
+}
+
+// --- Lattice coefficient normalization tests ---
+
+TEST(CtLatticeTest, Correctness)
+{
+  // Kyber, Falcon and Dilithium moduli
+  test_subtle::test_ct_lattice<int16_t>(3329);
+  test_subtle::test_ct_lattice<int16_t>(12289);
+  test_subtle::test_ct_lattice<int32_t>(3329);
+  test_subtle::test_ct_lattice<int32_t>(12289);
+  test_subtle::test_ct_lattice<int32_t>(8380417);
+}
+
+// --- ct_abs / ct_sign / ct_cneg / ct_clamp tests ---
+
+template<typename T>
+class CtSignedArithTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtSignedArithTest, TableElementTypes);
+
+TYPED_TEST(CtSignedArithTest, Correctness)
+{
+  test_subtle::test_ct_signed_arith<TypeParam>();
+}
+
+// --- Span reduction tests ---
+
+template<typename T>
+class CtSpanReduceTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtSpanReduceTest, TableElementTypes);
+
+TYPED_TEST(CtSpanReduceTest, Correctness)
+{
+  test_subtle::test_ct_span_reduce<TypeParam>();
+}
+
+// --- ct_eq_each / ct_lt_each / ct_select_each tests ---
+
+template<typename T>
+class CtElementwiseTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtElementwiseTest, TypeCombinations);
+
+TYPED_TEST(CtElementwiseTest, Correctness)
+{
+  using operandT = typename TypeParam::first_type;
+  using maskT = typename TypeParam::second_type;
+
+  test_subtle::test_ct_elementwise<operandT, maskT>();
+}
+
+
+// --- ct_popcount / ct_hamming_weight / ct_hamming_distance tests ---
+
+template<typename T>
+class CtPopcountTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtPopcountTest, TableElementTypes);
+
+TYPED_TEST(CtPopcountTest, Correctness)
+{
+  test_subtle::test_ct_popcount<TypeParam>();
+}
+
+// --- ct_bit_length / ct_clz / ct_ctz tests ---
+
+template<typename T>
+class CtBitScanTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtBitScanTest, TableElementTypes);
+
+TYPED_TEST(CtBitScanTest, Correctness)
+{
+  test_subtle::test_ct_bit_scan<TypeParam>();
+}
+
+TYPED_TEST(CtBigintTest, BitScan)
+{
+  test_subtle::test_ct_bit_scan_limbs<TypeParam, 1>();
+  test_subtle::test_ct_bit_scan_limbs<TypeParam, 4>();
+  test_subtle::test_ct_bit_scan_limbs<TypeParam, 17>();
+}
+
+// --- ct_bitvec / ct_rotate tests ---
+
+TEST(CtBitvecTest, Correctness)
+{
+  test_subtle::test_ct_bitvec<1>(256);
+  test_subtle::test_ct_bitvec<64>(256);
+  test_subtle::test_ct_bitvec<100>(256);
+  test_subtle::test_ct_bitvec<257>(128);
+  test_subtle::test_ct_bitvec<1024>(32);
+
+  // BIKE level 1 block length
+  test_subtle::test_ct_bitvec<12323>(4);
+}
+
+// --- ct_rotate_bytes / ct_extract tests ---
+
+TEST(CtRotateExtractTest, Correctness)
+{
+  test_subtle::test_ct_rotate_extract();
+}
+
+// --- ct_memcpy_prefix / ct_memcmp_prefix tests ---
+
+template<typename T>
+class CtPrefixTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtPrefixTest, TableElementTypes);
+
+TYPED_TEST(CtPrefixTest, Correctness)
+{
+  test_subtle::test_ct_prefix<TypeParam>();
+}
+
+// --- ct_pkcs7_unpad / ct_iso7816_unpad / ct_pkcs1_v15_unpad tests ---
+
+TEST(CtPaddingTest, Correctness)
+{
+  test_subtle::test_ct_padding();
+}
+
+// --- ct_find_first / ct_find_last tests ---
+
+template<typename T>
+class CtFindTest : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(CtFindTest, TableElementTypes);
+
+TYPED_TEST(CtFindTest, Correctness)
+{
+  test_subtle::test_ct_find<TypeParam>();
+}
+
+// --- ct_hex_encode / ct_hex_decode / ct_base64_encode / ct_base64_decode tests ---
+
+TEST(CtCodecTest, Correctness)
+{
+  test_subtle::test_ct_codec();
+}
+
+// --- ct_gf_mul / ct_gf_inv / ct_gf_mul_span / ct_gf_muladd_span / ct_gf_poly_eval tests ---
+
+TEST(CtGfTest, Correctness)
+{
+  test_subtle::test_ct_gf<2, 0x7, uint8_t>();
+  test_subtle::test_ct_gf<3, 0xb, uint8_t>();
+  test_subtle::test_ct_gf<4, 0x13, uint8_t>();
+  test_subtle::test_ct_gf<5, 0x25, uint8_t>();
+  test_subtle::test_ct_gf<6, 0x43, uint8_t>();
+  test_subtle::test_ct_gf<7, 0x83, uint8_t>();
+  test_subtle::test_ct_gf<8, 0x11b, uint8_t>();
+  test_subtle::test_ct_gf<8, 0x11d, uint8_t>();
+  test_subtle::test_ct_gf<8, 0x11b, uint16_t>();
+  test_subtle::test_ct_gf<9, 0x211, uint16_t>();
+  test_subtle::test_ct_gf<10, 0x409, uint16_t>();
+  test_subtle::test_ct_gf<11, 0x805, uint16_t>();
+  test_subtle::test_ct_gf<12, 0x1009, uint16_t>();
+  test_subtle::test_ct_gf<13, 0x201b, uint16_t>();
+}
+
+TEST(CtGfTest, Gf256)
+{
+  test_subtle::test_ct_gf256();
+}